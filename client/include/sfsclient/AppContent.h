@@ -6,12 +6,18 @@
 #include "AppFile.h"
 #include "Content.h"
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace SFS
 {
+/**
+ * @brief Immutable prerequisite of an AppContent
+ * @details Copies share the same data, so they are cheap to make and can be used from multiple threads at once.
+ */
 class AppPrerequisiteContent
 {
   public:
@@ -21,8 +27,8 @@ class AppPrerequisiteContent
 
     AppPrerequisiteContent(AppPrerequisiteContent&&) noexcept;
 
-    AppPrerequisiteContent(const AppPrerequisiteContent&) = delete;
-    AppPrerequisiteContent& operator=(const AppPrerequisiteContent&) = delete;
+    AppPrerequisiteContent(const AppPrerequisiteContent&) = default;
+    AppPrerequisiteContent& operator=(const AppPrerequisiteContent&) = default;
 
     /**
      * @return Unique content identifier
@@ -34,13 +40,49 @@ class AppPrerequisiteContent
      */
     const std::vector<AppFile>& GetFiles() const noexcept;
 
+    /**
+     * @return Fingerprint of the content id and files, computed when the prerequisite is built
+     * @details The order of the files doesn't change the fingerprint, as they are compared as a set
+     */
+    ContentFingerprint GetFingerprint() const noexcept;
+
+    /**
+     * @return The file with the given @param fileId, or nullptr if there is none
+     * @details Lookups go through an index that is built on the first call, so repeated lookups don't scan the files
+     */
+    const AppFile* FindFile(std::string_view fileId) const;
+
+    /**
+     * @return The file with the given @param fileMoniker, or nullptr if there is none
+     */
+    const AppFile* FindFileByMoniker(std::string_view fileMoniker) const;
+
+    /**
+     * @return The file that best applies to @param architecture, or nullptr if there is none
+     * @details A file built for @param architecture is preferred over an architecture-neutral one, which lists
+     * Architecture::None or no architecture at all. Among equally good files, the first one in GetFiles() is returned
+     * @note Only the architecture is matched. PlatformApplicabilityForPackage is not checked, use
+     * RequestParams::applicabilityFilter to drop the files of other platforms
+     */
+    const AppFile* FindApplicableFile(Architecture architecture) const;
+
+    /**
+     * @return The file that best applies to the architecture of this machine, or nullptr if there is none
+     * @note Only the architecture is matched, like for FindApplicableFile(Architecture)
+     */
+    const AppFile* FindApplicableFile() const;
+
   private:
     AppPrerequisiteContent() = default;
 
-    std::unique_ptr<ContentId> m_contentId;
-    std::vector<AppFile> m_files;
+    struct Data;
+    std::shared_ptr<const Data> m_data;
 };
 
+/**
+ * @brief Immutable app content returned by the SFSClient
+ * @details Copies share the same data, so they are cheap to make and can be used from multiple threads at once.
+ */
 class AppContent
 {
   public:
@@ -52,8 +94,8 @@ class AppContent
 
     AppContent(AppContent&&) noexcept;
 
-    AppContent(const AppContent&) = delete;
-    AppContent& operator=(const AppContent&) = delete;
+    AppContent(const AppContent&) = default;
+    AppContent& operator=(const AppContent&) = default;
 
     /**
      * @return Unique content identifier
@@ -70,18 +112,56 @@ class AppContent
      */
     const std::vector<AppFile>& GetFiles() const noexcept;
 
+    /**
+     * @return The file with the given @param fileId, or nullptr if there is none
+     * @details Lookups go through an index that is built on the first call, so repeated lookups don't scan the files
+     */
+    const AppFile* FindFile(std::string_view fileId) const;
+
+    /**
+     * @return The file with the given @param fileMoniker, or nullptr if there is none
+     */
+    const AppFile* FindFileByMoniker(std::string_view fileMoniker) const;
+
+    /**
+     * @return The file that best applies to @param architecture, or nullptr if there is none
+     * @details A file built for @param architecture is preferred over an architecture-neutral one, which lists
+     * Architecture::None or no architecture at all. Among equally good files, the first one in GetFiles() is returned
+     * @note Only the architecture is matched. PlatformApplicabilityForPackage is not checked, use
+     * RequestParams::applicabilityFilter to drop the files of other platforms
+     */
+    const AppFile* FindApplicableFile(Architecture architecture) const;
+
+    /**
+     * @return The file that best applies to the architecture of this machine, or nullptr if there is none
+     * @note Only the architecture is matched, like for FindApplicableFile(Architecture)
+     */
+    const AppFile* FindApplicableFile() const;
+
     /**
      * @return List of Prerequisite content needed for this App. Prerequisites don't have further dependencies.
      */
     const std::vector<AppPrerequisiteContent>& GetPrerequisites() const noexcept;
 
+    /**
+     * @return Fingerprint of the content id, update id, files and prerequisites, computed when the content is built
+     * @details The order of the files doesn't change the fingerprint, as they are compared as a set. The order of the
+     * prerequisites does
+     */
+    ContentFingerprint GetFingerprint() const noexcept;
+
   private:
     AppContent() = default;
 
-    std::unique_ptr<ContentId> m_contentId;
-    std::vector<AppFile> m_files;
-
-    std::string m_updateId;
-    std::vector<AppPrerequisiteContent> m_prerequisites;
+    struct Data;
+    std::shared_ptr<const Data> m_data;
 };
+
+/**
+ * @brief Callback that receives each file of an app or of one of its prerequisites as soon as it has been received and
+ * validated
+ * @param contentId Identifies the app or prerequisite the file belongs to
+ * @param file The file, which the callback can move from
+ */
+using AppFileCallbackFn = std::function<void(const ContentId& contentId, AppFile&& file)>;
 } // namespace SFS
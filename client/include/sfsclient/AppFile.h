@@ -13,6 +13,12 @@
 
 namespace SFS
 {
+namespace details
+{
+class FingerprintBuilder;
+class StringPool;
+}
+
 class AppFile : private File
 {
   public:
@@ -33,6 +39,8 @@ class AppFile : private File
     /// Getter methods from File class
     using File::GetFileId;
     using File::GetHashes;
+    using File::GetSha1Digest;
+    using File::GetSha256Digest;
     using File::GetSizeInBytes;
     using File::GetUrl;
 
@@ -51,9 +59,13 @@ class AppFile : private File
             std::string&& url,
             uint64_t sizeInBytes,
             std::unordered_map<HashType, std::string>&& hashes,
+            ApplicabilityDetails&& applicabilityDetails,
             std::string&& fileMoniker);
 
-    std::unique_ptr<ApplicabilityDetails> m_applicabilityDetails;
+    friend class details::FingerprintBuilder;
+    friend class details::StringPool;
+
+    ApplicabilityDetails m_applicabilityDetails;
     std::string m_fileMoniker;
 };
 } // namespace SFS
@@ -5,12 +5,18 @@
 
 #include "Result.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace SFS
 {
+namespace details
+{
+class StringPool;
+}
+
 enum class Architecture
 {
     None,
@@ -27,16 +33,34 @@ class ApplicabilityDetails
                                      std::vector<std::string> platformApplicabilityForPackage,
                                      std::unique_ptr<ApplicabilityDetails>& out) noexcept;
 
+    ApplicabilityDetails(ApplicabilityDetails&&) noexcept;
+
     ApplicabilityDetails(const ApplicabilityDetails&) = delete;
     ApplicabilityDetails& operator=(const ApplicabilityDetails&) = delete;
 
+    /**
+     * @return The architectures of the file, in the order of the Architecture values and without duplicates
+     * @note The architectures are held as a set of bits, so the list is shared by all objects with the same
+     * architectures
+     */
     const std::vector<Architecture>& GetArchitectures() const noexcept;
+
+    /**
+     * @return true if the file applies to @param architecture
+     */
+    bool HasArchitecture(Architecture architecture) const noexcept;
+
     const std::vector<std::string>& GetPlatformApplicabilityForPackage() const noexcept;
 
   private:
     ApplicabilityDetails() = default;
 
-    std::vector<Architecture> m_architectures;
-    std::vector<std::string> m_platformApplicabilityForPackage;
+    friend class details::StringPool;
+
+    // One bit per Architecture value the file applies to
+    uint8_t m_architectureBits{0};
+
+    // Platform values repeat across files, so their storage can be shared through a details::StringPool
+    std::shared_ptr<const std::vector<std::string>> m_platformApplicabilityForPackage;
 };
 } // namespace SFS
@@ -5,11 +5,37 @@
 
 #include "Logging.h"
 
+#include <cstddef>
 #include <optional>
 #include <string>
 
 namespace SFS
 {
+constexpr unsigned c_defaultMaxStreamsPerConnection = 100;
+constexpr size_t c_defaultMaxResponseSize = 100000;
+constexpr size_t c_defaultMaxInternedStrings = 1024;
+
+/**
+ * @brief Maximum size in bytes of the responses accepted from the service, per type of request
+ * @details Protects against rogue servers sending huge amounts of data. Each limit applies both to the bytes received
+ * and to the decompressed response. Requests whose response goes over the limit fail.
+ */
+struct ResponseSizeLimits
+{
+    /// @brief Responses with the metadata of the latest version of a product
+    size_t latestVersion{c_defaultMaxResponseSize};
+
+    /// @brief Responses with the metadata of the latest version of multiple products. The limit of a request is this
+    /// value multiplied by the number of products requested
+    size_t latestVersionBatchPerProduct{c_defaultMaxResponseSize};
+
+    /// @brief Responses with the metadata of a specific version of a product
+    size_t specificVersion{c_defaultMaxResponseSize};
+
+    /// @brief Responses with the download information of a version of a product
+    size_t downloadInfo{c_defaultMaxResponseSize};
+};
+
 /// @brief Configurations to create an SFSClient instance
 struct ClientConfig
 {
@@ -27,9 +53,52 @@ struct ClientConfig
      * @details This function returns logging information from the SFSClient. The caller is responsible for
      * incorporating the received data into their logging system. The callback will be called in the same
      * thread as the main flow, so make sure the callback does not block for too long so it doesn't delay
-     * operations. The LogData does not exist after the callback returns, so caller has to copy it if the
-     * data will be stored.
+     * operations, unless asyncLogging is set. The LogData does not exist after the callback returns, so caller has to
+     * copy it if the data will be stored.
      */
     std::optional<LoggingCallbackFn> logCallbackFn;
+
+    /**
+     * @brief The least severe messages passed to logCallbackFn
+     * @details From least to most severe, severities are Verbose, Info, Warning and Error. Less severe messages are
+     * dropped before being formatted, which saves the cost of building them.
+     */
+    LogSeverity minLogSeverity{LogSeverity::Verbose};
+
+    /**
+     * @brief A logging callback function that receives the values of each message instead of its formatted text
+     * (optional)
+     * @details Values like products, versions, URLs, correlation vectors and request attempts come as named fields,
+     * without the message being formatted, so they don't need to be parsed back from the text. It can be set along
+     * with logCallbackFn. It is called from the thread that logs, even if asyncLogging is set, and may be called from
+     * multiple threads at once. The StructuredLogData does not exist after the callback returns.
+     */
+    std::optional<StructuredLoggingCallbackFn> structuredLogCallbackFn{};
+
+    /**
+     * @brief Calls logCallbackFn from a background thread instead of the thread that logs (optional)
+     * @details Messages still queued when the SFSClient instance is destroyed are delivered before it is. Exceptions
+     * thrown by logCallbackFn are ignored.
+     */
+    std::optional<AsyncLoggingConfig> asyncLogging{};
+
+    /**
+     * @brief Maximum number of concurrent requests that can be multiplexed over a single connection to the service
+     * @details Requests made concurrently through the same SFSClient instance share connections with the service as
+     * HTTP/2 streams when the server supports it, which saves connection handshakes. Set to 0 to disable multiplexing,
+     * in which case each request performs its own transfer.
+     */
+    unsigned maxStreamsPerConnection{c_defaultMaxStreamsPerConnection};
+
+    /// @brief Maximum size of the responses accepted from the service. All limits must be greater than 0
+    ResponseSizeLimits responseSizeLimits{};
+
+    /**
+     * @brief Maximum number of distinct values shared between the results returned by this SFSClient instance
+     * @details Namespaces, names and platform applicability values repeat across many results. The SFSClient keeps a
+     * pool of those values so results point to the same immutable storage instead of holding their own copies. Values
+     * no longer used by any result are dropped when the pool is full. Set to 0 to disable the pool.
+     */
+    size_t maxInternedStrings{c_defaultMaxInternedStrings};
 };
 } // namespace SFS
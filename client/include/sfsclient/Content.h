@@ -7,12 +7,41 @@
 #include "File.h"
 #include "Result.h"
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace SFS
 {
+/**
+ * @brief 128-bit fingerprint of the values of a content
+ * @details Contents that compare equal have the same fingerprint, and it is stable across processes and platforms, so
+ * it can be stored to detect changes between requests. Contents that differ have different fingerprints with
+ * overwhelming probability. The hash is not cryptographic, so it must not be used to verify untrusted data.
+ */
+struct ContentFingerprint
+{
+    uint64_t high{0};
+    uint64_t low{0};
+
+    bool operator==(const ContentFingerprint& other) const noexcept
+    {
+        return high == other.high && low == other.low;
+    }
+
+    bool operator!=(const ContentFingerprint& other) const noexcept
+    {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief Immutable content returned by the SFSClient
+ * @details Copies share the same data, so they are cheap to make and can be used from multiple threads at once.
+ */
 class Content
 {
   public:
@@ -43,8 +72,8 @@ class Content
 
     Content(Content&&) noexcept;
 
-    Content(const Content&) = delete;
-    Content& operator=(const Content&) = delete;
+    Content(const Content&) = default;
+    Content& operator=(const Content&) = default;
 
     /**
      * @return Unique content identifier
@@ -53,10 +82,29 @@ class Content
 
     const std::vector<File>& GetFiles() const noexcept;
 
+    /**
+     * @return Fingerprint of the content id and files, computed when the content is built
+     * @details The order of the files doesn't change the fingerprint, as they are compared as a set
+     */
+    ContentFingerprint GetFingerprint() const noexcept;
+
+    /**
+     * @return The file with the given @param fileId, or nullptr if there is none
+     * @details Lookups go through an index that is built on the first call, so repeated lookups don't scan the files
+     */
+    const File* FindFile(std::string_view fileId) const;
+
   private:
     Content() = default;
 
-    std::unique_ptr<ContentId> m_contentId;
-    std::vector<File> m_files;
+    struct Data;
+    std::shared_ptr<const Data> m_data;
 };
+
+/**
+ * @brief Callback that receives each file of a content as soon as it has been received and validated
+ * @param contentId Identifies the content the file belongs to
+ * @param file The file, which the callback can move from
+ */
+using FileCallbackFn = std::function<void(const ContentId& contentId, File&& file)>;
 } // namespace SFS
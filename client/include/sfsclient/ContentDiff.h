@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "AppContent.h"
+#include "Content.h"
+#include "Result.h"
+
+#include <vector>
+
+namespace SFS
+{
+/**
+ * @brief Files that differ between two versions of a content, matched by FileId
+ * @details The pointers refer to the files of the contents that were compared. Contents share their data with their
+ * copies, so the pointers stay valid while either content, or any copy of it, is alive.
+ */
+template <typename FileT>
+struct FilesDiff
+{
+    /// @brief Files of the newer content whose FileId is not in the older one, in the order of the newer content
+    std::vector<const FileT*> added;
+
+    /// @brief Files of the older content whose FileId is not in the newer one, in the order of the older content
+    std::vector<const FileT*> removed;
+
+    /// @brief Files of the newer content whose size or hashes differ from the file with the same FileId in the older
+    /// one, in the order of the newer content
+    std::vector<const FileT*> changed;
+
+    /// @return true if no file was added, removed or changed
+    bool IsEmpty() const noexcept
+    {
+        return added.empty() && removed.empty() && changed.empty();
+    }
+};
+
+/**
+ * @brief Computes the files that were added, removed or changed from @param from to @param to
+ * @details Files are matched by FileId and compared by size and hashes, so a file that only moved to a different URL
+ * is not reported as changed. Runs in time linear to the number of files. When several files share a FileId, only the
+ * first one is compared.
+ * @param out Receives the differences. Its previous contents are replaced
+ */
+[[nodiscard]] Result DiffFiles(const Content& from, const Content& to, FilesDiff<File>& out) noexcept;
+
+/**
+ * @brief Computes the app files that were added, removed or changed from @param from to @param to
+ * @details Same as the Content overload. Only the files of the apps themselves are compared, not the ones of their
+ * prerequisites. Applicability details are not compared
+ */
+[[nodiscard]] Result DiffFiles(const AppContent& from, const AppContent& to, FilesDiff<AppFile>& out) noexcept;
+
+/**
+ * @brief Same as the AppContent overload, for the files of a prerequisite
+ */
+[[nodiscard]] Result DiffFiles(const AppPrerequisiteContent& from,
+                               const AppPrerequisiteContent& to,
+                               FilesDiff<AppFile>& out) noexcept;
+} // namespace SFS
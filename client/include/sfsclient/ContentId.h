@@ -10,6 +10,11 @@
 
 namespace SFS
 {
+namespace details
+{
+class StringPool;
+}
+
 class ContentId
 {
   public:
@@ -41,8 +46,11 @@ class ContentId
   private:
     ContentId() = default;
 
-    std::string m_nameSpace;
-    std::string m_name;
+    friend class details::StringPool;
+
+    // Namespace and name repeat across contents, so their storage can be shared through a details::StringPool
+    std::shared_ptr<const std::string> m_nameSpace;
+    std::shared_ptr<const std::string> m_name;
     std::string m_version;
 };
 } // namespace SFS
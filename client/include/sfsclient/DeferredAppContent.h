@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "AppContent.h"
+#include "AppFile.h"
+#include "ContentId.h"
+#include "Result.h"
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace SFS
+{
+/**
+ * @brief Prerequisite of a DeferredAppContent whose download info may still be being retrieved
+ * @details Copies share the same data, so they are cheap to make and can be used from multiple threads at once.
+ */
+class DeferredAppPrerequisite
+{
+  public:
+    /**
+     * @param content Future that receives the prerequisite, or the failure to retrieve it. Must be valid
+     */
+    [[nodiscard]] static Result Make(std::unique_ptr<ContentId>&& contentId,
+                                     std::shared_future<AppPrerequisiteContent> content,
+                                     std::unique_ptr<DeferredAppPrerequisite>& out) noexcept;
+
+    DeferredAppPrerequisite(DeferredAppPrerequisite&&) noexcept;
+
+    DeferredAppPrerequisite(const DeferredAppPrerequisite&) = default;
+    DeferredAppPrerequisite& operator=(const DeferredAppPrerequisite&) = default;
+
+    /**
+     * @return Unique content identifier, available right away
+     */
+    const ContentId& GetContentId() const noexcept;
+
+    /**
+     * @return Whether the prerequisite has been retrieved, or failed to be, so that Get() doesn't wait
+     */
+    bool IsReady() const noexcept;
+
+    /**
+     * @brief Gets the prerequisite with its files, waiting for it to be retrieved if needed
+     * @param out Receives the prerequisite. Reset if retrieving it failed
+     * @return The failure to retrieve the prerequisite, if any
+     */
+    [[nodiscard]] Result Get(std::unique_ptr<AppPrerequisiteContent>& out) const noexcept;
+
+  private:
+    DeferredAppPrerequisite() = default;
+
+    struct Data;
+    std::shared_ptr<const Data> m_data;
+};
+
+/**
+ * @brief App content returned by the SFSClient before the download info of its prerequisites is retrieved
+ * @details The content id, update id and files of the app are available right away, and each prerequisite is
+ * available as soon as it is retrieved. Copies share the same data, so they are cheap to make and can be used from
+ * multiple threads at once.
+ */
+class DeferredAppContent
+{
+  public:
+    [[nodiscard]] static Result Make(std::unique_ptr<ContentId>&& contentId,
+                                     std::string updateId,
+                                     std::vector<DeferredAppPrerequisite>&& prerequisites,
+                                     std::vector<AppFile>&& files,
+                                     std::unique_ptr<DeferredAppContent>& out) noexcept;
+
+    DeferredAppContent(DeferredAppContent&&) noexcept;
+
+    DeferredAppContent(const DeferredAppContent&) = default;
+    DeferredAppContent& operator=(const DeferredAppContent&) = default;
+
+    /**
+     * @return Unique content identifier
+     */
+    const ContentId& GetContentId() const noexcept;
+
+    /**
+     * @return Unique Update Id
+     */
+    const std::string& GetUpdateId() const noexcept;
+
+    /**
+     * @return Files belonging to this App
+     */
+    const std::vector<AppFile>& GetFiles() const noexcept;
+
+    /**
+     * @return List of Prerequisite content needed for this App, which may still be being retrieved
+     */
+    const std::vector<DeferredAppPrerequisite>& GetPrerequisites() const noexcept;
+
+  private:
+    DeferredAppContent() = default;
+
+    struct Data;
+    std::shared_ptr<const Data> m_data;
+};
+} // namespace SFS
@@ -5,19 +5,30 @@
 
 #include "Result.h"
 
+#include <array>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
 namespace SFS
 {
+namespace details
+{
+class FingerprintBuilder;
+}
+
 enum class HashType
 {
     Sha1,
     Sha256
 };
 
+using Sha1Digest = std::array<uint8_t, 20>;
+using Sha256Digest = std::array<uint8_t, 32>;
+
 class File
 {
   public:
@@ -49,9 +60,23 @@ class File
 
     /**
      * @return Dictionary of algorithm type to base64 encoded file hash string
+     * @note The hashes are held as binary digests, so the dictionary is only built on the first call. Prefer
+     * GetSha1Digest() and GetSha256Digest() to compare hashes
      */
     const std::unordered_map<HashType, std::string>& GetHashes() const noexcept;
 
+    /**
+     * @return Binary SHA1 digest of the file, or std::nullopt if the file has no SHA1 hash that is a base64 encoded
+     * 20-byte digest
+     */
+    std::optional<Sha1Digest> GetSha1Digest() const noexcept;
+
+    /**
+     * @return Binary SHA256 digest of the file, or std::nullopt if the file has no SHA256 hash that is a base64 encoded
+     * 32-byte digest
+     */
+    std::optional<Sha256Digest> GetSha256Digest() const noexcept;
+
   protected:
     File(std::string&& fileId,
          std::string&& url,
@@ -61,10 +86,32 @@ class File
     [[nodiscard]] Result Clone(std::unique_ptr<File>& out) const noexcept;
 
     friend class Content;
+    friend class details::FingerprintBuilder;
 
     std::string m_fileId;
     std::string m_url;
     uint64_t m_sizeInBytes;
-    std::unordered_map<HashType, std::string> m_hashes;
+
+  private:
+    void StoreHashes(std::unordered_map<HashType, std::string>&& hashes);
+
+    enum HashSlot : uint8_t
+    {
+        Sha1Slot = 1 << 0,
+        Sha256Slot = 1 << 1,
+    };
+
+    // Binary digests of the hashes, decoded once when the file is made so comparing them is cheap. A slot is only set
+    // if its hash is the canonical base64 encoding of a digest of the expected size
+    Sha1Digest m_sha1{};
+    Sha256Digest m_sha256{};
+    uint8_t m_hashSlots{0};
+
+    // Hashes that don't fit a slot, kept as given. Null if there are none, which is the usual case
+    std::unique_ptr<const std::unordered_map<HashType, std::string>> m_otherHashes;
+
+    // Built by GetHashes() from the slots and m_otherHashes
+    mutable std::unique_ptr<const std::unordered_map<HashType, std::string>> m_hashes;
+    mutable std::once_flag m_hashesBuilt;
 };
 } // namespace SFS
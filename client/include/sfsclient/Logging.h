@@ -4,11 +4,17 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <string>
+#include <string_view>
+#include <variant>
 
 namespace SFS
 {
+constexpr size_t c_defaultLogQueueSize = 256;
+
 enum class LogSeverity
 {
     Info,
@@ -29,5 +35,73 @@ struct LogData
 
 using LoggingCallbackFn = std::function<void(const LogData&)>;
 
+using LogValue = std::variant<std::string_view, int64_t, uint64_t, double>;
+
+/**
+ * @brief A value logged as part of a message, like a product name, a URL or a request attempt
+ * @details key names the value, like "product", "version", "url", "cv" or "attempt". It is empty for values that are
+ * only meaningful as part of the message.
+ */
+struct LogField
+{
+    std::string_view key;
+    LogValue value;
+};
+
+/**
+ * @brief A log message as the values it is made of, before being formatted
+ * @details format is the printf-style template of the message, in which each conversion stands for the next field.
+ * Use FormatLogMessage() to get the message a LogData would have. String values and the fields only exist during the
+ * callback call.
+ */
+struct StructuredLogData
+{
+    LogSeverity severity;
+    const char* format;
+    const LogField* fields;
+    size_t fieldCount;
+    const char* file;
+    unsigned line;
+    const char* function;
+    std::chrono::time_point<std::chrono::system_clock> time;
+};
+
+using StructuredLoggingCallbackFn = std::function<void(const StructuredLogData&)>;
+
+/// @brief What to do with a new log message when the queue of asynchronous logging is full
+enum class LogOverflowPolicy
+{
+    /// @brief Drop the oldest queued message to make room, so logging never waits. Drops are reported with a warning
+    DropOldest,
+
+    /// @brief Wait for the logging thread to make room, so no message is lost. Messages logged from the logging thread
+    /// itself, like from the logging callback, can't wait and drop the oldest message instead
+    Block,
+};
+
+/**
+ * @brief Configuration of asynchronous logging
+ * @details Log messages are queued without locking, and the logging callback is called with them in batches from a
+ * background thread. Logging then neither waits for the callback nor for other requests logging at the same time.
+ */
+struct AsyncLoggingConfig
+{
+    /// @brief Maximum number of messages waiting to be passed to the logging callback. Must be greater than 0
+    size_t queueSize{c_defaultLogQueueSize};
+
+    /// @brief What to do with a new message when the queue is full
+    LogOverflowPolicy overflowPolicy{LogOverflowPolicy::DropOldest};
+};
+
 std::string_view ToString(LogSeverity severity) noexcept;
+
+/**
+ * @return The message of @param data formatted as text, the same as LogData::message
+ */
+std::string FormatLogMessage(const StructuredLogData& data);
+
+/**
+ * @return The first field of @param data named @param key, or nullptr if there is none
+ */
+const LogField* FindField(const StructuredLogData& data, std::string_view key) noexcept;
 }; // namespace SFS
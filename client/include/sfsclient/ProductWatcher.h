@@ -0,0 +1,100 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "Content.h"
+#include "RequestParams.h"
+#include "Result.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace SFS
+{
+namespace details
+{
+class ProductWatcherImpl;
+}
+
+constexpr std::chrono::milliseconds c_defaultPollInterval = std::chrono::hours(1);
+constexpr std::chrono::milliseconds c_defaultBatchWindow = std::chrono::minutes(1);
+
+/// @brief A product polled by a ProductWatcher
+struct WatchedProduct
+{
+    /// @brief The product to poll for (required)
+    /// @note Products are identified by ProductRequest::product, which must be unique among the watched products
+    ProductRequest request;
+
+    /// @brief Time between two polls of this product (optional). Must be greater than 0
+    std::chrono::milliseconds pollInterval{c_defaultPollInterval};
+
+    /// @brief The version of the product the caller already has (optional)
+    /// @note If not provided, the first poll reports the latest version as a change
+    std::optional<std::string> currentVersion;
+};
+
+/// @brief Called with the Content of the new version of a watched product
+using ProductChangedCallbackFn = std::function<void(Content&& content)>;
+
+/// @brief Called with the failure of a poll
+using WatchErrorCallbackFn = std::function<void(const Result& result)>;
+
+/// @brief Configurations to watch products for new versions
+struct WatchParams
+{
+    /// @brief List of products to be watched (required)
+    std::vector<WatchedProduct> products;
+
+    /// @brief Called when the latest version of a product is not the last one seen (required)
+    ProductChangedCallbackFn onChange;
+
+    /// @brief Called when a poll fails (optional)
+    /// @note The failure is also logged. The products of the failed poll are polled again after their interval
+    WatchErrorCallbackFn onError;
+
+    /// @brief Identifies this device to spread polls over time (optional)
+    /// @note Each device polls at a stable offset within the poll interval, derived from this value, so a fleet of
+    /// devices started at the same time doesn't poll the service at once. If not provided, the machine name is used
+    std::optional<std::string> deviceId;
+
+    /// @brief Products due within this time of each other are polled together in a single batch request (optional)
+    /// @note A larger window saves requests at the cost of polling some products early
+    std::chrono::milliseconds batchWindow{c_defaultBatchWindow};
+
+    /// @brief Parameters used for every poll (optional)
+    /// @note RequestParams::productRequests is ignored, each poll requests the products that are due
+    RequestParams requestParams;
+};
+
+/**
+ * @brief Polls the SFS service for new versions of a set of products, in the background
+ * @details Made through SFSClient::Watch(). Polls are made from an internal thread, which also calls the callbacks of
+ * WatchParams, one call at a time. Due products are grouped into batch requests, and download info is only retrieved
+ * for products whose latest version changed.
+ */
+class ProductWatcher
+{
+  public:
+    /**
+     * @brief Stops watching
+     * @details Waits for an ongoing poll and its callbacks to finish. Must not be called from one of the callbacks
+     */
+    ~ProductWatcher() noexcept;
+
+    ProductWatcher(const ProductWatcher&) = delete;
+    ProductWatcher& operator=(const ProductWatcher&) = delete;
+
+  private:
+    ProductWatcher() noexcept;
+
+    std::unique_ptr<details::ProductWatcherImpl> m_impl;
+
+    friend class SFSClient;
+};
+} // namespace SFS
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include "ApplicabilityDetails.h"
+
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -12,6 +15,9 @@ namespace SFS
 {
 using TargetingAttributes = std::unordered_map<std::string, std::string>;
 
+/// @brief Map of product name or GUID, as used in ProductRequest::product, to a version of it
+using ProductVersions = std::unordered_map<std::string, std::string>;
+
 constexpr unsigned c_maxRetries = 3;
 
 struct ProductRequest
@@ -23,12 +29,27 @@ struct ProductRequest
     TargetingAttributes attributes;
 };
 
+/// @brief Selects which files of app contents are kept, based on their ApplicabilityDetails
+struct ApplicabilityFilter
+{
+    /// @brief Files that apply to none of these architectures are dropped (optional)
+    /// @note Architecture-neutral files (Architecture::None, or no architecture listed) are always kept. If empty, the
+    /// architecture of this machine is used, and nothing is dropped if it is not recognized. Files built for a
+    /// different architecture that this machine can emulate, like x86 on Amd64, are only kept if it is listed
+    std::vector<Architecture> architectures;
+
+    /// @brief Files whose PlatformApplicabilityForPackage contains none of these values are dropped (optional)
+    /// @note Values are compared case-insensitively. If empty, files are not filtered by platform
+    std::vector<std::string> platforms;
+};
+
 /// @brief Configurations to perform a request to the SFS service
 struct RequestParams
 {
     /// @brief List of products to be retrieved from the server (required)
-    /// @note At the moment only a single product request is supported. Using a vector for future implementation of
-    /// batch requests
+    /// @note GetLatestAppDownloadInfo(), GetLatestAppDownloadInfoDeferred() and GetLatestDownloadInfoIfUpdated() accept
+    /// several products. GetLatestDownloadInfo(), StreamLatestDownloadInfo() and StreamLatestAppDownloadInfo() still
+    /// require exactly one
     std::vector<ProductRequest> productRequests;
 
     /// @brief Base CorrelationVector to be used in the request for service telemetry stitching (optional)
@@ -42,5 +63,23 @@ struct RequestParams
 
     /// @brief Retry for a web request after a failed attempt. If true, client will retry up to c_maxRetries times
     bool retryOnError{true};
+
+    /// @brief Compress large request bodies, like the ones of batch requests, with gzip before sending them (optional)
+    /// @note Only enable it if the service accepts gzip-encoded requests. Small bodies are always sent uncompressed
+    bool compressRequestBody{false};
+
+    /// @brief Memory resource for the JSON DOM containers built while parsing the responses of this request (optional)
+    /// @note Only the object and array nodes of the parsed JSON are allocated from it, each with a pointer-sized header
+    /// that records the resource, and they are all freed before the request returns. Everything else uses the default
+    /// allocator: JSON strings, the entities read from the JSON, the returned contents, and the responses that other
+    /// threads parse for batches and prerequisites requested concurrently. The resource is only used from the calling
+    /// thread, so it only needs to be synchronized if it is shared by concurrent requests. It is not used when the
+    /// client is built with the simdjson backend. If not provided, the default allocator is used
+    std::pmr::memory_resource* memoryResource{nullptr};
+
+    /// @brief Keeps only the app files, including the ones of prerequisites, that match this filter (optional)
+    /// @note Files are dropped while the response is parsed, before any AppFile is built for them. Only used by app
+    /// requests. If not provided, all files are returned
+    std::optional<ApplicabilityFilter> applicabilityFilter;
 };
 } // namespace SFS
@@ -26,6 +26,7 @@ class Result
         NotSet = 0x8000'0003,
         OutOfMemory = 0x8000'0004,
         Unexpected = 0x8000'0005,
+        Cancelled = 0x8000'0006,
 
         // Connection errors start at 0x8000'1000
         ConnectionSetupFailed = 0x8000'1000,
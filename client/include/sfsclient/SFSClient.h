@@ -6,7 +6,9 @@
 #include "AppContent.h"
 #include "ClientConfig.h"
 #include "Content.h"
+#include "DeferredAppContent.h"
 #include "Logging.h"
+#include "ProductWatcher.h"
 #include "RequestParams.h"
 #include "Result.h"
 
@@ -57,13 +59,89 @@ class SFSClient
 
     /**
      * @brief Retrieve combined metadata & download URLs from the latest version of specified apps
-     * @note At the moment only a single product request is supported
+     * @details Multiple apps are allowed, and their latest versions are requested through batch requests. Many apps
+     * are split into batches sent concurrently, and an app requested more than once is only returned once. InvalidArg
+     * is returned if the requests of an app have different attributes. An app that the service doesn't return in a
+     * batch is skipped. Prerequisites shared by several apps, like frameworks, are only requested once, and the
+     * prerequisites of different apps are requested concurrently. The returned contents share the data of their
+     * common AppPrerequisiteContent
      * @param requestParams Parameters that define this request
      * @param contents A vector of AppContent that is populated with the result
      */
     [[nodiscard]] Result GetLatestAppDownloadInfo(const RequestParams& requestParams,
                                                   std::vector<AppContent>& contents) const noexcept;
 
+    /**
+     * @brief Retrieve combined metadata & download URLs from the latest version of specified apps, returning as soon
+     * as the download info of the apps themselves is retrieved
+     * @details Works like GetLatestAppDownloadInfo(), but the download info of the prerequisites is retrieved in the
+     * background after this call returns. The content id of each prerequisite is available right away, and
+     * DeferredAppPrerequisite::Get() waits for the rest. A prerequisite that can't be retrieved fails its Get() call
+     * instead of this one. Destroying the SFSClient cancels the prerequisites that are still being retrieved,
+     * failing their Get() calls with Result::Cancelled, and only waits for the requests already in flight
+     * @param requestParams Parameters that define this request. RequestParams::memoryResource is only used during this
+     * call
+     * @param contents A vector of DeferredAppContent that is populated with the result
+     */
+    [[nodiscard]] Result GetLatestAppDownloadInfoDeferred(const RequestParams& requestParams,
+                                                          std::vector<DeferredAppContent>& contents) const noexcept;
+
+    /**
+     * @brief Retrieve download URLs from the latest version of specified products, delivering each file as soon as it
+     * is received
+     * @details Unlike GetLatestDownloadInfo(), no Content is built. @param onFile is called with each File in the
+     * order of the response, so the caller can start using the first files while the rest are still being received,
+     * and only one file is kept in memory at a time. The callback is called from the calling thread while the response
+     * is received in the background, which pauses while the callback falls behind. An exception thrown by the callback
+     * fails the request. If the request fails, the files already delivered are an incomplete result.
+     * @note At the moment only a single product request is supported
+     * @param requestParams Parameters that define this request
+     * @param onFile Callback that receives each file. Must not be empty
+     */
+    [[nodiscard]] Result StreamLatestDownloadInfo(const RequestParams& requestParams,
+                                                  const FileCallbackFn& onFile) const noexcept;
+
+    /**
+     * @brief Retrieve download URLs from the latest version of specified apps and their prerequisites, delivering each
+     * file as soon as it is received
+     * @details Works like StreamLatestDownloadInfo(). The files of the app are delivered first, followed by the files
+     * of each prerequisite. The ContentId passed with each file tells which one it belongs to.
+     * @note At the moment only a single product request is supported
+     * @param requestParams Parameters that define this request
+     * @param onFile Callback that receives each file. Must not be empty
+     */
+    [[nodiscard]] Result StreamLatestAppDownloadInfo(const RequestParams& requestParams,
+                                                     const AppFileCallbackFn& onFile) const noexcept;
+
+    /**
+     * @brief Retrieve combined metadata & download URLs for the products whose latest version is not the one the
+     * caller already has
+     * @details Only the latest version is requested for products that are up to date, and their download info is
+     * not. Multiple products are allowed, and their latest versions are requested through batch requests. Many products
+     * are split into batches sent concurrently, sized from how fast and how big the previous responses were, and the
+     * results keep the order of the requests. A product requested more than once is only returned once, and InvalidArg
+     * is returned if its requests have different attributes. A product that the service doesn't return in a batch is
+     * skipped.
+     * @param requestParams Parameters that define this request
+     * @param currentVersions The version the caller has of each product. Products missing from it are considered out
+     * of date. Versions are compared as exact strings
+     * @param contents Receives a Content for each product that is out of date. Empty if all products are up to date
+     */
+    [[nodiscard]] Result GetLatestDownloadInfoIfUpdated(const RequestParams& requestParams,
+                                                        const ProductVersions& currentVersions,
+                                                        std::vector<Content>& contents) const noexcept;
+
+    /**
+     * @brief Start polling the SFS service in the background for new versions of a set of products
+     * @details Due products are polled together through a batch request, like GetLatestDownloadInfoIfUpdated() does,
+     * and WatchParams::onChange is only called for the products whose latest version changed since the last poll.
+     * Polls are spread over the poll interval with a stable offset per device, see WatchParams::deviceId. Watching
+     * stops when the ProductWatcher is destroyed
+     * @param params Describes the products to watch and how to report changes
+     * @param out The ProductWatcher that keeps watching while alive. Must be destroyed before this SFSClient
+     */
+    [[nodiscard]] Result Watch(WatchParams params, std::unique_ptr<ProductWatcher>& out) const noexcept;
+
     /**
      * @return The version of the SFSClient library
      */
@@ -4,8 +4,63 @@
 #include "AppContent.h"
 
 #include "details/ErrorHandling.h"
+#include "details/FileIndex.h"
+#include "details/Fingerprint.h"
+#include "details/OSInfo.h"
 
 using namespace SFS;
+using namespace SFS::details;
+
+struct AppPrerequisiteContent::Data
+{
+    Data() : fileIndex(files)
+    {
+    }
+
+    std::unique_ptr<ContentId> contentId;
+    std::vector<AppFile> files;
+
+    FileIndex<AppFile> fileIndex;
+
+    ContentFingerprint fingerprint;
+
+    void ComputeFingerprint()
+    {
+        fingerprint = FingerprintBuilder()
+                          .Add(FingerprintBuilder::Of(*contentId))
+                          .Add(FingerprintBuilder::OfUnordered(files))
+                          .Finish();
+    }
+};
+
+struct AppContent::Data
+{
+    Data() : fileIndex(files)
+    {
+    }
+
+    std::unique_ptr<ContentId> contentId;
+    std::vector<AppFile> files;
+
+    FileIndex<AppFile> fileIndex;
+
+    std::string updateId;
+    std::vector<AppPrerequisiteContent> prerequisites;
+
+    ContentFingerprint fingerprint;
+
+    void ComputeFingerprint()
+    {
+        FingerprintBuilder builder;
+        builder.Add(FingerprintBuilder::Of(*contentId)).Add(updateId).Add(FingerprintBuilder::OfUnordered(files));
+        builder.Add(static_cast<uint64_t>(prerequisites.size()));
+        for (const auto& prerequisite : prerequisites)
+        {
+            builder.Add(prerequisite.GetFingerprint());
+        }
+        fingerprint = builder.Finish();
+    }
+};
 
 Result AppPrerequisiteContent::Make(std::unique_ptr<ContentId>&& contentId,
                                     std::vector<AppFile>&& files,
@@ -14,9 +69,14 @@ try
 {
     out.reset();
 
+    auto data = std::make_shared<Data>();
+    data->contentId = std::move(contentId);
+    data->files = std::move(files);
+
+    data->ComputeFingerprint();
+
     std::unique_ptr<AppPrerequisiteContent> tmp(new AppPrerequisiteContent());
-    tmp->m_contentId = std::move(contentId);
-    tmp->m_files = std::move(files);
+    tmp->m_data = std::move(data);
 
     out = std::move(tmp);
 
@@ -26,18 +86,42 @@ SFS_CATCH_RETURN()
 
 AppPrerequisiteContent::AppPrerequisiteContent(AppPrerequisiteContent&& other) noexcept
 {
-    m_contentId = std::move(other.m_contentId);
-    m_files = std::move(other.m_files);
+    m_data = std::move(other.m_data);
 }
 
 const ContentId& AppPrerequisiteContent::GetContentId() const noexcept
 {
-    return *m_contentId;
+    return *m_data->contentId;
 }
 
 const std::vector<AppFile>& AppPrerequisiteContent::GetFiles() const noexcept
 {
-    return m_files;
+    return m_data->files;
+}
+
+ContentFingerprint AppPrerequisiteContent::GetFingerprint() const noexcept
+{
+    return m_data->fingerprint;
+}
+
+const AppFile* AppPrerequisiteContent::FindFile(std::string_view fileId) const
+{
+    return m_data->fileIndex.FindByFileId(fileId);
+}
+
+const AppFile* AppPrerequisiteContent::FindFileByMoniker(std::string_view fileMoniker) const
+{
+    return m_data->fileIndex.FindByFileMoniker(fileMoniker);
+}
+
+const AppFile* AppPrerequisiteContent::FindApplicableFile(Architecture architecture) const
+{
+    return m_data->fileIndex.FindApplicable(architecture);
+}
+
+const AppFile* AppPrerequisiteContent::FindApplicableFile() const
+{
+    return FindApplicableFile(osinfo::GetOSArchitecture());
 }
 
 Result AppContent::Make(std::unique_ptr<ContentId>&& contentId,
@@ -49,11 +133,16 @@ try
 {
     out.reset();
 
+    auto data = std::make_shared<Data>();
+    data->contentId = std::move(contentId);
+    data->updateId = std::move(updateId);
+    data->prerequisites = std::move(prerequisites);
+    data->files = std::move(files);
+
+    data->ComputeFingerprint();
+
     std::unique_ptr<AppContent> tmp(new AppContent());
-    tmp->m_contentId = std::move(contentId);
-    tmp->m_updateId = std::move(updateId);
-    tmp->m_prerequisites = std::move(prerequisites);
-    tmp->m_files = std::move(files);
+    tmp->m_data = std::move(data);
 
     out = std::move(tmp);
 
@@ -63,28 +152,50 @@ SFS_CATCH_RETURN()
 
 AppContent::AppContent(AppContent&& other) noexcept
 {
-    m_contentId = std::move(other.m_contentId);
-    m_updateId = std::move(other.m_updateId);
-    m_prerequisites = std::move(other.m_prerequisites);
-    m_files = std::move(other.m_files);
+    m_data = std::move(other.m_data);
 }
 
 const ContentId& AppContent::GetContentId() const noexcept
 {
-    return *m_contentId;
+    return *m_data->contentId;
 }
 
 const std::string& AppContent::GetUpdateId() const noexcept
 {
-    return m_updateId;
+    return m_data->updateId;
 }
 
 const std::vector<AppFile>& AppContent::GetFiles() const noexcept
 {
-    return m_files;
+    return m_data->files;
+}
+
+ContentFingerprint AppContent::GetFingerprint() const noexcept
+{
+    return m_data->fingerprint;
+}
+
+const AppFile* AppContent::FindFile(std::string_view fileId) const
+{
+    return m_data->fileIndex.FindByFileId(fileId);
+}
+
+const AppFile* AppContent::FindFileByMoniker(std::string_view fileMoniker) const
+{
+    return m_data->fileIndex.FindByFileMoniker(fileMoniker);
+}
+
+const AppFile* AppContent::FindApplicableFile(Architecture architecture) const
+{
+    return m_data->fileIndex.FindApplicable(architecture);
+}
+
+const AppFile* AppContent::FindApplicableFile() const
+{
+    return FindApplicableFile(osinfo::GetOSArchitecture());
 }
 
 const std::vector<AppPrerequisiteContent>& AppContent::GetPrerequisites() const noexcept
 {
-    return m_prerequisites;
+    return m_data->prerequisites;
 }
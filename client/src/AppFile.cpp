@@ -11,8 +11,10 @@ AppFile::AppFile(std::string&& fileId,
                  std::string&& url,
                  uint64_t sizeInBytes,
                  std::unordered_map<HashType, std::string>&& hashes,
+                 ApplicabilityDetails&& applicabilityDetails,
                  std::string&& fileMoniker)
     : File(std::move(fileId), std::move(url), sizeInBytes, std::move(hashes))
+    , m_applicabilityDetails(std::move(applicabilityDetails))
     , m_fileMoniker(std::move(fileMoniker))
 {
 }
@@ -33,9 +35,12 @@ try
     RETURN_IF_FAILED(
         ApplicabilityDetails::Make(std::move(architectures), std::move(platformApplicabilityForPackage), details));
 
-    std::unique_ptr<AppFile> tmp(
-        new AppFile(std::move(fileId), std::move(url), sizeInBytes, std::move(hashes), std::move(fileMoniker)));
-    tmp->m_applicabilityDetails = std::move(details);
+    std::unique_ptr<AppFile> tmp(new AppFile(std::move(fileId),
+                                             std::move(url),
+                                             sizeInBytes,
+                                             std::move(hashes),
+                                             std::move(*details),
+                                             std::move(fileMoniker)));
 
     out = std::move(tmp);
 
@@ -43,15 +48,16 @@ try
 }
 SFS_CATCH_RETURN()
 
-AppFile::AppFile(AppFile&& other) noexcept : File(std::move(other))
+AppFile::AppFile(AppFile&& other) noexcept
+    : File(std::move(other))
+    , m_applicabilityDetails(std::move(other.m_applicabilityDetails))
 {
-    m_applicabilityDetails = std::move(other.m_applicabilityDetails);
     m_fileMoniker = std::move(other.m_fileMoniker);
 }
 
 const ApplicabilityDetails& AppFile::GetApplicabilityDetails() const noexcept
 {
-    return *m_applicabilityDetails;
+    return m_applicabilityDetails;
 }
 
 const std::string& AppFile::GetFileMoniker() const noexcept
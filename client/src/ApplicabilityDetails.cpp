@@ -5,8 +5,41 @@
 
 #include "details/ErrorHandling.h"
 
+#include <array>
+#include <utility>
+
 using namespace SFS;
 
+namespace
+{
+constexpr size_t c_architectureCount = static_cast<size_t>(Architecture::x86) + 1;
+
+uint8_t ToBit(Architecture architecture)
+{
+    return static_cast<uint8_t>(1u << static_cast<unsigned>(architecture));
+}
+
+// The list of architectures for each combination of bits, built on first use
+const std::vector<Architecture>& ToArchitectures(uint8_t bits)
+{
+    static const auto lists = []() {
+        std::array<std::vector<Architecture>, 1u << c_architectureCount> lists;
+        for (size_t combination = 0; combination < lists.size(); ++combination)
+        {
+            for (size_t architecture = 0; architecture < c_architectureCount; ++architecture)
+            {
+                if (combination & (size_t{1} << architecture))
+                {
+                    lists[combination].push_back(static_cast<Architecture>(architecture));
+                }
+            }
+        }
+        return lists;
+    }();
+    return lists[bits];
+}
+} // namespace
+
 Result ApplicabilityDetails::Make(std::vector<Architecture> architectures,
                                   std::vector<std::string> platformApplicabilityForPackage,
                                   std::unique_ptr<ApplicabilityDetails>& out) noexcept
@@ -15,8 +48,12 @@ try
     out.reset();
 
     std::unique_ptr<ApplicabilityDetails> tmp(new ApplicabilityDetails());
-    tmp->m_architectures = std::move(architectures);
-    tmp->m_platformApplicabilityForPackage = std::move(platformApplicabilityForPackage);
+    for (const auto architecture : architectures)
+    {
+        tmp->m_architectureBits |= ToBit(architecture);
+    }
+    tmp->m_platformApplicabilityForPackage =
+        std::make_shared<const std::vector<std::string>>(std::move(platformApplicabilityForPackage));
 
     out = std::move(tmp);
 
@@ -24,12 +61,24 @@ try
 }
 SFS_CATCH_RETURN()
 
+ApplicabilityDetails::ApplicabilityDetails(ApplicabilityDetails&& other) noexcept
+{
+    // The shared values are copied so the moved-from object stays usable
+    m_architectureBits = std::exchange(other.m_architectureBits, uint8_t{0});
+    m_platformApplicabilityForPackage = other.m_platformApplicabilityForPackage;
+}
+
 const std::vector<Architecture>& ApplicabilityDetails::GetArchitectures() const noexcept
 {
-    return m_architectures;
+    return ToArchitectures(m_architectureBits);
+}
+
+bool ApplicabilityDetails::HasArchitecture(Architecture architecture) const noexcept
+{
+    return (m_architectureBits & ToBit(architecture)) != 0;
 }
 
 const std::vector<std::string>& ApplicabilityDetails::GetPlatformApplicabilityForPackage() const noexcept
 {
-    return m_platformApplicabilityForPackage;
+    return *m_platformApplicabilityForPackage;
 }
@@ -4,8 +4,33 @@
 #include "Content.h"
 
 #include "details/ErrorHandling.h"
+#include "details/FileIndex.h"
+#include "details/Fingerprint.h"
 
 using namespace SFS;
+using namespace SFS::details;
+
+struct Content::Data
+{
+    Data() : fileIndex(files)
+    {
+    }
+
+    std::unique_ptr<ContentId> contentId;
+    std::vector<File> files;
+
+    FileIndex<File> fileIndex;
+
+    ContentFingerprint fingerprint;
+
+    void ComputeFingerprint()
+    {
+        fingerprint = FingerprintBuilder()
+                          .Add(FingerprintBuilder::Of(*contentId))
+                          .Add(FingerprintBuilder::OfUnordered(files))
+                          .Finish();
+    }
+};
 
 Result Content::Make(std::string contentNameSpace,
                      std::string contentName,
@@ -16,19 +41,25 @@ try
 {
     out.reset();
 
-    std::unique_ptr<Content> tmp(new Content());
+    auto data = std::make_shared<Data>();
     RETURN_IF_FAILED(ContentId::Make(std::move(contentNameSpace),
                                      std::move(contentName),
                                      std::move(contentVersion),
-                                     tmp->m_contentId));
+                                     data->contentId));
 
+    data->files.reserve(files.size());
     for (const auto& file : files)
     {
         std::unique_ptr<File> clone;
         RETURN_IF_FAILED(file.Clone(clone));
-        tmp->m_files.push_back(std::move(*clone));
+        data->files.push_back(std::move(*clone));
     }
 
+    data->ComputeFingerprint();
+
+    std::unique_ptr<Content> tmp(new Content());
+    tmp->m_data = std::move(data);
+
     out = std::move(tmp);
 
     return Result::Success;
@@ -44,12 +75,17 @@ try
 {
     out.reset();
 
-    std::unique_ptr<Content> tmp(new Content());
+    auto data = std::make_shared<Data>();
     RETURN_IF_FAILED(ContentId::Make(std::move(contentNameSpace),
                                      std::move(contentName),
                                      std::move(contentVersion),
-                                     tmp->m_contentId));
-    tmp->m_files = std::move(files);
+                                     data->contentId));
+    data->files = std::move(files);
+
+    data->ComputeFingerprint();
+
+    std::unique_ptr<Content> tmp(new Content());
+    tmp->m_data = std::move(data);
 
     out = std::move(tmp);
 
@@ -64,9 +100,14 @@ try
 {
     out.reset();
 
+    auto data = std::make_shared<Data>();
+    data->contentId = std::move(contentId);
+    data->files = std::move(files);
+
+    data->ComputeFingerprint();
+
     std::unique_ptr<Content> tmp(new Content());
-    tmp->m_contentId = std::move(contentId);
-    tmp->m_files = std::move(files);
+    tmp->m_data = std::move(data);
 
     out = std::move(tmp);
 
@@ -76,16 +117,25 @@ SFS_CATCH_RETURN()
 
 Content::Content(Content&& other) noexcept
 {
-    m_contentId = std::move(other.m_contentId);
-    m_files = std::move(other.m_files);
+    m_data = std::move(other.m_data);
 }
 
 const ContentId& Content::GetContentId() const noexcept
 {
-    return *m_contentId;
+    return *m_data->contentId;
 }
 
 const std::vector<File>& Content::GetFiles() const noexcept
 {
-    return m_files;
+    return m_data->files;
+}
+
+ContentFingerprint Content::GetFingerprint() const noexcept
+{
+    return m_data->fingerprint;
+}
+
+const File* Content::FindFile(std::string_view fileId) const
+{
+    return m_data->fileIndex.FindByFileId(fileId);
 }
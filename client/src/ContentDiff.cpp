@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "ContentDiff.h"
+
+#include "details/ContentUtil.h"
+#include "details/ErrorHandling.h"
+
+using namespace SFS;
+using namespace SFS::details;
+
+namespace
+{
+template <typename FileT, typename ContentT>
+void DiffFilesImpl(const ContentT& from, const ContentT& to, FilesDiff<FileT>& out)
+{
+    FilesDiff<FileT> tmp;
+
+    // A FileId listed more than once is only diffed by its first occurrence, which is the one FindFile() returns
+    for (const auto& file : to.GetFiles())
+    {
+        if (to.FindFile(file.GetFileId()) != &file)
+        {
+            continue;
+        }
+
+        const FileT* previous = from.FindFile(file.GetFileId());
+        if (previous == nullptr)
+        {
+            tmp.added.push_back(&file);
+        }
+        else if (previous->GetSizeInBytes() != file.GetSizeInBytes() || !contentutil::HaveSameHashes(*previous, file))
+        {
+            tmp.changed.push_back(&file);
+        }
+    }
+
+    for (const auto& file : from.GetFiles())
+    {
+        if (from.FindFile(file.GetFileId()) == &file && to.FindFile(file.GetFileId()) == nullptr)
+        {
+            tmp.removed.push_back(&file);
+        }
+    }
+
+    out = std::move(tmp);
+}
+} // namespace
+
+Result SFS::DiffFiles(const Content& from, const Content& to, FilesDiff<File>& out) noexcept
+try
+{
+    DiffFilesImpl(from, to, out);
+    return Result::Success;
+}
+SFS_CATCH_RETURN()
+
+Result SFS::DiffFiles(const AppContent& from, const AppContent& to, FilesDiff<AppFile>& out) noexcept
+try
+{
+    DiffFilesImpl(from, to, out);
+    return Result::Success;
+}
+SFS_CATCH_RETURN()
+
+Result SFS::DiffFiles(const AppPrerequisiteContent& from,
+                      const AppPrerequisiteContent& to,
+                      FilesDiff<AppFile>& out) noexcept
+try
+{
+    DiffFilesImpl(from, to, out);
+    return Result::Success;
+}
+SFS_CATCH_RETURN()
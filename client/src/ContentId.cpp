@@ -16,8 +16,8 @@ try
     out.reset();
 
     std::unique_ptr<ContentId> tmp(new ContentId());
-    tmp->m_nameSpace = std::move(nameSpace);
-    tmp->m_name = std::move(name);
+    tmp->m_nameSpace = std::make_shared<const std::string>(std::move(nameSpace));
+    tmp->m_name = std::make_shared<const std::string>(std::move(name));
     tmp->m_version = std::move(version);
 
     out = std::move(tmp);
@@ -28,19 +28,20 @@ SFS_CATCH_RETURN()
 
 ContentId::ContentId(ContentId&& other) noexcept
 {
-    m_nameSpace = std::move(other.m_nameSpace);
-    m_name = std::move(other.m_name);
+    // The shared values are copied so the moved-from object stays usable
+    m_nameSpace = other.m_nameSpace;
+    m_name = other.m_name;
     m_version = std::move(other.m_version);
 }
 
 const std::string& ContentId::GetNameSpace() const noexcept
 {
-    return m_nameSpace;
+    return *m_nameSpace;
 }
 
 const std::string& ContentId::GetName() const noexcept
 {
-    return m_name;
+    return *m_name;
 }
 
 const std::string& ContentId::GetVersion() const noexcept
@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "DeferredAppContent.h"
+
+#include "details/ErrorHandling.h"
+
+#include <chrono>
+
+using namespace SFS;
+using namespace SFS::details;
+
+struct DeferredAppPrerequisite::Data
+{
+    std::unique_ptr<ContentId> contentId;
+    std::shared_future<AppPrerequisiteContent> content;
+};
+
+struct DeferredAppContent::Data
+{
+    std::unique_ptr<ContentId> contentId;
+    std::string updateId;
+    std::vector<DeferredAppPrerequisite> prerequisites;
+    std::vector<AppFile> files;
+};
+
+Result DeferredAppPrerequisite::Make(std::unique_ptr<ContentId>&& contentId,
+                                     std::shared_future<AppPrerequisiteContent> content,
+                                     std::unique_ptr<DeferredAppPrerequisite>& out) noexcept
+try
+{
+    out.reset();
+
+    THROW_CODE_IF(InvalidArg, !content.valid(), "content must be a valid future");
+
+    auto data = std::make_shared<Data>();
+    data->contentId = std::move(contentId);
+    data->content = std::move(content);
+
+    std::unique_ptr<DeferredAppPrerequisite> tmp(new DeferredAppPrerequisite());
+    tmp->m_data = std::move(data);
+
+    out = std::move(tmp);
+
+    return Result::Success;
+}
+SFS_CATCH_RETURN()
+
+DeferredAppPrerequisite::DeferredAppPrerequisite(DeferredAppPrerequisite&& other) noexcept
+{
+    m_data = std::move(other.m_data);
+}
+
+const ContentId& DeferredAppPrerequisite::GetContentId() const noexcept
+{
+    return *m_data->contentId;
+}
+
+bool DeferredAppPrerequisite::IsReady() const noexcept
+{
+    return m_data->content.wait_for(std::chrono::seconds::zero()) == std::future_status::ready;
+}
+
+Result DeferredAppPrerequisite::Get(std::unique_ptr<AppPrerequisiteContent>& out) const noexcept
+try
+{
+    out.reset();
+    out = std::make_unique<AppPrerequisiteContent>(m_data->content.get());
+    return Result::Success;
+}
+SFS_CATCH_RETURN()
+
+Result DeferredAppContent::Make(std::unique_ptr<ContentId>&& contentId,
+                                std::string updateId,
+                                std::vector<DeferredAppPrerequisite>&& prerequisites,
+                                std::vector<AppFile>&& files,
+                                std::unique_ptr<DeferredAppContent>& out) noexcept
+try
+{
+    out.reset();
+
+    auto data = std::make_shared<Data>();
+    data->contentId = std::move(contentId);
+    data->updateId = std::move(updateId);
+    data->prerequisites = std::move(prerequisites);
+    data->files = std::move(files);
+
+    std::unique_ptr<DeferredAppContent> tmp(new DeferredAppContent());
+    tmp->m_data = std::move(data);
+
+    out = std::move(tmp);
+
+    return Result::Success;
+}
+SFS_CATCH_RETURN()
+
+DeferredAppContent::DeferredAppContent(DeferredAppContent&& other) noexcept
+{
+    m_data = std::move(other.m_data);
+}
+
+const ContentId& DeferredAppContent::GetContentId() const noexcept
+{
+    return *m_data->contentId;
+}
+
+const std::string& DeferredAppContent::GetUpdateId() const noexcept
+{
+    return m_data->updateId;
+}
+
+const std::vector<AppFile>& DeferredAppContent::GetFiles() const noexcept
+{
+    return m_data->files;
+}
+
+const std::vector<DeferredAppPrerequisite>& DeferredAppContent::GetPrerequisites() const noexcept
+{
+    return m_data->prerequisites;
+}
@@ -4,8 +4,12 @@
 #include "File.h"
 
 #include "details/ErrorHandling.h"
+#include "details/Util.h"
+
+#include <iterator>
 
 using namespace SFS;
+using namespace SFS::details;
 
 File::File(std::string&& fileId,
            std::string&& url,
@@ -14,8 +18,43 @@ File::File(std::string&& fileId,
     : m_fileId(std::move(fileId))
     , m_url(std::move(url))
     , m_sizeInBytes(sizeInBytes)
-    , m_hashes(std::move(hashes))
 {
+    StoreHashes(std::move(hashes));
+}
+
+void File::StoreHashes(std::unordered_map<HashType, std::string>&& hashes)
+{
+    for (auto it = hashes.begin(); it != hashes.end();)
+    {
+        bool decoded = false;
+        switch (it->first)
+        {
+        case HashType::Sha1:
+            decoded = util::Base64Decode(it->second, m_sha1.data(), m_sha1.size());
+            m_hashSlots |= decoded ? Sha1Slot : 0;
+            break;
+        case HashType::Sha256:
+            decoded = util::Base64Decode(it->second, m_sha256.data(), m_sha256.size());
+            m_hashSlots |= decoded ? Sha256Slot : 0;
+            break;
+        }
+        it = decoded ? hashes.erase(it) : std::next(it);
+    }
+
+    if (!hashes.empty())
+    {
+        m_otherHashes = std::make_unique<const std::unordered_map<HashType, std::string>>(std::move(hashes));
+    }
+
+    // A failed decode may leave partial data behind, which would break comparisons between digests
+    if (!(m_hashSlots & Sha1Slot))
+    {
+        m_sha1.fill(0);
+    }
+    if (!(m_hashSlots & Sha256Slot))
+    {
+        m_sha256.fill(0);
+    }
 }
 
 Result File::Make(std::string fileId,
@@ -35,16 +74,36 @@ try
 SFS_CATCH_RETURN()
 
 Result File::Clone(std::unique_ptr<File>& out) const noexcept
+try
 {
-    return Make(m_fileId, m_url, m_sizeInBytes, m_hashes, out);
+    out.reset();
+
+    // The digests are copied as they are, so the clone doesn't decode them again
+    std::unique_ptr<File> tmp(new File(std::string(m_fileId), std::string(m_url), m_sizeInBytes, {}));
+    tmp->m_sha1 = m_sha1;
+    tmp->m_sha256 = m_sha256;
+    tmp->m_hashSlots = m_hashSlots;
+    if (m_otherHashes)
+    {
+        tmp->m_otherHashes = std::make_unique<const std::unordered_map<HashType, std::string>>(*m_otherHashes);
+    }
+    out = std::move(tmp);
+
+    return Result::Success;
 }
+SFS_CATCH_RETURN()
 
 File::File(File&& other) noexcept
 {
+    // The dictionary built by GetHashes() stays with the moved-from object, as references to it may still be held.
+    // This object builds its own if needed
     m_fileId = std::move(other.m_fileId);
     m_url = std::move(other.m_url);
     m_sizeInBytes = other.m_sizeInBytes;
-    m_hashes = std::move(other.m_hashes);
+    m_sha1 = other.m_sha1;
+    m_sha256 = other.m_sha256;
+    m_hashSlots = other.m_hashSlots;
+    m_otherHashes = std::move(other.m_otherHashes);
 }
 
 const std::string& File::GetFileId() const noexcept
@@ -64,5 +123,43 @@ uint64_t File::GetSizeInBytes() const noexcept
 
 const std::unordered_map<HashType, std::string>& File::GetHashes() const noexcept
 {
-    return m_hashes;
+    // Without any digest, the hashes are already held as a dictionary
+    if (m_hashSlots == 0)
+    {
+        static const std::unordered_map<HashType, std::string> noHashes;
+        return m_otherHashes ? *m_otherHashes : noHashes;
+    }
+
+    std::call_once(m_hashesBuilt, [&]() {
+        auto hashes = m_otherHashes ? std::unordered_map<HashType, std::string>(*m_otherHashes)
+                                    : std::unordered_map<HashType, std::string>();
+        if (m_hashSlots & Sha1Slot)
+        {
+            hashes.emplace(HashType::Sha1, util::Base64Encode(m_sha1.data(), m_sha1.size()));
+        }
+        if (m_hashSlots & Sha256Slot)
+        {
+            hashes.emplace(HashType::Sha256, util::Base64Encode(m_sha256.data(), m_sha256.size()));
+        }
+        m_hashes = std::make_unique<const std::unordered_map<HashType, std::string>>(std::move(hashes));
+    });
+    return *m_hashes;
+}
+
+std::optional<Sha1Digest> File::GetSha1Digest() const noexcept
+{
+    if (m_hashSlots & Sha1Slot)
+    {
+        return m_sha1;
+    }
+    return std::nullopt;
+}
+
+std::optional<Sha256Digest> File::GetSha256Digest() const noexcept
+{
+    if (m_hashSlots & Sha256Slot)
+    {
+        return m_sha256;
+    }
+    return std::nullopt;
 }
@@ -3,7 +3,77 @@
 
 #include "Logging.h"
 
-using SFS::LogSeverity;
+#include <cstring>
+#include <stdio.h>
+#include <type_traits>
+
+using namespace SFS;
+
+namespace
+{
+template <typename... Args>
+void AppendFormatted(std::string& out, const std::string& spec, const Args&... args)
+{
+    const int size = snprintf(nullptr, 0, spec.c_str(), args...);
+    if (size <= 0)
+    {
+        return;
+    }
+
+    const size_t offset = out.size();
+    out.resize(offset + static_cast<size_t>(size) + 1);
+    snprintf(out.data() + offset, static_cast<size_t>(size) + 1, spec.c_str(), args...);
+    out.resize(offset + static_cast<size_t>(size));
+}
+
+/**
+ * @brief Appends @param value formatted with the flags, width and precision in @param options, and @param conversion
+ * @details The length modifier of the original conversion is replaced with the one of the type of the value. Values
+ * that don't fit the conversion are appended in their default format.
+ */
+void AppendValue(std::string& out, const std::string& options, char conversion, const LogValue& value)
+{
+    std::visit(
+        [&](const auto& v) {
+            using T = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<T, std::string_view>)
+            {
+                if (conversion == 's')
+                {
+                    AppendFormatted(out, "%" + options + "s", std::string(v).c_str());
+                }
+                else
+                {
+                    out.append(v);
+                }
+            }
+            else if constexpr (std::is_same_v<T, double>)
+            {
+                if (std::strchr("fFeEgGaA", conversion))
+                {
+                    AppendFormatted(out, "%" + options + conversion, v);
+                }
+                else
+                {
+                    out.append(std::to_string(v));
+                }
+            }
+            else if (std::strchr("di", conversion))
+            {
+                AppendFormatted(out, "%" + options + "lld", static_cast<long long>(v));
+            }
+            else if (std::strchr("uxXo", conversion))
+            {
+                AppendFormatted(out, "%" + options + "ll" + conversion, static_cast<unsigned long long>(v));
+            }
+            else
+            {
+                out.append(std::to_string(v));
+            }
+        },
+        value);
+}
+} // namespace
 
 std::string_view SFS::ToString(LogSeverity severity) noexcept
 {
@@ -20,3 +90,62 @@ std::string_view SFS::ToString(LogSeverity severity) noexcept
     }
     return "";
 }
+
+std::string SFS::FormatLogMessage(const StructuredLogData& data)
+{
+    std::string message;
+    size_t nextField = 0;
+    for (const char* c = data.format; *c != '\0'; ++c)
+    {
+        if (*c != '%')
+        {
+            message.push_back(*c);
+            continue;
+        }
+
+        const char* specStart = c++;
+        if (*c == '%')
+        {
+            message.push_back('%');
+            continue;
+        }
+
+        const char* optionsStart = c;
+        while (*c != '\0' && std::strchr("-+ #0123456789.", *c))
+        {
+            ++c;
+        }
+        const std::string options(optionsStart, c);
+        while (*c != '\0' && std::strchr("hlLjzt", *c))
+        {
+            ++c;
+        }
+        if (*c == '\0')
+        {
+            message.append(specStart);
+            break;
+        }
+
+        if (nextField < data.fieldCount)
+        {
+            AppendValue(message, options, *c, data.fields[nextField++].value);
+        }
+        else
+        {
+            message.append(specStart, c + 1);
+        }
+    }
+    return message;
+}
+
+const LogField* SFS::FindField(const StructuredLogData& data, std::string_view key) noexcept
+{
+    for (size_t i = 0; i < data.fieldCount; ++i)
+    {
+        if (data.fields[i].key == key)
+        {
+            return &data.fields[i];
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,12 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "ProductWatcher.h"
+
+#include "details/ProductWatcherImpl.h"
+
+using namespace SFS;
+
+// Defining the constructor and destructor here allows us to use a unique_ptr to ProductWatcherImpl in the header file
+ProductWatcher::ProductWatcher() noexcept = default;
+ProductWatcher::~ProductWatcher() noexcept = default;
@@ -80,6 +80,8 @@ std::string_view SFS::ToString(Result::Code code) noexcept
         return "OutOfMemory";
     case Result::Unexpected:
         return "Unexpected";
+    case Result::Cancelled:
+        return "Cancelled";
 
     // Connection errors
     case Result::ConnectionSetupFailed:
@@ -4,6 +4,7 @@
 #include "SFSClient.h"
 
 #include "details/ErrorHandling.h"
+#include "details/ProductWatcherImpl.h"
 #include "details/ReportingHandler.h"
 #include "details/SFSClientImpl.h"
 #include "details/connection/CurlConnectionManager.h"
@@ -47,6 +48,54 @@ try
 }
 SFS_CATCH_RETURN()
 
+Result SFSClient::GetLatestAppDownloadInfoDeferred(const RequestParams& requestParams,
+                                                   std::vector<DeferredAppContent>& contents) const noexcept
+try
+{
+    contents = m_impl->GetLatestAppDownloadInfoDeferred(requestParams);
+    return Result::Success;
+}
+SFS_CATCH_RETURN()
+
+Result SFSClient::GetLatestDownloadInfoIfUpdated(const RequestParams& requestParams,
+                                                 const ProductVersions& currentVersions,
+                                                 std::vector<Content>& contents) const noexcept
+try
+{
+    contents = m_impl->GetLatestDownloadInfoIfUpdated(requestParams, currentVersions);
+    return Result::Success;
+}
+SFS_CATCH_RETURN()
+
+Result SFSClient::StreamLatestDownloadInfo(const RequestParams& requestParams,
+                                           const FileCallbackFn& onFile) const noexcept
+try
+{
+    m_impl->StreamLatestDownloadInfo(requestParams, onFile);
+    return Result::Success;
+}
+SFS_CATCH_RETURN()
+
+Result SFSClient::StreamLatestAppDownloadInfo(const RequestParams& requestParams,
+                                              const AppFileCallbackFn& onFile) const noexcept
+try
+{
+    m_impl->StreamLatestAppDownloadInfo(requestParams, onFile);
+    return Result::Success;
+}
+SFS_CATCH_RETURN()
+
+Result SFSClient::Watch(WatchParams params, std::unique_ptr<ProductWatcher>& out) const noexcept
+try
+{
+    out.reset();
+    std::unique_ptr<ProductWatcher> tmp(new ProductWatcher());
+    tmp->m_impl = std::make_unique<details::ProductWatcherImpl>(*m_impl, std::move(params));
+    out = std::move(tmp);
+    return Result::Success;
+}
+SFS_CATCH_RETURN()
+
 const char* SFSClient::GetVersion() noexcept
 {
 #ifdef SFS_GIT_INFO
@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "AsyncLogger.h"
+
+#include <stdio.h>
+
+using namespace SFS;
+using namespace SFS::details;
+
+AsyncLogger::AsyncLogger(size_t queueSize, LogOverflowPolicy overflowPolicy, DeliverFn&& deliver)
+    : m_queue(queueSize)
+    , m_overflowPolicy(overflowPolicy)
+    , m_deliver(std::move(deliver))
+{
+    // One more record for the warning about dropped messages
+    m_batch.resize(c_maxAsyncLogBatchSize + 1);
+    m_batchData.reserve(c_maxAsyncLogBatchSize + 1);
+    m_worker = std::thread([this] { Run(); });
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    {
+        std::lock_guard guard(m_mutex);
+        m_stop = true;
+    }
+    m_wakeUp.notify_one();
+    m_worker.join();
+}
+
+void AsyncLogger::Flush()
+{
+    const size_t queuedCount = m_queuedCount.load(std::memory_order_acquire);
+    m_wakeUp.notify_one();
+
+    std::unique_lock lock(m_mutex);
+    m_delivered.wait(lock, [&] {
+        return m_deliveredCount + m_droppedCount.load(std::memory_order_acquire) >= queuedCount;
+    });
+}
+
+void AsyncLogger::MakeRoom(size_t& takenCount) noexcept
+{
+    if (m_overflowPolicy == LogOverflowPolicy::Block && std::this_thread::get_id() != m_worker.get_id())
+    {
+        std::unique_lock lock(m_mutex);
+        m_wakeUp.notify_one();
+        m_taken.wait(lock, [&] { return m_takenCount.load(std::memory_order_relaxed) != takenCount; });
+        takenCount = m_takenCount.load(std::memory_order_relaxed);
+        return;
+    }
+
+    if (m_queue.TryPop([](const LogRecord&) {}))
+    {
+        m_droppedCount.fetch_add(1, std::memory_order_release);
+    }
+}
+
+void AsyncLogger::Run()
+{
+    while (true)
+    {
+        while (DeliverBatch() > 0)
+        {
+        }
+
+        std::unique_lock lock(m_mutex);
+        if (m_stop)
+        {
+            // Messages queued after the last batch are still delivered
+            lock.unlock();
+            while (DeliverBatch() > 0)
+            {
+            }
+            return;
+        }
+
+        // Producers notify without locking, so a wake up may be missed. The timeout bounds the delay it causes
+        m_wakeUp.wait_for(lock, c_asyncLogDeliveryInterval);
+    }
+}
+
+size_t AsyncLogger::DeliverBatch()
+{
+    size_t count = 0;
+    auto take = [&](const LogRecord& record) { m_batch[count] = record; };
+    while (count < c_maxAsyncLogBatchSize && m_queue.TryPop(take))
+    {
+        ++count;
+    }
+
+    if (count > 0 && m_overflowPolicy == LogOverflowPolicy::Block)
+    {
+        // Lets the messages waiting for room in, before the batch is delivered
+        {
+            std::lock_guard guard(m_mutex);
+            m_takenCount.fetch_add(count, std::memory_order_release);
+        }
+        m_taken.notify_all();
+    }
+
+    size_t recordCount = count;
+    const size_t droppedCount = m_droppedCount.load(std::memory_order_acquire);
+    if (droppedCount > m_reportedDroppedCount)
+    {
+        auto& warning = m_batch[recordCount++];
+        warning.severity = LogSeverity::Warning;
+        snprintf(warning.message,
+                 sizeof(warning.message),
+                 "%zu log messages were dropped because the logging queue was full",
+                 droppedCount - m_reportedDroppedCount);
+        warning.file = __FILE__;
+        warning.line = __LINE__;
+        warning.function = __FUNCTION__;
+        warning.time = std::chrono::system_clock::now();
+        m_reportedDroppedCount = droppedCount;
+    }
+
+    if (recordCount > 0)
+    {
+        m_batchData.clear();
+        for (size_t i = 0; i < recordCount; ++i)
+        {
+            m_batchData.push_back(m_batch[i].ToLogData());
+        }
+        m_deliver(m_batchData);
+    }
+
+    if (count > 0)
+    {
+        {
+            std::lock_guard guard(m_mutex);
+            m_deliveredCount += count;
+        }
+        m_delivered.notify_all();
+    }
+    return count;
+}
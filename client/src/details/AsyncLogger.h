@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "LogQueue.h"
+#include "Logging.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SFS::details
+{
+// Longest time a logged message waits in the queue when nothing wakes up the logging thread earlier
+constexpr std::chrono::milliseconds c_asyncLogDeliveryInterval{10};
+
+// Maximum number of messages passed to the logging callback in one batch
+constexpr size_t c_maxAsyncLogBatchSize = 64;
+
+/**
+ * @brief Queues log messages in a LogQueue and delivers them in batches from a background thread
+ * @details Logging only formats the message into a free slot of the queue, so it never waits for the delivery of
+ * other messages. When the queue is full, the oldest message is dropped or the caller waits for room, depending on the
+ * LogOverflowPolicy. Dropped messages are reported with a warning in a later batch. The delivery callback may log: as
+ * the background thread can't wait for itself to make room, its messages always drop the oldest one when the queue is
+ * full.
+ */
+class AsyncLogger
+{
+  public:
+    using DeliverFn = std::function<void(const std::vector<LogData>&)>;
+
+    /**
+     * @param deliver Called from the background thread with each batch of messages, in the order they were queued
+     */
+    AsyncLogger(size_t queueSize, LogOverflowPolicy overflowPolicy, DeliverFn&& deliver);
+
+    /**
+     * @brief Delivers the messages still queued and stops the background thread
+     */
+    ~AsyncLogger();
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    /**
+     * @brief Queues a message, calling @param format with the buffer and the size of the buffer to write it to
+     */
+    template <typename FormatFn>
+    void Log(LogSeverity severity, const char* file, unsigned line, const char* function, FormatFn&& format) noexcept
+    {
+        const auto time = std::chrono::system_clock::now();
+        auto write = [&](LogRecord& record) {
+            record.severity = severity;
+            format(record.message, sizeof(record.message));
+            record.file = file;
+            record.line = line;
+            record.function = function;
+            record.time = time;
+        };
+
+        // Read before pushing, so a batch taken after a failed push is seen by MakeRoom()
+        size_t takenCount = m_takenCount.load(std::memory_order_acquire);
+        while (!m_queue.TryPush(write))
+        {
+            MakeRoom(takenCount);
+        }
+        m_queuedCount.fetch_add(1, std::memory_order_release);
+        m_wakeUp.notify_one();
+    }
+
+    /**
+     * @brief Waits until the messages queued before this call are delivered or dropped
+     */
+    void Flush();
+
+  private:
+    /**
+     * @brief Drops the oldest message, or waits until the background thread takes a batch after @param takenCount
+     * messages were taken, depending on the LogOverflowPolicy
+     */
+    void MakeRoom(size_t& takenCount) noexcept;
+    void Run();
+
+    /**
+     * @brief Takes up to c_maxAsyncLogBatchSize messages from the queue and delivers them
+     * @return Number of messages taken from the queue
+     */
+    size_t DeliverBatch();
+
+    LogQueue m_queue;
+    const LogOverflowPolicy m_overflowPolicy;
+    DeliverFn m_deliver;
+
+    // Only used by the background thread, kept to avoid allocating for each batch
+    std::vector<LogRecord> m_batch;
+    std::vector<LogData> m_batchData;
+
+    std::atomic<size_t> m_queuedCount{0};
+    std::atomic<size_t> m_droppedCount{0};
+    size_t m_reportedDroppedCount{0};
+
+    // Messages taken from the queue by the background thread. Only changed with m_mutex held, so waiting for it to
+    // change can't miss a notification
+    std::atomic<size_t> m_takenCount{0};
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+    std::condition_variable m_taken;
+    std::condition_variable m_delivered;
+    size_t m_deliveredCount{0};
+    bool m_stop{false};
+
+    std::thread m_worker;
+};
+} // namespace SFS::details
@@ -0,0 +1,68 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "BatchSizer.h"
+
+#include <algorithm>
+
+using namespace SFS::details;
+
+// Weight of the latest batch in the average response size per product
+constexpr double c_bytesPerProductWeight = 0.3;
+
+BatchSizer::BatchSizer(size_t initialSize, size_t maxSize)
+    : m_maxSize(std::max(maxSize, size_t{1}))
+    , m_size(initialSize)
+{
+    ClampSize();
+}
+
+size_t BatchSizer::GetBatchSize() const
+{
+    std::lock_guard guard(m_mutex);
+    return m_size;
+}
+
+void BatchSizer::OnSuccess(size_t productCount, std::chrono::milliseconds latency, size_t responseSize)
+{
+    if (productCount == 0)
+    {
+        return;
+    }
+
+    std::lock_guard guard(m_mutex);
+
+    const double bytesPerProduct = static_cast<double>(responseSize) / static_cast<double>(productCount);
+    m_bytesPerProduct = m_bytesPerProduct == 0 ? bytesPerProduct
+                                               : c_bytesPerProductWeight * bytesPerProduct +
+                                                     (1 - c_bytesPerProductWeight) * m_bytesPerProduct;
+
+    if (latency > c_targetBatchLatency)
+    {
+        m_size = productCount / 2;
+    }
+    else if (latency < c_targetBatchLatency / 2 && productCount >= m_size)
+    {
+        // Only full batches tell whether a bigger one would be answered quickly too
+        m_size += std::max(m_size / 2, size_t{1});
+    }
+
+    ClampSize();
+}
+
+void BatchSizer::OnFailure(size_t productCount)
+{
+    std::lock_guard guard(m_mutex);
+    m_size = std::min(m_size, productCount) / 2;
+    ClampSize();
+}
+
+void BatchSizer::ClampSize()
+{
+    size_t maxSize = m_maxSize;
+    if (m_bytesPerProduct > 0)
+    {
+        maxSize = std::min(maxSize, static_cast<size_t>(c_targetBatchResponseSize / m_bytesPerProduct));
+    }
+    m_size = std::clamp(m_size, size_t{1}, std::max(maxSize, size_t{1}));
+}
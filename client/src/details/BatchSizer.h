@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+namespace SFS::details
+{
+constexpr size_t c_initialBatchSize = 100;
+constexpr size_t c_maxBatchSize = 1000;
+constexpr std::chrono::milliseconds c_targetBatchLatency{2000};
+constexpr size_t c_targetBatchResponseSize = 1024 * 1024;
+
+/**
+ * @brief Picks how many products to send in each batch request, based on the batches already sent
+ * @details The size grows while batches are answered quickly, and shrinks when they are slow or fail, so large product
+ * sets are split in batches the service handles well. It is also capped so the expected response, estimated from the
+ * average response size per product, stays under c_targetBatchResponseSize. Thread-safe.
+ */
+class BatchSizer
+{
+  public:
+    BatchSizer(size_t initialSize = c_initialBatchSize, size_t maxSize = c_maxBatchSize);
+
+    /**
+     * @return The number of products to send in the next batch. At least 1
+     */
+    size_t GetBatchSize() const;
+
+    /**
+     * @brief Records a batch of @param productCount products answered after @param latency with @param responseSize
+     * bytes
+     */
+    void OnSuccess(size_t productCount, std::chrono::milliseconds latency, size_t responseSize);
+
+    /**
+     * @brief Records a batch of @param productCount products that failed
+     */
+    void OnFailure(size_t productCount);
+
+  private:
+    void ClampSize();
+
+    mutable std::mutex m_mutex;
+
+    const size_t m_maxSize;
+    size_t m_size;
+
+    // Moving average of the response bytes per product. 0 until a batch succeeds
+    double m_bytesPerProduct{0};
+};
+} // namespace SFS::details
@@ -8,6 +8,30 @@
 using namespace SFS;
 using namespace SFS::details;
 
+namespace
+{
+template <typename FileT>
+bool HaveSameHashesImpl(const FileT& lhs, const FileT& rhs)
+{
+    const auto lhsSha1 = lhs.GetSha1Digest();
+    const auto lhsSha256 = lhs.GetSha256Digest();
+    const auto rhsSha1 = rhs.GetSha1Digest();
+    const auto rhsSha256 = rhs.GetSha256Digest();
+    if (lhsSha1 != rhsSha1 || lhsSha256 != rhsSha256)
+    {
+        return false;
+    }
+
+    // Every hash type is held as a digest, so there are no other hashes to compare. Otherwise, a hash that is not a
+    // digest can only be compared through GetHashes()
+    if (lhsSha1 && lhsSha256)
+    {
+        return true;
+    }
+    return lhs.GetHashes() == rhs.GetHashes();
+}
+} // namespace
+
 bool contentutil::operator==(const ContentId& lhs, const ContentId& rhs)
 {
     // String characters can be UTF-8 encoded, so we need to compare them in a case-sensitive manner.
@@ -24,7 +48,7 @@ bool contentutil::operator==(const File& lhs, const File& rhs)
 {
     // String characters can be UTF-8 encoded, so we need to compare them in a case-sensitive manner.
     return lhs.GetFileId() == rhs.GetFileId() && lhs.GetUrl() == rhs.GetUrl() &&
-           lhs.GetSizeInBytes() == rhs.GetSizeInBytes() && lhs.GetHashes() == rhs.GetHashes();
+           lhs.GetSizeInBytes() == rhs.GetSizeInBytes() && HaveSameHashes(lhs, rhs);
 }
 
 bool contentutil::operator!=(const File& lhs, const File& rhs)
@@ -48,7 +72,7 @@ bool contentutil::operator==(const AppFile& lhs, const AppFile& rhs)
 {
     // String characters can be UTF-8 encoded, so we need to compare them in a case-sensitive manner.
     return lhs.GetFileId() == rhs.GetFileId() && lhs.GetUrl() == rhs.GetUrl() &&
-           lhs.GetSizeInBytes() == rhs.GetSizeInBytes() && lhs.GetHashes() == rhs.GetHashes() &&
+           lhs.GetSizeInBytes() == rhs.GetSizeInBytes() && HaveSameHashes(lhs, rhs) &&
            lhs.GetApplicabilityDetails() == rhs.GetApplicabilityDetails() &&
            lhs.GetFileMoniker() == rhs.GetFileMoniker();
 }
@@ -60,7 +84,8 @@ bool contentutil::operator!=(const AppFile& lhs, const AppFile& rhs)
 
 bool contentutil::operator==(const Content& lhs, const Content& rhs)
 {
-    return lhs.GetContentId() == rhs.GetContentId() &&
+    // Contents with different fingerprints always differ, so the members are only compared if they match
+    return lhs.GetFingerprint() == rhs.GetFingerprint() && lhs.GetContentId() == rhs.GetContentId() &&
            (std::is_permutation(lhs.GetFiles().begin(),
                                 lhs.GetFiles().end(),
                                 rhs.GetFiles().begin(),
@@ -82,7 +107,8 @@ bool contentutil::operator==(const AppPrerequisiteContent& lhs, const AppPrerequ
                                    rhs.GetFiles().end(),
                                    [](const AppFile& flhs, const AppFile& frhs) { return flhs == frhs; });
     };
-    return lhs.GetContentId() == rhs.GetContentId() && areFilesEqual();
+    return lhs.GetFingerprint() == rhs.GetFingerprint() && lhs.GetContentId() == rhs.GetContentId() &&
+           areFilesEqual();
 }
 
 bool contentutil::operator!=(const AppPrerequisiteContent& lhs, const AppPrerequisiteContent& rhs)
@@ -107,11 +133,21 @@ bool contentutil::operator==(const AppContent& lhs, const AppContent& rhs)
                                    rhs.GetFiles().end(),
                                    [](const AppFile& flhs, const AppFile& frhs) { return flhs == frhs; });
     };
-    return lhs.GetContentId() == rhs.GetContentId() && lhs.GetUpdateId() == rhs.GetUpdateId() &&
-           arePrerequisitesEqual() && areFilesEqual();
+    return lhs.GetFingerprint() == rhs.GetFingerprint() && lhs.GetContentId() == rhs.GetContentId() &&
+           lhs.GetUpdateId() == rhs.GetUpdateId() && arePrerequisitesEqual() && areFilesEqual();
 }
 
 bool contentutil::operator!=(const AppContent& lhs, const AppContent& rhs)
 {
     return !(lhs == rhs);
 }
+
+bool contentutil::HaveSameHashes(const File& lhs, const File& rhs)
+{
+    return HaveSameHashesImpl(lhs, rhs);
+}
+
+bool contentutil::HaveSameHashes(const AppFile& lhs, const AppFile& rhs)
+{
+    return HaveSameHashesImpl(lhs, rhs);
+}
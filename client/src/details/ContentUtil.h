@@ -57,5 +57,16 @@ bool operator==(const AppContent& lhs, const AppContent& rhs);
 
 /// @brief Compares two AppContent objects for inequality. The values of members are strictly compared.
 bool operator!=(const AppContent& lhs, const AppContent& rhs);
+
+//
+// Hash comparison
+//
+
+/// @brief Compares the hashes of two File objects. Digests are compared as they are held, so File::GetHashes() is only
+/// used when a file has a hash that is not a digest.
+bool HaveSameHashes(const File& lhs, const File& rhs);
+
+/// @brief Compares the hashes of two AppFile objects, like for File objects.
+bool HaveSameHashes(const AppFile& lhs, const AppFile& rhs);
 } // namespace contentutil
 } // namespace SFS::details
@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "FileIndex.h"
+
+#include <type_traits>
+
+using namespace SFS;
+using namespace SFS::details;
+
+template <typename FileT>
+FileIndex<FileT>::FileIndex(const std::vector<FileT>& files) : m_files(files)
+{
+}
+
+template <typename FileT>
+void FileIndex<FileT>::BuildOnce() const
+{
+    // If building throws, the next lookup builds again. Entries already added are kept, which is harmless since
+    // emplace() keeps the first file for each key
+    std::call_once(m_built, [&]() {
+        m_byFileId.reserve(m_files.size());
+        for (size_t i = 0; i < m_files.size(); ++i)
+        {
+            const auto& file = m_files[i];
+            m_byFileId.emplace(file.GetFileId(), i);
+
+            if constexpr (std::is_same_v<FileT, AppFile>)
+            {
+                m_byFileMoniker.emplace(file.GetFileMoniker(), i);
+
+                // A file with no architecture listed is architecture-neutral, like for ApplicabilityFilter
+                const auto& details = file.GetApplicabilityDetails();
+                const bool neutral = details.GetArchitectures().empty();
+                for (size_t arch = 0; arch < m_byArchitecture.size(); ++arch)
+                {
+                    const auto architecture = static_cast<Architecture>(arch);
+                    if (!m_byArchitecture[arch] &&
+                        (details.HasArchitecture(architecture) || (neutral && architecture == Architecture::None)))
+                    {
+                        m_byArchitecture[arch] = i;
+                    }
+                }
+            }
+        }
+    });
+}
+
+template <typename FileT>
+const FileT* FileIndex<FileT>::FindByFileId(std::string_view fileId) const
+{
+    BuildOnce();
+    const auto it = m_byFileId.find(fileId);
+    return it == m_byFileId.end() ? nullptr : &m_files[it->second];
+}
+
+template <typename FileT>
+const FileT* FileIndex<FileT>::FindByFileMoniker(std::string_view fileMoniker) const
+{
+    BuildOnce();
+    const auto it = m_byFileMoniker.find(fileMoniker);
+    return it == m_byFileMoniker.end() ? nullptr : &m_files[it->second];
+}
+
+template <typename FileT>
+const FileT* FileIndex<FileT>::FindApplicable(Architecture architecture) const
+{
+    BuildOnce();
+    for (const auto arch : {architecture, Architecture::None})
+    {
+        const auto index = static_cast<size_t>(arch);
+        if (index < m_byArchitecture.size() && m_byArchitecture[index])
+        {
+            return &m_files[*m_byArchitecture[index]];
+        }
+    }
+    return nullptr;
+}
+
+template class SFS::details::FileIndex<File>;
+template class SFS::details::FileIndex<AppFile>;
@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "AppFile.h"
+#include "ApplicabilityDetails.h"
+#include "File.h"
+
+#include <array>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace SFS::details
+{
+/**
+ * @brief Lookup tables over the files of a content, built on the first lookup
+ * @details Keys point into @param files, which must outlive the index and must not change after it is created.
+ * Lookups are thread-safe. When several files share a key, the first one in the list is returned.
+ */
+template <typename FileT>
+class FileIndex
+{
+  public:
+    explicit FileIndex(const std::vector<FileT>& files);
+
+    FileIndex(const FileIndex&) = delete;
+    FileIndex& operator=(const FileIndex&) = delete;
+
+    /**
+     * @return The file with the given @param fileId, or nullptr if there is none
+     */
+    const FileT* FindByFileId(std::string_view fileId) const;
+
+    /**
+     * @return The file with the given @param fileMoniker, or nullptr if there is none
+     * @note Only available for AppFile
+     */
+    const FileT* FindByFileMoniker(std::string_view fileMoniker) const;
+
+    /**
+     * @return The file that best applies to @param architecture, or nullptr if there is none
+     * @details A file built for @param architecture is preferred over an architecture-neutral one
+     * (Architecture::None, or no architecture listed)
+     * @note Only available for AppFile
+     */
+    const FileT* FindApplicable(Architecture architecture) const;
+
+  private:
+    void BuildOnce() const;
+
+    const std::vector<FileT>& m_files;
+
+    mutable std::once_flag m_built;
+    mutable std::unordered_map<std::string_view, size_t> m_byFileId;
+    mutable std::unordered_map<std::string_view, size_t> m_byFileMoniker;
+
+    // First file for each Architecture value
+    mutable std::array<std::optional<size_t>, static_cast<size_t>(Architecture::x86) + 1> m_byArchitecture;
+};
+} // namespace SFS::details
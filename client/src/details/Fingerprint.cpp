@@ -0,0 +1,179 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "Fingerprint.h"
+
+#include <map>
+
+using namespace SFS;
+using namespace SFS::details;
+
+namespace
+{
+// Primes from xxHash64
+constexpr uint64_t c_prime1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t c_prime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t c_prime3 = 0x165667B19E3779F9ull;
+constexpr uint64_t c_prime4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t c_prime5 = 0x27D4EB2F165667C5ull;
+
+uint64_t RotateLeft(uint64_t value, unsigned bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t Round(uint64_t acc, uint64_t input)
+{
+    acc += input * c_prime2;
+    acc = RotateLeft(acc, 31);
+    return acc * c_prime1;
+}
+
+uint64_t Avalanche(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= c_prime2;
+    value ^= value >> 29;
+    value *= c_prime3;
+    value ^= value >> 32;
+    return value;
+}
+} // namespace
+
+FingerprintBuilder& FingerprintBuilder::Add(std::string_view value)
+{
+    AddWord(value.size());
+
+    // Words are assembled byte by byte so the result doesn't depend on the endianness of the platform
+    uint64_t word = 0;
+    unsigned shift = 0;
+    for (const char c : value)
+    {
+        word |= static_cast<uint64_t>(static_cast<unsigned char>(c)) << shift;
+        shift += 8;
+        if (shift == 64)
+        {
+            AddWord(word);
+            word = 0;
+            shift = 0;
+        }
+    }
+    if (shift != 0)
+    {
+        AddWord(word);
+    }
+    return *this;
+}
+
+FingerprintBuilder& FingerprintBuilder::Add(uint64_t value)
+{
+    AddWord(value);
+    return *this;
+}
+
+FingerprintBuilder& FingerprintBuilder::Add(const ContentFingerprint& value)
+{
+    AddWord(value.high);
+    AddWord(value.low);
+    return *this;
+}
+
+void FingerprintBuilder::AddWord(uint64_t word)
+{
+    m_lane1 = RotateLeft(m_lane1 ^ Round(0, word), 27) * c_prime1 + c_prime4;
+    m_lane2 = RotateLeft(m_lane2 ^ Round(c_prime5, word ^ c_prime3), 29) * c_prime2 + c_prime5;
+    ++m_length;
+}
+
+ContentFingerprint FingerprintBuilder::Finish() const
+{
+    const uint64_t lane1 = m_lane1 + m_length * c_prime5;
+    const uint64_t lane2 = m_lane2 + m_length * c_prime4;
+    return ContentFingerprint{Avalanche(lane1), Avalanche(lane2 ^ RotateLeft(lane1, 17))};
+}
+
+ContentFingerprint FingerprintBuilder::Of(const ContentId& contentId)
+{
+    return FingerprintBuilder()
+        .Add(contentId.GetNameSpace())
+        .Add(contentId.GetName())
+        .Add(contentId.GetVersion())
+        .Finish();
+}
+
+void FingerprintBuilder::AddHashes(const File& file)
+{
+    // Each slot is tagged so a missing digest is distinguished from any digest value
+    Add(static_cast<uint64_t>(file.m_hashSlots));
+    if (file.m_hashSlots & File::Sha1Slot)
+    {
+        Add(std::string_view(reinterpret_cast<const char*>(file.m_sha1.data()), file.m_sha1.size()));
+    }
+    if (file.m_hashSlots & File::Sha256Slot)
+    {
+        Add(std::string_view(reinterpret_cast<const char*>(file.m_sha256.data()), file.m_sha256.size()));
+    }
+
+    // Hashes that are not digests are added as given, sorted as the map is unordered
+    std::map<HashType, std::string_view> otherHashes;
+    if (file.m_otherHashes)
+    {
+        otherHashes.insert(file.m_otherHashes->begin(), file.m_otherHashes->end());
+    }
+    Add(static_cast<uint64_t>(otherHashes.size()));
+    for (const auto& [type, value] : otherHashes)
+    {
+        Add(static_cast<uint64_t>(type)).Add(value);
+    }
+}
+
+ContentFingerprint FingerprintBuilder::Of(const File& file)
+{
+    FingerprintBuilder builder;
+    builder.Add(file.GetFileId()).Add(file.GetUrl()).Add(file.GetSizeInBytes());
+    builder.AddHashes(file);
+    return builder.Finish();
+}
+
+ContentFingerprint FingerprintBuilder::Of(const AppFile& file)
+{
+    const auto& details = file.GetApplicabilityDetails();
+
+    FingerprintBuilder builder;
+    builder.Add(Of(static_cast<const File&>(file)));
+
+    // Architectures are held as a set, so the list is ordered and has no duplicates
+    const auto& architectures = details.GetArchitectures();
+    builder.Add(static_cast<uint64_t>(architectures.size()));
+    for (const auto architecture : architectures)
+    {
+        builder.Add(static_cast<uint64_t>(architecture));
+    }
+
+    const auto& platforms = details.GetPlatformApplicabilityForPackage();
+    builder.Add(static_cast<uint64_t>(platforms.size()));
+    for (const auto& platform : platforms)
+    {
+        builder.Add(platform);
+    }
+
+    return builder.Add(file.GetFileMoniker()).Finish();
+}
+
+template <typename FileT>
+ContentFingerprint FingerprintBuilder::OfUnordered(const std::vector<FileT>& files)
+{
+    // Addition is commutative, so the sum of the file fingerprints doesn't depend on their order, while duplicated
+    // files still count once each
+    ContentFingerprint sum{0, 0};
+    for (const auto& file : files)
+    {
+        const auto fingerprint = Of(file);
+        sum.high += fingerprint.high;
+        sum.low += fingerprint.low;
+    }
+    return FingerprintBuilder().Add(static_cast<uint64_t>(files.size())).Add(sum).Finish();
+}
+
+template ContentFingerprint FingerprintBuilder::OfUnordered(const std::vector<File>& files);
+template ContentFingerprint FingerprintBuilder::OfUnordered(const std::vector<AppFile>& files);
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "AppContent.h"
+#include "Content.h"
+
+#include <cstdint>
+#include <string_view>
+
+namespace SFS::details
+{
+/**
+ * @brief Computes ContentFingerprint values
+ * @details The hash is non-cryptographic, and only depends on the values added, so it is stable across processes and
+ * platforms. Values are added in order. Strings are length-prefixed, so different sequences of strings don't collide
+ * by concatenation.
+ */
+class FingerprintBuilder
+{
+  public:
+    FingerprintBuilder& Add(std::string_view value);
+    FingerprintBuilder& Add(uint64_t value);
+    FingerprintBuilder& Add(const ContentFingerprint& value);
+
+    ContentFingerprint Finish() const;
+
+    //
+    // Fingerprints of the values compared by the contentutil equality operators
+    //
+
+    static ContentFingerprint Of(const ContentId& contentId);
+    static ContentFingerprint Of(const File& file);
+    static ContentFingerprint Of(const AppFile& file);
+
+    /**
+     * @return A fingerprint of @param files that doesn't depend on their order, as files are compared as a set
+     */
+    template <typename FileT>
+    static ContentFingerprint OfUnordered(const std::vector<FileT>& files);
+
+  private:
+    void AddWord(uint64_t word);
+    void AddHashes(const File& file);
+
+    uint64_t m_lane1{0x9E3779B97F4A7C15ull};
+    uint64_t m_lane2{0xC2B2AE3D27D4EB4Full};
+    uint64_t m_length{0};
+};
+} // namespace SFS::details
@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "RequestAllocator.h"
+
+#include <nlohmann/json_fwd.hpp>
+
+namespace SFS::details
+{
+/**
+ * @brief JSON type used to parse service responses
+ * @details Same as nlohmann::json, except its objects and arrays are allocated from the memory resource of the request
+ * being parsed. Strings keep the default allocator. See ScopedRequestMemoryResource.
+ */
+using json = nlohmann::basic_json<std::map,
+                                  std::vector,
+                                  std::string,
+                                  bool,
+                                  std::int64_t,
+                                  std::uint64_t,
+                                  double,
+                                  RequestAllocator>;
+} // namespace SFS::details
@@ -0,0 +1,194 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "JsonStreamParser.h"
+
+#include "ErrorHandling.h"
+#include "ReportingHandler.h"
+
+#include <nlohmann/json.hpp>
+
+#include <vector>
+
+using namespace SFS;
+using namespace SFS::details;
+
+namespace
+{
+// SAX handler that expects a top-level array of objects and rebuilds each object in turn.
+// Returning false from a SAX method stops parsing, but all errors are reported by throwing instead, so every method
+// returns true.
+class ObjectArraySaxHandler : public json::json_sax_t
+{
+  public:
+    ObjectArraySaxHandler(const JsonElementHandler& onElement,
+                          const std::string& method,
+                          const ReportingHandler& handler)
+        : m_onElement(onElement)
+        , m_method(method)
+        , m_handler(handler)
+    {
+    }
+
+    bool null() override
+    {
+        return AddValue(nullptr);
+    }
+
+    bool boolean(bool val) override
+    {
+        return AddValue(val);
+    }
+
+    bool number_integer(number_integer_t val) override
+    {
+        return AddValue(val);
+    }
+
+    bool number_unsigned(number_unsigned_t val) override
+    {
+        return AddValue(val);
+    }
+
+    bool number_float(number_float_t val, const string_t&) override
+    {
+        return AddValue(val);
+    }
+
+    bool string(string_t& val) override
+    {
+        return AddValue(std::move(val));
+    }
+
+    bool binary(binary_t& val) override
+    {
+        return AddValue(json::binary(std::move(val)));
+    }
+
+    bool start_object(std::size_t) override
+    {
+        if (m_stack.empty())
+        {
+            // Anything after the top-level array is reported by the parser itself as a parsing error
+            ValidateArrayStarted();
+            m_element = json::object();
+            m_stack.push_back(&m_element);
+            return true;
+        }
+
+        m_stack.push_back(AddChild(json::object()));
+        return true;
+    }
+
+    bool key(string_t& val) override
+    {
+        m_key = std::move(val);
+        return true;
+    }
+
+    bool end_object() override
+    {
+        return EndContainer();
+    }
+
+    bool start_array(std::size_t) override
+    {
+        if (m_stack.empty())
+        {
+            // The top-level array
+            if (!m_arrayStarted)
+            {
+                m_arrayStarted = true;
+                return true;
+            }
+            ThrowArrayElementNotObject();
+            return false;
+        }
+
+        m_stack.push_back(AddChild(json::array()));
+        return true;
+    }
+
+    bool end_array() override
+    {
+        // The top-level array doesn't need any handling when it ends
+        return m_stack.empty() ? true : EndContainer();
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override
+    {
+        THROW_LOG(Result(Result::ServiceInvalidResponse, "(" + m_method + ") JSON Parsing error: " + ex.what()),
+                  m_handler);
+        return false;
+    }
+
+  private:
+    void ValidateArrayStarted()
+    {
+        THROW_CODE_IF_NOT_LOG(ServiceInvalidResponse, m_arrayStarted, m_handler, "Response is not a JSON array");
+    }
+
+    void ThrowArrayElementNotObject()
+    {
+        THROW_LOG(Result(Result::ServiceInvalidResponse, "Array element is not a JSON object"), m_handler);
+    }
+
+    bool AddValue(json&& value)
+    {
+        if (m_stack.empty())
+        {
+            ValidateArrayStarted();
+            ThrowArrayElementNotObject();
+            return false;
+        }
+
+        AddChild(std::move(value));
+        return true;
+    }
+
+    json* AddChild(json&& value)
+    {
+        json& parent = *m_stack.back();
+        if (parent.is_array())
+        {
+            parent.push_back(std::move(value));
+            return &parent.back();
+        }
+
+        json& child = parent[m_key];
+        child = std::move(value);
+        return &child;
+    }
+
+    bool EndContainer()
+    {
+        m_stack.pop_back();
+        if (m_stack.empty())
+        {
+            m_onElement(std::move(m_element));
+            m_element = json();
+        }
+        return true;
+    }
+
+    const JsonElementHandler& m_onElement;
+    const std::string& m_method;
+    const ReportingHandler& m_handler;
+
+    bool m_arrayStarted{false};
+
+    // Element being built, and the path to the container currently being filled within it
+    json m_element;
+    std::vector<json*> m_stack;
+    std::string m_key;
+};
+} // namespace
+
+void SFS::details::ParseJsonObjectArray(std::istream& stream,
+                                        const JsonElementHandler& onElement,
+                                        const std::string& method,
+                                        const ReportingHandler& handler)
+{
+    ObjectArraySaxHandler saxHandler(onElement, method, handler);
+    json::sax_parse(stream, &saxHandler);
+}
@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "Json.h"
+
+#include <functional>
+#include <istream>
+#include <string>
+
+namespace SFS::details
+{
+class ReportingHandler;
+
+using JsonElementHandler = std::function<void(json&& element)>;
+
+/**
+ * @brief Parses a JSON array of objects from @param stream, calling @param onElement with each object as soon as it is
+ * fully read
+ * @details Only the object being read is kept in memory, so the size of the array doesn't matter. Validation messages
+ * match the ones used when parsing a whole response: the response must be an array, and its elements must be objects.
+ * @param method Name of the service method that returned the response, used in parsing error messages
+ * @throws SFSException with ServiceInvalidResponse if the response is not valid JSON or doesn't have the expected format
+ */
+void ParseJsonObjectArray(std::istream& stream,
+                          const JsonElementHandler& onElement,
+                          const std::string& method,
+                          const ReportingHandler& handler);
+} // namespace SFS::details
@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "LogQueue.h"
+
+using namespace SFS::details;
+
+namespace
+{
+size_t RoundUpToPowerOf2(size_t value)
+{
+    size_t result = 1;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+} // namespace
+
+LogQueue::LogQueue(size_t capacity)
+    : m_mask(RoundUpToPowerOf2(capacity) - 1)
+    , m_slots(std::make_unique<Slot[]>(m_mask + 1))
+{
+    for (size_t i = 0; i <= m_mask; ++i)
+    {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+size_t LogQueue::Capacity() const noexcept
+{
+    return m_mask + 1;
+}
@@ -0,0 +1,142 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "Logging.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+#define MAX_LOG_MESSAGE_SIZE 1024
+
+namespace SFS::details
+{
+/**
+ * @brief A log message with its own storage, so it can outlive the call that logged it
+ * @details file and function point to string literals, which don't need to be copied.
+ */
+struct LogRecord
+{
+    LogSeverity severity;
+    char message[MAX_LOG_MESSAGE_SIZE];
+    const char* file;
+    unsigned line;
+    const char* function;
+    std::chrono::time_point<std::chrono::system_clock> time;
+
+    LogData ToLogData() const
+    {
+        return {severity, message, file, line, function, time};
+    }
+};
+
+/**
+ * @brief Bounded lock-free queue of log records
+ * @details Each slot has a sequence number that tells whether it is free to be written or ready to be read in the
+ * current lap around the ring, so threads claim slots with a compare-exchange on the push or pop position and never
+ * wait for each other. Any number of threads can push and pop at the same time, which lets producers drop the oldest
+ * record to make room.
+ */
+class LogQueue
+{
+  public:
+    /**
+     * @param capacity Minimum number of records the queue can hold. Rounded up to a power of 2
+     */
+    explicit LogQueue(size_t capacity);
+
+    LogQueue(const LogQueue&) = delete;
+    LogQueue& operator=(const LogQueue&) = delete;
+
+    size_t Capacity() const noexcept;
+
+    /**
+     * @brief Claims a free slot and calls @param write with its record to fill it in
+     * @return false if the queue is full, in which case @param write is not called
+     */
+    template <typename WriteFn>
+    bool TryPush(WriteFn&& write) noexcept
+    {
+        size_t position = m_pushPosition.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true)
+        {
+            slot = &m_slots[position & m_mask];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            if (sequence == position)
+            {
+                if (m_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (sequence < position)
+            {
+                // The slot still holds the record pushed a lap ago
+                return false;
+            }
+            else
+            {
+                position = m_pushPosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        write(slot->record);
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Claims the oldest record and calls @param read with it, then frees its slot
+     * @return false if the queue is empty, in which case @param read is not called
+     */
+    template <typename ReadFn>
+    bool TryPop(ReadFn&& read) noexcept
+    {
+        size_t position = m_popPosition.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true)
+        {
+            slot = &m_slots[position & m_mask];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            if (sequence == position + 1)
+            {
+                if (m_popPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (sequence < position + 1)
+            {
+                // The slot hasn't been written in this lap yet
+                return false;
+            }
+            else
+            {
+                position = m_popPosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        read(slot->record);
+        slot->sequence.store(position + m_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+  private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    const size_t m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+
+    // Kept on separate cache lines, as they are written by different threads
+    alignas(64) std::atomic<size_t> m_pushPosition{0};
+    alignas(64) std::atomic<size_t> m_popPosition{0};
+};
+} // namespace SFS::details
@@ -3,6 +3,10 @@
 
 #include "OSInfo.h"
 
+#include "Util.h"
+
+#include <initializer_list>
+
 #ifdef _WIN32
 
 #include <windows.h>
@@ -13,8 +17,11 @@
 
 #include <sys/utsname.h>
 
+#include <unistd.h>
+
 #endif
 
+using namespace SFS;
 using namespace SFS::details;
 
 namespace
@@ -45,6 +52,17 @@ std::string GetOSMachineInfo()
     }
 }
 
+std::string GetMachineName()
+{
+    char name[MAX_COMPUTERNAME_LENGTH + 1];
+    DWORD size = sizeof(name);
+    if (GetComputerNameA(name, &size))
+    {
+        return std::string(name, size);
+    }
+    return {};
+}
+
 #elif __linux__
 
 std::string GetPlatform()
@@ -68,6 +86,17 @@ std::string GetOSMachineInfo()
     return "Unknown";
 }
 
+std::string GetMachineName()
+{
+    char name[256];
+    if (gethostname(name, sizeof(name)) == 0)
+    {
+        name[sizeof(name) - 1] = '\0';
+        return name;
+    }
+    return {};
+}
+
 #else
 #error "Unsupported platform"
 #endif
@@ -82,3 +111,46 @@ std::string osinfo::GetOSMachineInfo()
 {
     return ::GetOSMachineInfo();
 }
+
+std::string osinfo::GetMachineName()
+{
+    return ::GetMachineName();
+}
+
+Architecture osinfo::ArchitectureFromMachineInfo(std::string_view machineInfo)
+{
+    const auto isAnyOf = [&](std::initializer_list<std::string_view> names) {
+        for (const auto& name : names)
+        {
+            if (util::AreEqualI(machineInfo, name))
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    if (isAnyOf({"x64", "amd64", "x86_64"}))
+    {
+        return Architecture::Amd64;
+    }
+    else if (isAnyOf({"arm64", "aarch64"}))
+    {
+        return Architecture::Arm64;
+    }
+    else if (isAnyOf({"x86", "i386", "i486", "i586", "i686"}))
+    {
+        return Architecture::x86;
+    }
+    else if (isAnyOf({"arm", "armv7l", "armv7", "armv6l"}))
+    {
+        return Architecture::Arm;
+    }
+    return Architecture::None;
+}
+
+Architecture osinfo::GetOSArchitecture()
+{
+    static const Architecture architecture = ArchitectureFromMachineInfo(GetOSMachineInfo());
+    return architecture;
+}
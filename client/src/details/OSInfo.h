@@ -3,10 +3,31 @@
 
 #pragma once
 
+#include "ApplicabilityDetails.h"
+
 #include <string>
+#include <string_view>
 
 namespace SFS::details::osinfo
 {
 std::string GetPlatform();
 std::string GetOSMachineInfo();
+
+/**
+ * @return The network name of this machine, or an empty string if it can't be retrieved
+ */
+std::string GetMachineName();
+
+/**
+ * @brief Maps a machine name like the ones returned by GetOSMachineInfo() ("x64", "x86_64", "aarch64", ...) to an
+ * Architecture
+ * @return Architecture::None if the machine is not recognized
+ */
+Architecture ArchitectureFromMachineInfo(std::string_view machineInfo);
+
+/**
+ * @return The Architecture of this machine, or Architecture::None if it is not recognized
+ * @note The value is detected on the first call and cached
+ */
+Architecture GetOSArchitecture();
 } // namespace SFS::details::osinfo
@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "ProductWatcherImpl.h"
+
+#include "ErrorHandling.h"
+#include "OSInfo.h"
+#include "ReportingHandler.h"
+#include "SFSClientInterface.h"
+
+#include <unordered_set>
+
+using namespace SFS;
+using namespace SFS::details;
+
+namespace
+{
+void ValidateWatchParams(const WatchParams& params, const ReportingHandler& handler)
+{
+    THROW_CODE_IF_LOG(InvalidArg, params.products.empty(), handler, "products cannot be empty");
+    THROW_CODE_IF_LOG(InvalidArg, !params.onChange, handler, "onChange must not be empty");
+
+    std::unordered_set<std::string_view> products;
+    for (const auto& product : params.products)
+    {
+        THROW_CODE_IF_LOG(InvalidArg, product.request.product.empty(), handler, "product must not be empty");
+        THROW_CODE_IF_LOG(InvalidArg,
+                          product.pollInterval.count() <= 0,
+                          handler,
+                          "pollInterval must be greater than 0");
+        THROW_CODE_IF_LOG(InvalidArg,
+                          !products.insert(product.request.product).second,
+                          handler,
+                          "product [" + product.request.product + "] is watched more than once");
+    }
+}
+
+std::vector<std::chrono::milliseconds> GetIntervals(const WatchParams& params)
+{
+    std::vector<std::chrono::milliseconds> intervals;
+    intervals.reserve(params.products.size());
+    for (const auto& product : params.products)
+    {
+        intervals.push_back(product.pollInterval);
+    }
+    return intervals;
+}
+
+std::string GetDeviceId(const WatchParams& params)
+{
+    return params.deviceId ? *params.deviceId : osinfo::GetMachineName();
+}
+
+ProductVersions GetInitialVersions(const WatchParams& params)
+{
+    ProductVersions versions;
+    for (const auto& product : params.products)
+    {
+        if (product.currentVersion)
+        {
+            versions.emplace(product.request.product, *product.currentVersion);
+        }
+    }
+    return versions;
+}
+
+Result GetUpdatedContents(const SFSClientInterface& client,
+                          const RequestParams& requestParams,
+                          const ProductVersions& versions,
+                          std::vector<Content>& contents) noexcept
+try
+{
+    contents = client.GetLatestDownloadInfoIfUpdated(requestParams, versions);
+    return Result::Success;
+}
+SFS_CATCH_RETURN()
+} // namespace
+
+ProductWatcherImpl::ProductWatcherImpl(const SFSClientInterface& client, WatchParams&& params)
+    : m_client(client)
+    , m_params((ValidateWatchParams(params, client.GetReportingHandler()), std::move(params)))
+    , m_versions(GetInitialVersions(m_params))
+    , m_schedule(GetIntervals(m_params), GetDeviceId(m_params), WatchSchedule::Clock::now(), m_params.batchWindow)
+{
+    LOG_INFO(m_client.GetReportingHandler(), "Watching %zu products", m_params.products.size());
+    m_worker = std::thread(&ProductWatcherImpl::Run, this);
+}
+
+ProductWatcherImpl::~ProductWatcherImpl()
+{
+    {
+        std::lock_guard guard(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_worker.joinable())
+    {
+        m_worker.join();
+    }
+}
+
+void ProductWatcherImpl::Run()
+{
+    std::unique_lock lock(m_mutex);
+    while (!m_stop)
+    {
+        if (m_cv.wait_until(lock, m_schedule.NextDue(), [&] { return m_stop; }))
+        {
+            break;
+        }
+
+        const auto indexes = m_schedule.TakeDue(WatchSchedule::Clock::now());
+        if (indexes.empty())
+        {
+            continue;
+        }
+
+        // Destruction waits on the mutex, so it is released while the poll and its callbacks run
+        lock.unlock();
+        Poll(indexes);
+        lock.lock();
+    }
+}
+
+void ProductWatcherImpl::Poll(const std::vector<size_t>& indexes)
+{
+    const auto& handler = m_client.GetReportingHandler();
+
+    RequestParams requestParams = m_params.requestParams;
+    requestParams.productRequests.clear();
+    requestParams.productRequests.reserve(indexes.size());
+    for (const size_t index : indexes)
+    {
+        requestParams.productRequests.push_back(m_params.products[index].request);
+    }
+
+    LOG_INFO(handler, "Polling %zu watched products", indexes.size());
+
+    std::vector<Content> contents;
+    if (const Result result = GetUpdatedContents(m_client, requestParams, m_versions, contents); result.IsFailure())
+    {
+        LOG_WARNING(handler, "Poll of %zu watched products failed", indexes.size());
+        ReportError(result);
+        return;
+    }
+
+    for (auto& content : contents)
+    {
+        m_versions[content.GetContentId().GetName()] = content.GetContentId().GetVersion();
+
+        try
+        {
+            m_params.onChange(std::move(content));
+        }
+        catch (...)
+        {
+            LOG_ERROR(handler, "onChange threw an exception, it is not called again for this version");
+        }
+    }
+}
+
+void ProductWatcherImpl::ReportError(const Result& result) const
+{
+    if (!m_params.onError)
+    {
+        return;
+    }
+
+    try
+    {
+        m_params.onError(result);
+    }
+    catch (...)
+    {
+        LOG_ERROR(m_client.GetReportingHandler(), "onError threw an exception");
+    }
+}
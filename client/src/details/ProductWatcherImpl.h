@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "ProductWatcher.h"
+#include "RequestParams.h"
+#include "WatchSchedule.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SFS::details
+{
+class SFSClientInterface;
+
+/**
+ * @brief Runs the polls of a ProductWatcher on a worker thread
+ * @details The worker thread is started on construction and stopped when this object is destroyed. @param client must
+ * outlive this object
+ */
+class ProductWatcherImpl
+{
+  public:
+    /**
+     * @throws SFSException if @param params is invalid
+     */
+    ProductWatcherImpl(const SFSClientInterface& client, WatchParams&& params);
+    ~ProductWatcherImpl();
+
+    ProductWatcherImpl(const ProductWatcherImpl&) = delete;
+    ProductWatcherImpl& operator=(const ProductWatcherImpl&) = delete;
+
+  private:
+    void Run();
+
+    /**
+     * @brief Polls the products at @param indexes in a single request, and reports the ones that changed
+     */
+    void Poll(const std::vector<size_t>& indexes);
+
+    void ReportError(const Result& result) const;
+
+    const SFSClientInterface& m_client;
+    WatchParams m_params;
+
+    // Last version seen of each product. Only accessed from the worker thread
+    ProductVersions m_versions;
+
+    WatchSchedule m_schedule;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stop{false};
+
+    std::thread m_worker;
+};
+} // namespace SFS::details
@@ -12,6 +12,34 @@ void ReportingHandler::SetLoggingCallback(LoggingCallbackFn&& callback)
 {
     std::lock_guard guard(m_loggingCallbackFnMutex);
     m_loggingCallbackFn = std::move(callback);
+    m_hasLoggingCallback = static_cast<bool>(m_loggingCallbackFn);
+}
+
+void ReportingHandler::SetStructuredLoggingCallback(StructuredLoggingCallbackFn&& callback)
+{
+    std::unique_lock lock(m_structuredLoggingCallbackFnMutex);
+    m_structuredLoggingCallbackFn = std::move(callback);
+    m_hasStructuredLoggingCallback = static_cast<bool>(m_structuredLoggingCallbackFn);
+}
+
+void ReportingHandler::SetMinSeverity(LogSeverity minSeverity)
+{
+    m_minSeverity = minSeverity;
+}
+
+void ReportingHandler::StartAsyncLogging(const AsyncLoggingConfig& config)
+{
+    m_asyncLogger = std::make_unique<AsyncLogger>(config.queueSize,
+                                                  config.overflowPolicy,
+                                                  [this](const std::vector<LogData>& batch) { DeliverBatch(batch); });
+}
+
+void ReportingHandler::Flush() const
+{
+    if (m_asyncLogger)
+    {
+        m_asyncLogger->Flush();
+    }
 }
 
 void ReportingHandler::CallLoggingCallback(LogSeverity severity,
@@ -26,3 +54,41 @@ void ReportingHandler::CallLoggingCallback(LogSeverity severity,
         m_loggingCallbackFn({severity, message, file, line, function, std::chrono::system_clock::now()});
     }
 }
+
+void ReportingHandler::CallStructuredLoggingCallback(LogSeverity severity,
+                                                     const char* format,
+                                                     const LogField* fields,
+                                                     size_t fieldCount,
+                                                     const char* file,
+                                                     unsigned line,
+                                                     const char* function) const
+{
+    std::shared_lock lock(m_structuredLoggingCallbackFnMutex);
+    if (m_structuredLoggingCallbackFn)
+    {
+        m_structuredLoggingCallbackFn(
+            {severity, format, fields, fieldCount, file, line, function, std::chrono::system_clock::now()});
+    }
+}
+
+void ReportingHandler::DeliverBatch(const std::vector<LogData>& batch) const
+{
+    // Held for the whole batch, so SetLoggingCallback() waits for the batch being delivered with the previous callback
+    std::lock_guard guard(m_loggingCallbackFnMutex);
+    if (!m_loggingCallbackFn)
+    {
+        return;
+    }
+
+    for (const auto& data : batch)
+    {
+        try
+        {
+            m_loggingCallbackFn(data);
+        }
+        catch (...)
+        {
+            // There is no caller to report the failure to from the logging thread
+        }
+    }
+}
@@ -3,28 +3,155 @@
 
 #pragma once
 
+#include "AsyncLogger.h"
 #include "Logging.h"
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <stdio.h>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
-#define MAX_LOG_MESSAGE_SIZE 1024
+// Least severe messages compiled in, set through the CMake option of the same name. Less severe log statements are
+// discarded at compile time, along with their format strings and arguments
+#ifndef SFS_MIN_LOG_SEVERITY
+#define SFS_MIN_LOG_SEVERITY Verbose
+#endif
 
-#define LOG_INFO(handler, format, ...)                                                                                 \
-    handler.LogWithSeverity(SFS::LogSeverity::Info, __FILE__, __LINE__, __FUNCTION__, format, ##__VA_ARGS__)
+// The arguments are only evaluated, and the message only formatted, if the handler would log it
+#define SFS_LOG_WITH_SEVERITY(handler, severity, format, ...)                                                          \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if constexpr (SFS::details::IsAtLeast(severity, SFS::LogSeverity::SFS_MIN_LOG_SEVERITY))                       \
+        {                                                                                                              \
+            if ((handler).IsEnabled(severity))                                                                         \
+            {                                                                                                          \
+                (handler).LogWithSeverity(severity, __FILE__, __LINE__, __FUNCTION__, format, ##__VA_ARGS__);          \
+            }                                                                                                          \
+        }                                                                                                              \
+    } while (0)
+
+#define LOG_INFO(handler, format, ...) SFS_LOG_WITH_SEVERITY(handler, SFS::LogSeverity::Info, format, ##__VA_ARGS__)
 #define LOG_WARNING(handler, format, ...)                                                                              \
-    handler.LogWithSeverity(SFS::LogSeverity::Warning, __FILE__, __LINE__, __FUNCTION__, format, ##__VA_ARGS__)
-#define LOG_ERROR(handler, format, ...)                                                                                \
-    handler.LogWithSeverity(SFS::LogSeverity::Error, __FILE__, __LINE__, __FUNCTION__, format, ##__VA_ARGS__)
+    SFS_LOG_WITH_SEVERITY(handler, SFS::LogSeverity::Warning, format, ##__VA_ARGS__)
+#define LOG_ERROR(handler, format, ...) SFS_LOG_WITH_SEVERITY(handler, SFS::LogSeverity::Error, format, ##__VA_ARGS__)
 #define LOG_VERBOSE(handler, format, ...)                                                                              \
-    handler.LogWithSeverity(SFS::LogSeverity::Verbose, __FILE__, __LINE__, __FUNCTION__, format, ##__VA_ARGS__)
+    SFS_LOG_WITH_SEVERITY(handler, SFS::LogSeverity::Verbose, format, ##__VA_ARGS__)
 
 namespace SFS::details
 {
+/**
+ * @return Whether @param severity is at least as severe as @param minSeverity. From least to most severe, severities
+ * are Verbose, Info, Warning and Error
+ */
+constexpr bool IsAtLeast(LogSeverity severity, LogSeverity minSeverity) noexcept
+{
+    auto level = [](LogSeverity s) {
+        switch (s)
+        {
+        case LogSeverity::Verbose:
+            return 0;
+        case LogSeverity::Info:
+            return 1;
+        case LogSeverity::Warning:
+            return 2;
+        case LogSeverity::Error:
+            return 3;
+        }
+        return 3;
+    };
+    return level(severity) >= level(minSeverity);
+}
+
+/**
+ * @brief An argument of a log message, named for structured logging
+ */
+template <typename T>
+struct NamedLogArg
+{
+    std::string_view key;
+    const T& value;
+};
+
+/**
+ * @brief Names a LOG_* argument, so the structured logging callback receives it as a field with @param key
+ * @details The value is formatted in the text message like an unnamed argument. std::string values can be passed
+ * directly, without calling c_str().
+ */
+template <typename T>
+NamedLogArg<T> LogArg(std::string_view key, const T& value)
+{
+    return {key, value};
+}
+
+inline const char* ToPrintfArg(const std::string& value)
+{
+    return value.c_str();
+}
+
+template <typename T>
+const T& ToPrintfArg(const T& value)
+{
+    return value;
+}
+
+template <typename T>
+decltype(auto) ToPrintfArg(const NamedLogArg<T>& arg)
+{
+    return ToPrintfArg(arg.value);
+}
+
+inline LogValue ToLogValue(const char* value)
+{
+    return std::string_view(value ? value : "");
+}
+
+inline LogValue ToLogValue(const std::string& value)
+{
+    return std::string_view(value);
+}
+
+template <typename T>
+LogValue ToLogValue(const T& value)
+{
+    static_assert(std::is_arithmetic_v<T>, "Log arguments must be strings or numbers");
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        return static_cast<double>(value);
+    }
+    else if constexpr (std::is_signed_v<T>)
+    {
+        return static_cast<int64_t>(value);
+    }
+    else
+    {
+        return static_cast<uint64_t>(value);
+    }
+}
+
+template <typename T>
+LogField ToLogField(const T& value)
+{
+    return {{}, ToLogValue(value)};
+}
+
+template <typename T>
+LogField ToLogField(const NamedLogArg<T>& arg)
+{
+    return {arg.key, ToLogValue(arg.value)};
+}
+
 /**
  * @brief This class enables thread-safe access to the externally set logging callback function.
  * @details Each SFSClient instance will have one ReportingHandler instance, and access to the logging callback function
  * is controlled by a mutex that makes sure that only one thread can access the logging callback function at a time.
+ * With asynchronous logging, messages are queued instead, and the callback is only called from the logging thread.
+ * The structured logging callback receives the arguments of each message instead of the formatted text. It is always
+ * called from the thread that logs, and may be called from multiple threads at once.
  */
 class ReportingHandler
 {
@@ -36,15 +163,56 @@ class ReportingHandler
 
     /**
      * @brief Sets the logging callback function.
-     * @details This function is thread-safe.
+     * @details This function is thread-safe. It waits for the call, or with asynchronous logging the batch, being
+     * delivered with the previous callback to finish, so it must not be called from the callback.
      * @param callback The logging callback function. To reset, pass a nullptr.
      */
     void SetLoggingCallback(LoggingCallbackFn&& callback);
 
+    /**
+     * @brief Sets the structured logging callback function.
+     * @details This function is thread-safe. It waits for the calls still using the previous callback to finish, so it
+     * must not be called from the callback.
+     * @param callback The structured logging callback function. To reset, pass a nullptr.
+     */
+    void SetStructuredLoggingCallback(StructuredLoggingCallbackFn&& callback);
+
+    /**
+     * @brief Makes messages be queued and passed to the logging callback in batches from a background thread
+     * @details Must be called before logging from other threads. Messages still queued are delivered when this object
+     * is destroyed.
+     */
+    void StartAsyncLogging(const AsyncLoggingConfig& config);
+
+    /**
+     * @brief Waits until the messages logged before this call are passed to the logging callback
+     * @details Returns immediately if logging is not asynchronous. Must not be called from the logging callback.
+     */
+    void Flush() const;
+
+    /**
+     * @brief Sets the least severe messages that are logged. Less severe messages are dropped before being formatted.
+     * @details This function is thread-safe.
+     */
+    void SetMinSeverity(LogSeverity minSeverity);
+
+    /**
+     * @return Whether a message with the given severity would be passed to a logging callback.
+     * @details Doesn't lock, so it can be called before doing any work to build the message.
+     */
+    bool IsEnabled(LogSeverity severity) const noexcept
+    {
+        return (m_hasLoggingCallback.load(std::memory_order_relaxed) ||
+                m_hasStructuredLoggingCallback.load(std::memory_order_relaxed)) &&
+               IsAtLeast(severity, m_minSeverity.load(std::memory_order_relaxed));
+    }
+
     /**
      * @brief Logs a message with the given severity.
      * @details Prefer calling it with macros LOG_INFO, LOG_WARNING, LOG_ERROR, LOG_VERBOSE so file, line and function
-     * are automatically populated and the message can be formatted.
+     * are automatically populated and the message can be formatted. The message is only formatted for the logging
+     * callback: the structured logging callback gets @param format and the arguments as they are. Arguments can be
+     * named with LogArg().
      */
     template <typename... Args>
     void LogWithSeverity(LogSeverity severity,
@@ -54,15 +222,52 @@ class ReportingHandler
                          const char* format,
                          const Args&... args) const
     {
+        if (!IsEnabled(severity))
+        {
+            return;
+        }
+
         constexpr std::size_t n = sizeof...(Args);
-        if constexpr (n == 0)
+        if (m_hasStructuredLoggingCallback.load(std::memory_order_relaxed))
+        {
+            if constexpr (n == 0)
+            {
+                CallStructuredLoggingCallback(severity, format, nullptr, 0, file, line, function);
+            }
+            else
+            {
+                const LogField fields[] = {ToLogField(args)...};
+                CallStructuredLoggingCallback(severity, format, fields, n, file, line, function);
+            }
+        }
+
+        if (!m_hasLoggingCallback.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        if (m_asyncLogger)
+        {
+            // Formats straight into the queued record
+            m_asyncLogger->Log(severity, file, line, function, [&](char* message, size_t size) {
+                if constexpr (n == 0)
+                {
+                    snprintf(message, size, "%s", format);
+                }
+                else
+                {
+                    snprintf(message, size, format, ToPrintfArg(args)...);
+                }
+            });
+        }
+        else if constexpr (n == 0)
         {
             CallLoggingCallback(severity, format, file, line, function);
         }
         else
         {
             char message[MAX_LOG_MESSAGE_SIZE];
-            snprintf(message, MAX_LOG_MESSAGE_SIZE, format, args...);
+            snprintf(message, MAX_LOG_MESSAGE_SIZE, format, ToPrintfArg(args)...);
             CallLoggingCallback(severity, message, file, line, function);
         }
     }
@@ -74,7 +279,30 @@ class ReportingHandler
                              unsigned line,
                              const char* function) const;
 
+    void CallStructuredLoggingCallback(LogSeverity severity,
+                                       const char* format,
+                                       const LogField* fields,
+                                       size_t fieldCount,
+                                       const char* file,
+                                       unsigned line,
+                                       const char* function) const;
+
+    void DeliverBatch(const std::vector<LogData>& batch) const;
+
+    // Serializes the calls to the callback, whether synchronous or in batches from the logging thread
     LoggingCallbackFn m_loggingCallbackFn;
     mutable std::mutex m_loggingCallbackFnMutex;
+
+    // Calls share the lock, so they are not serialized, and SetStructuredLoggingCallback() takes it exclusively
+    StructuredLoggingCallbackFn m_structuredLoggingCallbackFn;
+    mutable std::shared_mutex m_structuredLoggingCallbackFnMutex;
+
+    // Read without locking, so messages are dropped before any formatting
+    std::atomic<bool> m_hasLoggingCallback{false};
+    std::atomic<bool> m_hasStructuredLoggingCallback{false};
+    std::atomic<LogSeverity> m_minSeverity{LogSeverity::Verbose};
+
+    // Null unless logging is asynchronous. Destroyed first, so queued messages can still be delivered
+    std::unique_ptr<AsyncLogger> m_asyncLogger;
 };
 } // namespace SFS::details
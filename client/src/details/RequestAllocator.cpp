@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "RequestAllocator.h"
+
+using namespace SFS::details;
+
+namespace
+{
+thread_local std::pmr::memory_resource* t_requestMemoryResource = nullptr;
+} // namespace
+
+std::pmr::memory_resource* SFS::details::GetRequestMemoryResource() noexcept
+{
+    return t_requestMemoryResource ? t_requestMemoryResource : std::pmr::new_delete_resource();
+}
+
+ScopedRequestMemoryResource::ScopedRequestMemoryResource(std::pmr::memory_resource* resource) noexcept
+    : m_previous(t_requestMemoryResource)
+{
+    if (resource)
+    {
+        t_requestMemoryResource = resource;
+    }
+}
+
+ScopedRequestMemoryResource::~ScopedRequestMemoryResource()
+{
+    t_requestMemoryResource = m_previous;
+}
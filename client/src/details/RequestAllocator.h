@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <new>
+
+namespace SFS::details
+{
+/**
+ * @return The memory resource set for the current thread by a ScopedRequestMemoryResource, or
+ * std::pmr::new_delete_resource() if there is none
+ */
+std::pmr::memory_resource* GetRequestMemoryResource() noexcept;
+
+/**
+ * @brief Sets the memory resource used by RequestAllocator in the current thread while this object exists
+ * @details A null @param resource keeps the current one. Scopes can be nested.
+ */
+class ScopedRequestMemoryResource
+{
+  public:
+    explicit ScopedRequestMemoryResource(std::pmr::memory_resource* resource) noexcept;
+    ~ScopedRequestMemoryResource();
+
+    ScopedRequestMemoryResource(const ScopedRequestMemoryResource&) = delete;
+    ScopedRequestMemoryResource& operator=(const ScopedRequestMemoryResource&) = delete;
+
+  private:
+    std::pmr::memory_resource* m_previous;
+};
+
+/**
+ * @brief Stateless allocator that allocates from the memory resource of the current thread
+ * @details Used for the transient objects of a request, like parsed JSON, which some libraries create through
+ * default-constructed allocators. Each allocation records the resource it came from, so it is released to the right
+ * resource even if it is freed from another thread or after the scope that set the resource has ended.
+ */
+template <typename T>
+class RequestAllocator
+{
+  public:
+    using value_type = T;
+
+    RequestAllocator() noexcept = default;
+
+    template <typename U>
+    RequestAllocator(const RequestAllocator<U>&) noexcept
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        if (n > (std::numeric_limits<size_t>::max() - c_headerSize) / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+
+        std::pmr::memory_resource* resource = GetRequestMemoryResource();
+        auto* base = static_cast<std::byte*>(resource->allocate(c_headerSize + n * sizeof(T), c_alignment));
+        ::new (base + c_headerSize - sizeof(resource)) std::pmr::memory_resource*(resource);
+        return reinterpret_cast<T*>(base + c_headerSize);
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        std::byte* base = reinterpret_cast<std::byte*>(p) - c_headerSize;
+        auto* resource = *reinterpret_cast<std::pmr::memory_resource**>(base + c_headerSize - sizeof(resource));
+        resource->deallocate(base, c_headerSize + n * sizeof(T), c_alignment);
+    }
+
+    template <typename U>
+    bool operator==(const RequestAllocator<U>&) const noexcept
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const RequestAllocator<U>&) const noexcept
+    {
+        return false;
+    }
+
+  private:
+    static constexpr size_t c_alignment =
+        alignof(T) > alignof(std::pmr::memory_resource*) ? alignof(T) : alignof(std::pmr::memory_resource*);
+
+    // The resource pointer is stored right before the returned memory, in a header that keeps it aligned for T
+    static constexpr size_t c_headerSize =
+        alignof(T) > sizeof(std::pmr::memory_resource*) ? alignof(T) : sizeof(std::pmr::memory_resource*);
+};
+} // namespace SFS::details
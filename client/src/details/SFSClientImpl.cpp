@@ -6,7 +6,11 @@
 #include "AppContent.h"
 #include "Content.h"
 #include "ErrorHandling.h"
+#ifndef SFS_JSON_BACKEND_SIMDJSON
+#include "JsonStreamParser.h"
+#endif
 #include "Logging.h"
+#include "RequestAllocator.h"
 #include "TestOverride.h"
 #include "Util.h"
 #include "connection/Connection.h"
@@ -16,16 +20,33 @@
 
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <streambuf>
+#include <unordered_map>
 #include <unordered_set>
 
 using namespace SFS;
 using namespace SFS::details;
 using namespace SFS::details::util;
-using json = nlohmann::json;
 
 constexpr const char* c_defaultInstanceId = "default";
 constexpr const char* c_defaultNameSpace = "default";
 
+// Upper bound on the connections used at once to get the download info of app prerequisites
+constexpr size_t c_maxConcurrentPrerequisiteRequests = 4;
+
+// Upper bound on the connections used at once to send the batches of a request for many products
+constexpr size_t c_maxConcurrentBatchRequests = 4;
+
+constexpr const char* c_deferredTaskCancelledMessage = "SFSClient was destroyed before the prerequisite was retrieved";
+
 namespace
 {
 void ValidateClientConfig(const ClientConfig& config, const ReportingHandler& handler)
@@ -44,6 +65,21 @@ void ValidateClientConfig(const ClientConfig& config, const ReportingHandler& ha
     {
         THROW_CODE_IF_LOG(InvalidArg, config.nameSpace->empty(), handler, "ClientConfig::nameSpace must not be empty");
     }
+
+    const auto& limits = config.responseSizeLimits;
+    THROW_CODE_IF_LOG(InvalidArg,
+                      limits.latestVersion == 0 || limits.latestVersionBatchPerProduct == 0 ||
+                          limits.specificVersion == 0 || limits.downloadInfo == 0,
+                      handler,
+                      "ClientConfig::responseSizeLimits values must be greater than 0");
+
+    if (config.asyncLogging)
+    {
+        THROW_CODE_IF_LOG(InvalidArg,
+                          config.asyncLogging->queueSize == 0,
+                          handler,
+                          "ClientConfig::asyncLogging::queueSize must be greater than 0");
+    }
 }
 
 void LogIfTestOverridesAllowed(const ReportingHandler& handler)
@@ -54,6 +90,12 @@ void LogIfTestOverridesAllowed(const ReportingHandler& handler)
     }
 }
 
+#ifdef SFS_JSON_BACKEND_SIMDJSON
+VersionEntity ParseVersionResponse(std::string& data, const std::string& method, const ReportingHandler& handler)
+{
+    return VersionEntityFromJson(data, method, handler);
+}
+#else
 void ThrowInvalidResponseIfFalse(bool condition, const std::string& message, const ReportingHandler& handler)
 {
     THROW_CODE_IF_LOG(ServiceInvalidResponse, !condition, handler, message);
@@ -74,7 +116,7 @@ json ParseServerMethodStringToJson(const std::string& data, const std::string& m
     }
 }
 
-VersionEntities ConvertLatestVersionBatchResponseToVersionEntities(const json& data, const ReportingHandler& handler)
+VersionEntities ParseLatestVersionBatchResponseToVersionEntities(std::istream& stream, const ReportingHandler& handler)
 {
     // Expected format:
     // [
@@ -88,19 +130,42 @@ VersionEntities ConvertLatestVersionBatchResponseToVersionEntities(const json& d
     //   ...
     // ]
     //
-
-    ThrowInvalidResponseIfFalse(data.is_array(), "Response is not a JSON array", handler);
-    ThrowInvalidResponseIfFalse(data.size() > 0, "Response does not have the expected size", handler);
+    // Each entity is built as soon as its object is received
 
     VersionEntities entities;
-    for (const auto& obj : data)
-    {
-        entities.push_back(std::move(VersionEntity::FromJson(obj, handler)));
-    }
+    ParseJsonObjectArray(
+        stream,
+        [&](json&& obj) { entities.push_back(VersionEntityFromJson(obj, handler)); },
+        "GetLatestVersionBatch",
+        handler);
+
+    ThrowInvalidResponseIfFalse(entities.size() > 0, "Response does not have the expected size", handler);
 
     return entities;
 }
 
+// Posts a download info request to @param url, calling @param onFile with each file of the response as soon as it is
+// received
+void StreamDownloadInfoResponse(Connection& connection,
+                                const std::string& url,
+                                const JsonElementHandler& onFile,
+                                const ReportingHandler& handler)
+{
+    // The handler may be called from another thread, which must use the memory resource of the request
+    std::pmr::memory_resource* resource = GetRequestMemoryResource();
+    connection.StreamingPost(url, {}, [&](std::istream& stream) {
+        ScopedRequestMemoryResource scopedResource(resource);
+        ParseJsonObjectArray(stream, onFile, "GetDownloadInfo", handler);
+    });
+}
+
+VersionEntity ParseVersionResponse(std::string& data, const std::string& method, const ReportingHandler& handler)
+{
+    const json versionResponse = ParseServerMethodStringToJson(data, method, handler);
+    return VersionEntityFromJson(versionResponse, handler);
+}
+#endif
+
 bool VerifyVersionResponseMatchesProduct(const ContentIdEntity& contentId,
                                          std::string_view nameSpace,
                                          std::string_view name)
@@ -114,7 +179,7 @@ void ValidateVersionEntity(const VersionEntity& versionEntity,
                            const ReportingHandler& handler)
 {
     THROW_CODE_IF_NOT_LOG(ServiceInvalidResponse,
-                          VerifyVersionResponseMatchesProduct(versionEntity.contentId, nameSpace, product),
+                          VerifyVersionResponseMatchesProduct(GetBase(versionEntity).contentId, nameSpace, product),
                           handler,
                           "Response does not match the requested product");
 }
@@ -126,22 +191,32 @@ void ValidateBatchVersionEntity(const VersionEntities& versionEntities,
 {
     for (const auto& entity : versionEntities)
     {
+        const auto& contentId = GetBase(entity).contentId;
         THROW_CODE_IF_LOG(ServiceInvalidResponse,
-                          requestedProducts.count(entity->contentId.name) == 0,
+                          requestedProducts.count(contentId.name) == 0,
                           handler,
-                          "Received product [" + entity->contentId.name +
-                              "] which is not one of the requested products");
+                          "Received product [" + contentId.name + "] which is not one of the requested products");
         THROW_CODE_IF_LOG(ServiceInvalidResponse,
-                          AreNotEqualI(entity->contentId.nameSpace, nameSpace),
+                          AreNotEqualI(contentId.nameSpace, nameSpace),
                           handler,
-                          "Received product [" + entity->contentId.name + "] with a namespace [" +
-                              entity->contentId.nameSpace + "] that does not match the requested namespace");
+                          "Received product [" + contentId.name + "] with a namespace [" + contentId.nameSpace +
+                              "] that does not match the requested namespace");
 
         LOG_INFO(handler,
                  "Received a response for product [%s] with version %s",
-                 entity->contentId.name.c_str(),
-                 entity->contentId.version.c_str());
+                 LogArg("product", contentId.name),
+                 LogArg("version", contentId.version));
+    }
+}
+
+size_t GetBatchMaxResponseSize(size_t maxSizePerProduct, size_t productCount)
+{
+    // Saturate instead of overflowing for very large limits
+    if (productCount != 0 && maxSizePerProduct > std::numeric_limits<size_t>::max() / productCount)
+    {
+        return std::numeric_limits<size_t>::max();
     }
+    return maxSizePerProduct * productCount;
 }
 
 void ValidateRequestParams(const RequestParams& requestParams, const ReportingHandler& handler)
@@ -159,6 +234,187 @@ void ValidateRequestParams(const RequestParams& requestParams, const ReportingHa
         THROW_CODE_IF_LOG(InvalidArg, product.empty(), handler, "product must not be empty");
     }
 }
+
+// Same as ValidateRequestParams(), for the APIs that accept multiple product requests
+void ValidateMultiProductRequestParams(const RequestParams& requestParams, const ReportingHandler& handler)
+{
+    THROW_CODE_IF_LOG(InvalidArg, requestParams.productRequests.empty(), handler, "productRequests cannot be empty");
+
+    // The service returns each product once, so it can't answer a product requested with different attributes
+    std::unordered_map<std::string_view, const TargetingAttributes*> productAttributes;
+    for (const auto& [product, attributes] : requestParams.productRequests)
+    {
+        THROW_CODE_IF_LOG(InvalidArg, product.empty(), handler, "product must not be empty");
+
+        const auto [it, inserted] = productAttributes.emplace(product, &attributes);
+        THROW_CODE_IF_LOG(InvalidArg,
+                          !inserted && *it->second != attributes,
+                          handler,
+                          "product [" + product + "] is requested more than once with different attributes");
+    }
+}
+
+void ValidateAppInstanceId(const std::string& instanceId, const ReportingHandler& handler)
+{
+    // TODO #150: For now apps are only coming from the "storeapps" instanceId and the service has requested
+    // we double check for it. In the future we should remove this check and allow the user to specify any instanceId
+    THROW_CODE_IF_LOG(Unexpected,
+                      AreNotEqualI(instanceId, "storeapps"),
+                      handler,
+                      "At this moment only the \"storeapps\" instanceId can send app requests");
+}
+
+// Makes the ContentId of @param entity, with its namespace and name taken from @param pool if it is enabled
+std::unique_ptr<ContentId> ToPooledContentId(StringPool* pool,
+                                             VersionEntityBase&& entity,
+                                             const ReportingHandler& handler)
+{
+    if (pool)
+    {
+        return pool->MakeContentId(std::move(entity.contentId.nameSpace),
+                                   std::move(entity.contentId.name),
+                                   std::move(entity.contentId.version));
+    }
+    return ToContentId(std::move(entity), handler);
+}
+
+// Same as ToPooledContentId(), copying @param contentId
+std::unique_ptr<ContentId> CopyPooledContentId(StringPool* pool,
+                                               const ContentId& contentId,
+                                               const ReportingHandler& handler)
+{
+    if (pool)
+    {
+        return pool->MakeContentId(contentId.GetNameSpace(), contentId.GetName(), contentId.GetVersion());
+    }
+
+    std::unique_ptr<ContentId> copy;
+    THROW_IF_FAILED_LOG(ContentId::Make(contentId.GetNameSpace(), contentId.GetName(), contentId.GetVersion(), copy),
+                        handler);
+    return copy;
+}
+
+void InternIfEnabled(StringPool* pool, AppFile& file)
+{
+    if (pool)
+    {
+        pool->Intern(file);
+    }
+}
+
+void InternIfEnabled(StringPool* pool, std::vector<AppFile>& files)
+{
+    for (auto& file : files)
+    {
+        InternIfEnabled(pool, file);
+    }
+}
+
+/**
+ * @brief Runs @param work on the calling thread with @param connection, and on up to @param threadCount - 1 other
+ * threads, each with a connection made by @param makeConnection, as connections can't be shared between threads
+ * @details @param work is expected to take tasks from a shared state until there are none left. If it throws on any
+ * thread, @param stop is called so the other threads don't take more tasks, and the first exception is rethrown once
+ * all threads are done
+ */
+void RunOnWorkers(size_t threadCount,
+                  Connection& connection,
+                  const std::function<std::unique_ptr<Connection>()>& makeConnection,
+                  const std::function<void(Connection&)>& work,
+                  const std::function<void()>& stop)
+{
+    std::vector<std::future<void>> workers;
+    for (size_t i = 1; i < threadCount; ++i)
+    {
+        workers.push_back(std::async(std::launch::async, [&] {
+            const auto workerConnection = makeConnection();
+            work(*workerConnection);
+        }));
+    }
+
+    std::exception_ptr error;
+    auto stopOnError = [&](std::exception_ptr exception) {
+        stop();
+        if (!error)
+        {
+            error = exception;
+        }
+    };
+
+    try
+    {
+        work(connection);
+    }
+    catch (...)
+    {
+        stopOnError(std::current_exception());
+    }
+
+    for (auto& worker : workers)
+    {
+        try
+        {
+            worker.get();
+        }
+        catch (...)
+        {
+            stopOnError(std::current_exception());
+        }
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+/// @brief Fails the @param promises that don't have a result yet with @param error
+void FailUnsetPromises(std::vector<std::promise<AppPrerequisiteContent>>& promises, std::exception_ptr error)
+{
+    for (auto& promise : promises)
+    {
+        try
+        {
+            promise.set_exception(error);
+        }
+        catch (const std::future_error&)
+        {
+        }
+    }
+}
+
+/// @brief Reads from another stream buffer, counting the bytes read
+class CountingStreamBuffer : public std::streambuf
+{
+  public:
+    explicit CountingStreamBuffer(std::streambuf* source) : m_source(source)
+    {
+    }
+
+    size_t GetCount() const
+    {
+        return m_count;
+    }
+
+  protected:
+    int_type underflow() override
+    {
+        const std::streamsize size = m_source->sgetn(m_buffer, sizeof(m_buffer));
+        if (size <= 0)
+        {
+            return traits_type::eof();
+        }
+
+        m_count += static_cast<size_t>(size);
+        setg(m_buffer, m_buffer, m_buffer + size);
+        return traits_type::to_int_type(m_buffer[0]);
+    }
+
+  private:
+    std::streambuf* m_source;
+    char m_buffer[4096];
+    size_t m_count{0};
+};
 } // namespace
 
 template <typename ConnectionManagerT>
@@ -168,41 +424,85 @@ SFSClientImpl<ConnectionManagerT>::SFSClientImpl(ClientConfig&& config)
     {
         m_reportingHandler.SetLoggingCallback(std::move(*config.logCallbackFn));
     }
+    if (config.structuredLogCallbackFn)
+    {
+        m_reportingHandler.SetStructuredLoggingCallback(std::move(*config.structuredLogCallbackFn));
+    }
+    m_reportingHandler.SetMinSeverity(config.minLogSeverity);
 
     ValidateClientConfig(config, m_reportingHandler);
 
+    if (config.asyncLogging)
+    {
+        m_reportingHandler.StartAsyncLogging(*config.asyncLogging);
+    }
+
     m_accountId = std::move(config.accountId);
     m_instanceId =
         (config.instanceId && !config.instanceId->empty()) ? std::move(*config.instanceId) : c_defaultInstanceId;
     m_nameSpace = (config.nameSpace && !config.nameSpace->empty()) ? std::move(*config.nameSpace) : c_defaultNameSpace;
+    m_responseSizeLimits = config.responseSizeLimits;
+
+    if (config.maxInternedStrings > 0)
+    {
+        m_stringPool = std::make_unique<StringPool>(config.maxInternedStrings);
+    }
 
     static_assert(std::is_base_of<ConnectionManager, ConnectionManagerT>::value,
                   "ConnectionManagerT not derived from ConnectionManager");
-    m_connectionManager = std::make_unique<ConnectionManagerT>(m_reportingHandler);
+    m_connectionManager = std::make_unique<ConnectionManagerT>(m_reportingHandler, ConnectionManagerConfig(config));
 
     LogIfTestOverridesAllowed(m_reportingHandler);
 }
 
 template <typename ConnectionManagerT>
-std::unique_ptr<VersionEntity> SFSClientImpl<ConnectionManagerT>::GetLatestVersion(const ProductRequest& productRequest,
-                                                                                   Connection& connection) const
+SFSClientImpl<ConnectionManagerT>::~SFSClientImpl()
+{
+    // Deferred prerequisites are retrieved with this object, so the ones that are left are failed instead
+    std::deque<DeferredTask> pendingTasks;
+    {
+        std::lock_guard guard(m_deferredTasksMutex);
+        m_cancelDeferredTasks = true;
+        pendingTasks.swap(m_deferredTasks);
+    }
+    m_deferredTasksCv.notify_all();
+
+    for (auto& task : pendingTasks)
+    {
+        task.cancel();
+    }
+
+    if (m_deferredTaskThread.joinable())
+    {
+        m_deferredTaskThread.join();
+    }
+}
+
+template <typename ConnectionManagerT>
+VersionEntity SFSClientImpl<ConnectionManagerT>::GetLatestVersion(const ProductRequest& productRequest,
+                                                                  Connection& connection) const
 try
 {
     const auto& [product, attributes] = productRequest;
     const std::string url{MakeUrlBuilder().GetLatestVersionUrl(product)};
 
-    LOG_INFO(m_reportingHandler, "Requesting latest version of [%s] from URL [%s]", product.c_str(), url.c_str());
+    LOG_INFO(m_reportingHandler,
+             "Requesting latest version of [%s] from URL [%s]",
+             LogArg("product", product),
+             LogArg("url", url));
 
-    const json body = {{"TargetingAttributes", attributes}};
-    LOG_VERBOSE(m_reportingHandler, "Request body [%s]", body.dump().c_str());
+    const std::string body = json{{"TargetingAttributes", attributes}}.dump();
+    LOG_VERBOSE(m_reportingHandler, "Request body [%s]", body.c_str());
 
-    const std::string postResponse{connection.Post(url, body.dump())};
-    const json versionResponse = ParseServerMethodStringToJson(postResponse, "GetLatestVersion", m_reportingHandler);
+    connection.SetMaxResponseSize(m_responseSizeLimits.latestVersion);
+    std::string postResponse{connection.Post(url, body)};
 
-    auto versionEntity = VersionEntity::FromJson(versionResponse, m_reportingHandler);
-    ValidateVersionEntity(*versionEntity, m_nameSpace, product, m_reportingHandler);
+    auto versionEntity = ParseVersionResponse(postResponse, "GetLatestVersion", m_reportingHandler);
+    ValidateVersionEntity(versionEntity, m_nameSpace, product, m_reportingHandler);
 
-    LOG_INFO(m_reportingHandler, "Received a response with version %s", versionEntity->contentId.version.c_str());
+    LOG_INFO(m_reportingHandler,
+             "Received a response with version %s",
+             LogArg("version", GetBase(versionEntity).contentId.version));
 
     return versionEntity;
 }
@@ -212,31 +512,54 @@ template <typename ConnectionManagerT>
 VersionEntities SFSClientImpl<ConnectionManagerT>::GetLatestVersionBatch(
     const std::vector<ProductRequest>& productRequests,
     Connection& connection) const
+{
+    size_t responseSize = 0;
+    return PostLatestVersionBatch(productRequests, connection, responseSize);
+}
+
+template <typename ConnectionManagerT>
+VersionEntities SFSClientImpl<ConnectionManagerT>::PostLatestVersionBatch(
+    const std::vector<ProductRequest>& productRequests,
+    Connection& connection,
+    size_t& responseSize) const
 try
 {
     const std::string url{MakeUrlBuilder().GetLatestVersionBatchUrl()};
 
-    LOG_INFO(m_reportingHandler, "Requesting latest version of multiple products from URL [%s]", url.c_str());
+    LOG_INFO(m_reportingHandler, "Requesting latest version of multiple products from URL [%s]", LogArg("url", url));
 
     // Creating request body
     std::unordered_set<std::string> requestedProducts;
     json body = json::array();
     for (const auto& [product, attributes] : productRequests)
     {
-        LOG_INFO(m_reportingHandler, "Product #%zu: [%s]", body.size() + size_t{1}, product.c_str());
+        LOG_INFO(m_reportingHandler, "Product #%zu: [%s]", body.size() + size_t{1}, LogArg("product", product));
         requestedProducts.insert(product);
 
         body.push_back({{"TargetingAttributes", attributes}, {"Product", product}});
     }
 
-    LOG_VERBOSE(m_reportingHandler, "Request body [%s]", body.dump().c_str());
+    const std::string requestBody = body.dump();
+    LOG_VERBOSE(m_reportingHandler, "Request body [%s]", requestBody.c_str());
 
-    const std::string postResponse{connection.Post(url, body.dump())};
+    connection.SetMaxResponseSize(
+        GetBatchMaxResponseSize(m_responseSizeLimits.latestVersionBatchPerProduct, productRequests.size()));
 
-    const json versionResponse =
-        ParseServerMethodStringToJson(postResponse, "GetLatestVersionBatch", m_reportingHandler);
-
-    auto entities = ConvertLatestVersionBatchResponseToVersionEntities(versionResponse, m_reportingHandler);
+#ifdef SFS_JSON_BACKEND_SIMDJSON
+    // simdjson parses a complete document, so the response is buffered before parsing
+    std::string postResponse{connection.Post(url, requestBody)};
+    responseSize = postResponse.size();
+    VersionEntities entities =
+        BatchResponseToVersionEntities(postResponse, "GetLatestVersionBatch", m_reportingHandler);
+#else
+    VersionEntities entities;
+    connection.StreamingPost(url, requestBody, [&](std::istream& stream) {
+        CountingStreamBuffer countingBuffer(stream.rdbuf());
+        std::istream countingStream(&countingBuffer);
+        entities = ParseLatestVersionBatchResponseToVersionEntities(countingStream, m_reportingHandler);
+        responseSize = countingBuffer.GetCount();
+    });
+#endif
     ValidateBatchVersionEntity(entities, m_nameSpace, requestedProducts, m_reportingHandler);
 
     return entities;
@@ -244,29 +567,138 @@ try
 SFS_CATCH_LOG_RETHROW(m_reportingHandler)
 
 template <typename ConnectionManagerT>
-std::unique_ptr<VersionEntity> SFSClientImpl<ConnectionManagerT>::GetSpecificVersion(const std::string& product,
-                                                                                     const std::string& version,
-                                                                                     Connection& connection) const
+VersionEntities SFSClientImpl<ConnectionManagerT>::GetLatestVersions(const RequestParams& requestParams,
+                                                                     Connection& connection) const
+{
+    // The service returns each product once, so repeating one only makes the request bigger. Validation made sure the
+    // repeated requests of a product have the same attributes
+    std::vector<ProductRequest> productRequests;
+    std::unordered_map<std::string, size_t> productIndexes;
+    for (const auto& productRequest : requestParams.productRequests)
+    {
+        if (productIndexes.emplace(productRequest.product, productRequests.size()).second)
+        {
+            productRequests.push_back(productRequest);
+        }
+        else
+        {
+            LOG_INFO(m_reportingHandler,
+                     "Product [%s] is requested more than once, only the first request is sent",
+                     LogArg("product", productRequest.product));
+        }
+    }
+
+    if (productRequests.size() == 1)
+    {
+        VersionEntities entities;
+        entities.push_back(GetLatestVersion(productRequests[0], connection));
+        return entities;
+    }
+
+    // Batches are taken by the workers as they become free, so each one gets the latest size from m_batchSizer
+    std::mutex mutex;
+    size_t nextProduct = 0;
+    VersionEntities entities;
+    bool anyNotFound = false;
+
+    auto sendBatches = [&](Connection& workerConnection) {
+        while (true)
+        {
+            std::vector<ProductRequest> batch;
+            {
+                std::lock_guard guard(mutex);
+                if (nextProduct >= productRequests.size())
+                {
+                    return;
+                }
+                const size_t end = std::min(productRequests.size(), nextProduct + m_batchSizer.GetBatchSize());
+                batch.assign(productRequests.begin() + nextProduct, productRequests.begin() + end);
+                nextProduct = end;
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            size_t responseSize = 0;
+            VersionEntities batchEntities;
+            try
+            {
+                batchEntities = PostLatestVersionBatch(batch, workerConnection, responseSize);
+            }
+            catch (const SFSException& e)
+            {
+                // The service fails a batch in which it knows none of the products, which is only an error if it knows
+                // none of the products of any batch
+                if (e.GetResult().GetCode() != Result::HttpNotFound)
+                {
+                    m_batchSizer.OnFailure(batch.size());
+                    throw;
+                }
+                std::lock_guard guard(mutex);
+                anyNotFound = true;
+                continue;
+            }
+            m_batchSizer.OnSuccess(
+                batch.size(),
+                std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start),
+                responseSize);
+
+            std::lock_guard guard(mutex);
+            std::move(batchEntities.begin(), batchEntities.end(), std::back_inserter(entities));
+        }
+    };
+
+    const size_t batchSize = m_batchSizer.GetBatchSize();
+    const size_t batchCount = (productRequests.size() + batchSize - 1) / batchSize;
+    LOG_INFO(m_reportingHandler,
+             "Requesting latest version of %zu products in batches of %zu",
+             productRequests.size(),
+             batchSize);
+
+    RunOnWorkers(
+        std::min(batchCount, c_maxConcurrentBatchRequests),
+        connection,
+        [&] { return MakeConnection(ConnectionConfig(requestParams)); },
+        sendBatches,
+        [&] {
+            std::lock_guard guard(mutex);
+            nextProduct = productRequests.size();
+        });
+
+    THROW_CODE_IF_LOG(HttpNotFound,
+                      entities.empty() && anyNotFound,
+                      m_reportingHandler,
+                      "None of the requested products were found");
+
+    // Batches complete in any order, so the entities are put back in the order of the requests
+    std::stable_sort(entities.begin(), entities.end(), [&](const VersionEntity& a, const VersionEntity& b) {
+        return productIndexes.at(GetBase(a).contentId.name) < productIndexes.at(GetBase(b).contentId.name);
+    });
+
+    return entities;
+}
+
+template <typename ConnectionManagerT>
+VersionEntity SFSClientImpl<ConnectionManagerT>::GetSpecificVersion(const std::string& product,
+                                                                    const std::string& version,
+                                                                    Connection& connection) const
 try
 {
     const std::string url{MakeUrlBuilder().GetSpecificVersionUrl(product, version)};
 
     LOG_INFO(m_reportingHandler,
              "Requesting version [%s] of [%s] from URL [%s]",
-             version.c_str(),
-             product.c_str(),
-             url.c_str());
+             LogArg("version", version),
+             LogArg("product", product),
+             LogArg("url", url));
 
-    const std::string getResponse{connection.Get(url)};
+    connection.SetMaxResponseSize(m_responseSizeLimits.specificVersion);
+    std::string getResponse{connection.Get(url)};
 
-    const json versionResponse = ParseServerMethodStringToJson(getResponse, "GetSpecificVersion", m_reportingHandler);
-
-    auto versionEntity = VersionEntity::FromJson(versionResponse, m_reportingHandler);
-    ValidateVersionEntity(*versionEntity, m_nameSpace, product, m_reportingHandler);
+    auto versionEntity = ParseVersionResponse(getResponse, "GetSpecificVersion", m_reportingHandler);
+    ValidateVersionEntity(versionEntity, m_nameSpace, product, m_reportingHandler);
 
     LOG_INFO(m_reportingHandler,
              "Received the expected response with version %s",
-             versionEntity->contentId.version.c_str());
+             LogArg("version", GetBase(versionEntity).contentId.version));
 
     return versionEntity;
 }
@@ -278,41 +710,173 @@ FileEntities SFSClientImpl<ConnectionManagerT>::GetDownloadInfo(const std::strin
                                                                 Connection& connection) const
 try
 {
-    const std::string url{MakeUrlBuilder().GetDownloadInfoUrl(product, version)};
+    const std::string url{SetUpDownloadInfoRequest(product, version, connection)};
+
+#ifdef SFS_JSON_BACKEND_SIMDJSON
+    // simdjson parses a complete document, so the response is buffered before parsing
+    std::string postResponse{connection.Post(url, {})};
+    FileEntities files =
+        DownloadInfoResponseToFileEntities(postResponse, "GetDownloadInfo", m_reportingHandler);
+#else
+    // The response is parsed as it arrives, building each file entity as soon as its data is received
+    FileEntities files;
+    StreamDownloadInfoResponse(
+        connection,
+        url,
+        [&](json&& file) { files.push_back(FileEntityFromJson(file, m_reportingHandler)); },
+        m_reportingHandler);
+#endif
+
+    LOG_INFO(m_reportingHandler, "Received a response with %zu files", files.size());
+
+    return files;
+}
+SFS_CATCH_LOG_RETHROW(m_reportingHandler)
+
+template <typename ConnectionManagerT>
+std::string SFSClientImpl<ConnectionManagerT>::SetUpDownloadInfoRequest(const std::string& product,
+                                                                        const std::string& version,
+                                                                        Connection& connection) const
+{
+    std::string url{MakeUrlBuilder().GetDownloadInfoUrl(product, version)};
 
     LOG_INFO(m_reportingHandler,
              "Requesting download info of version [%s] of [%s] from URL [%s]",
-             version.c_str(),
-             product.c_str(),
-             url.c_str());
+             LogArg("version", version),
+             LogArg("product", product),
+             LogArg("url", url));
 
-    const std::string postResponse{connection.Post(url)};
+    connection.SetMaxResponseSize(m_responseSizeLimits.downloadInfo);
 
-    const json downloadInfoResponse =
-        ParseServerMethodStringToJson(postResponse, "GetDownloadInfo", m_reportingHandler);
+    return url;
+}
 
-    auto files = FileEntity::DownloadInfoResponseToFileEntities(downloadInfoResponse, m_reportingHandler);
+template <typename ConnectionManagerT>
+void SFSClientImpl<ConnectionManagerT>::ForEachFile(const std::string& product,
+                                                    const std::string& version,
+                                                    Connection& connection,
+                                                    const std::function<void(File&&)>& onFile) const
+try
+{
+#ifdef SFS_JSON_BACKEND_SIMDJSON
+    for (auto& file : GenericFileEntity::FileEntitiesToFileVector(GetDownloadInfo(product, version, connection),
+                                                                  m_reportingHandler))
+    {
+        onFile(std::move(file));
+    }
+#else
+    const std::string url{SetUpDownloadInfoRequest(product, version, connection)};
+
+    size_t fileCount = 0;
+    StreamDownloadInfoResponse(
+        connection,
+        url,
+        [&](json&& file) {
+            onFile(std::move(*FileFromJson(std::move(file), m_reportingHandler)));
+            ++fileCount;
+        },
+        m_reportingHandler);
+
+    LOG_INFO(m_reportingHandler, "Received a response with %zu files", fileCount);
+#endif
+}
+SFS_CATCH_LOG_RETHROW(m_reportingHandler)
 
-    LOG_INFO(m_reportingHandler, "Received a response with %zu files", files.size());
+template <typename ConnectionManagerT>
+void SFSClientImpl<ConnectionManagerT>::ForEachAppFile(const std::string& product,
+                                                       const std::string& version,
+                                                       Connection& connection,
+                                                       const std::optional<AppFileFilter>& filter,
+                                                       const std::function<void(AppFile&&)>& onFile) const
+try
+{
+#ifdef SFS_JSON_BACKEND_SIMDJSON
+    auto entities = GetDownloadInfo(product, version, connection);
+    const size_t entityCount = entities.size();
+    auto files = filter ? AppFileEntity::FileEntitiesToAppFileVector(std::move(entities), *filter, m_reportingHandler)
+                        : AppFileEntity::FileEntitiesToAppFileVector(std::move(entities), m_reportingHandler);
+    if (filter)
+    {
+        LOG_INFO(m_reportingHandler,
+                 "Applicability filter dropped %zu of %zu files",
+                 entityCount - files.size(),
+                 entityCount);
+    }
 
-    return files;
+    for (auto& file : files)
+    {
+        onFile(std::move(file));
+    }
+#else
+    const std::string url{SetUpDownloadInfoRequest(product, version, connection)};
+
+    size_t fileCount = 0;
+    size_t droppedCount = 0;
+    StreamDownloadInfoResponse(
+        connection,
+        url,
+        [&](json&& file) {
+            if (!filter)
+            {
+                onFile(std::move(*AppFileFromJson(std::move(file), m_reportingHandler)));
+            }
+            else if (auto appFile = AppFileFromJson(std::move(file), *filter, m_reportingHandler))
+            {
+                onFile(std::move(*appFile));
+            }
+            else
+            {
+                ++droppedCount;
+            }
+            ++fileCount;
+        },
+        m_reportingHandler);
+
+    LOG_INFO(m_reportingHandler, "Received a response with %zu files", fileCount);
+    if (filter)
+    {
+        LOG_INFO(m_reportingHandler, "Applicability filter dropped %zu of %zu files", droppedCount, fileCount);
+    }
+#endif
 }
 SFS_CATCH_LOG_RETHROW(m_reportingHandler)
 
+template <typename ConnectionManagerT>
+std::vector<File> SFSClientImpl<ConnectionManagerT>::GetFiles(const std::string& product,
+                                                              const std::string& version,
+                                                              Connection& connection) const
+{
+    std::vector<File> files;
+    ForEachFile(product, version, connection, [&](File&& file) { files.push_back(std::move(file)); });
+    return files;
+}
+
+template <typename ConnectionManagerT>
+std::vector<AppFile> SFSClientImpl<ConnectionManagerT>::GetAppFiles(const std::string& product,
+                                                                    const std::string& version,
+                                                                    Connection& connection,
+                                                                    const std::optional<AppFileFilter>& filter) const
+{
+    std::vector<AppFile> files;
+    ForEachAppFile(product, version, connection, filter, [&](AppFile&& file) { files.push_back(std::move(file)); });
+    return files;
+}
+
 template <typename ConnectionManagerT>
 std::vector<Content> SFSClientImpl<ConnectionManagerT>::GetLatestDownloadInfo(const RequestParams& requestParams) const
 try
 {
     ValidateRequestParams(requestParams, m_reportingHandler);
 
+    ScopedRequestMemoryResource scopedResource(requestParams.memoryResource);
+
     const auto connection = MakeConnection(ConnectionConfig(requestParams));
 
     auto versionEntity = GetLatestVersion(requestParams.productRequests[0], *connection);
-    auto contentId = VersionEntity::ToContentId(std::move(*versionEntity), m_reportingHandler);
+    auto contentId = ToPooledContentId(m_stringPool.get(), std::move(GetBase(versionEntity)), m_reportingHandler);
 
     const auto& product = requestParams.productRequests[0].product;
-    auto fileEntities = GetDownloadInfo(product, contentId->GetVersion(), *connection);
-    auto files = GenericFileEntity::FileEntitiesToFileVector(std::move(fileEntities), m_reportingHandler);
+    auto files = GetFiles(product, contentId->GetVersion(), *connection);
 
     std::unique_ptr<Content> content;
     THROW_IF_FAILED_LOG(Content::Make(std::move(contentId), std::move(files), content), m_reportingHandler);
@@ -324,66 +888,420 @@ try
 }
 SFS_CATCH_LOG_RETHROW(m_reportingHandler)
 
+template <typename ConnectionManagerT>
+void SFSClientImpl<ConnectionManagerT>::GetLatestApps(const RequestParams& requestParams,
+                                                      const std::optional<AppFileFilter>& filter,
+                                                      Connection& connection,
+                                                      std::vector<LatestApp>& apps,
+                                                      std::vector<std::unique_ptr<ContentId>>& prerequisites) const
+{
+    auto versionEntities = GetLatestVersions(requestParams, connection);
+
+    // Apps often share prerequisites, like frameworks, so each one is only listed once
+    std::map<std::pair<std::string, std::string>, size_t> prerequisiteIndexes;
+    std::unordered_set<std::string> handledProducts;
+    for (auto& versionEntity : versionEntities)
+    {
+        auto& appVersionEntity = GetAppVersionEntity(versionEntity, m_reportingHandler);
+        if (!handledProducts.insert(appVersionEntity.contentId.name).second)
+        {
+            continue;
+        }
+
+        LatestApp app;
+        app.contentId = ToPooledContentId(m_stringPool.get(), std::move(appVersionEntity), m_reportingHandler);
+        app.updateId = std::move(appVersionEntity.updateId);
+
+        LOG_INFO(m_reportingHandler, "Getting download info for app [%s]", LogArg("product", app.contentId->GetName()));
+        app.files = GetAppFiles(app.contentId->GetName(), app.contentId->GetVersion(), connection, filter);
+        InternIfEnabled(m_stringPool.get(), app.files);
+
+        app.prerequisites.reserve(appVersionEntity.prerequisites.size());
+        for (auto& prereq : appVersionEntity.prerequisites)
+        {
+            auto [it, inserted] = prerequisiteIndexes.emplace(
+                std::make_pair(prereq.contentId.name, prereq.contentId.version), prerequisites.size());
+            if (inserted)
+            {
+                prerequisites.push_back(ToPooledContentId(m_stringPool.get(), std::move(prereq), m_reportingHandler));
+            }
+            app.prerequisites.push_back(it->second);
+        }
+
+        apps.push_back(std::move(app));
+    }
+}
+
+template <typename ConnectionManagerT>
+void SFSClientImpl<ConnectionManagerT>::ForEachPrerequisite(
+    std::vector<std::unique_ptr<ContentId>>&& contentIds,
+    const RequestParams& requestParams,
+    const std::optional<AppFileFilter>& filter,
+    Connection& connection,
+    const std::function<void(size_t, AppPrerequisiteContent&&)>& onPrerequisite,
+    const std::function<void(size_t, std::exception_ptr)>& onError) const
+{
+    const size_t count = contentIds.size();
+
+    std::atomic<size_t> next{0};
+    auto getNextPrerequisites = [&](Connection& workerConnection) {
+        for (size_t i = next++; i < count; i = next++)
+        {
+            try
+            {
+                auto& contentId = contentIds[i];
+                LOG_INFO(m_reportingHandler,
+                         "Getting download info for prerequisite [%s]",
+                         LogArg("product", contentId->GetName()));
+
+                auto files = GetAppFiles(contentId->GetName(), contentId->GetVersion(), workerConnection, filter);
+                InternIfEnabled(m_stringPool.get(), files);
+
+                std::unique_ptr<AppPrerequisiteContent> prerequisite;
+                THROW_IF_FAILED_LOG(AppPrerequisiteContent::Make(std::move(contentId), std::move(files), prerequisite),
+                                    m_reportingHandler);
+                onPrerequisite(i, std::move(*prerequisite));
+            }
+            catch (...)
+            {
+                onError(i, std::current_exception());
+            }
+        }
+    };
+
+    // Workers don't use RequestParams::memoryResource, which is set for the calling thread
+    RunOnWorkers(
+        std::min(count, c_maxConcurrentPrerequisiteRequests),
+        connection,
+        [&] { return MakeConnection(ConnectionConfig(requestParams)); },
+        getNextPrerequisites,
+        [&] { next = count; });
+}
+
 template <typename ConnectionManagerT>
 std::vector<AppContent> SFSClientImpl<ConnectionManagerT>::GetLatestAppDownloadInfo(
     const RequestParams& requestParams) const
 try
 {
-    ValidateRequestParams(requestParams, m_reportingHandler);
+    ValidateMultiProductRequestParams(requestParams, m_reportingHandler);
+    ValidateAppInstanceId(m_instanceId, m_reportingHandler);
 
-    // TODO #150: For now apps are only coming from the "storeapps" instanceId and the service has requested
-    // we double check for it. In the future we should remove this check and allow the user to specify any instanceId
-    THROW_CODE_IF_LOG(Unexpected,
-                      AreNotEqualI(m_instanceId, "storeapps"),
-                      m_reportingHandler,
-                      "At this moment only the \"storeapps\" instanceId can send app requests");
+    ScopedRequestMemoryResource scopedResource(requestParams.memoryResource);
 
     const auto connection = MakeConnection(ConnectionConfig(requestParams));
 
-    auto versionEntity = GetLatestVersion(requestParams.productRequests[0], *connection);
+    const auto filter = AppFileFilter::Make(requestParams.applicabilityFilter);
 
-    auto appVersionEntity = AppVersionEntity::GetAppVersionEntityPtr(versionEntity, m_reportingHandler);
-    auto contentId = AppVersionEntity::ToContentId(std::move(*appVersionEntity), m_reportingHandler);
+    std::vector<LatestApp> apps;
+    std::vector<std::unique_ptr<ContentId>> uniquePrerequisites;
+    GetLatestApps(requestParams, filter, *connection, apps, uniquePrerequisites);
 
-    LOG_INFO(m_reportingHandler, "Getting download info for main app content");
-    const auto& product = requestParams.productRequests[0].product;
-    auto fileEntities = GetDownloadInfo(product, contentId->GetVersion(), *connection);
-    auto files = AppFileEntity::FileEntitiesToAppFileVector(std::move(fileEntities), m_reportingHandler);
+    std::vector<std::optional<AppPrerequisiteContent>> prerequisites(uniquePrerequisites.size());
+    ForEachPrerequisite(
+        std::move(uniquePrerequisites),
+        requestParams,
+        filter,
+        *connection,
+        [&](size_t index, AppPrerequisiteContent&& prerequisite) { prerequisites[index] = std::move(prerequisite); },
+        [](size_t, std::exception_ptr error) { std::rethrow_exception(error); });
 
-    std::vector<AppPrerequisiteContent> prerequisites;
-    for (auto& prereq : appVersionEntity->prerequisites)
+    std::vector<AppContent> contents;
+    contents.reserve(apps.size());
+    for (auto& app : apps)
     {
-        LOG_INFO(m_reportingHandler, "Getting download info for prerequisite [%s]", prereq.contentId.name.c_str());
-        auto prereqContentId = GenericVersionEntity::ToContentId(std::move(prereq), m_reportingHandler);
+        std::vector<AppPrerequisiteContent> appPrerequisites;
+        appPrerequisites.reserve(app.prerequisites.size());
+        for (const size_t index : app.prerequisites)
+        {
+            // Copies share the data of the prerequisite
+            appPrerequisites.push_back(*prerequisites[index]);
+        }
+
+        std::unique_ptr<AppContent> content;
+        THROW_IF_FAILED_LOG(AppContent::Make(std::move(app.contentId),
+                                             std::move(app.updateId),
+                                             std::move(appPrerequisites),
+                                             std::move(app.files),
+                                             content),
+                            m_reportingHandler);
+        contents.push_back(std::move(*content));
+    }
+
+    LOG_INFO(m_reportingHandler,
+             "Got download info for %zu apps with %zu unique prerequisites",
+             contents.size(),
+             prerequisites.size());
+
+    return contents;
+}
+SFS_CATCH_LOG_RETHROW(m_reportingHandler)
+
+template <typename ConnectionManagerT>
+std::vector<DeferredAppContent> SFSClientImpl<ConnectionManagerT>::GetLatestAppDownloadInfoDeferred(
+    const RequestParams& requestParams) const
+try
+{
+    ValidateMultiProductRequestParams(requestParams, m_reportingHandler);
+    ValidateAppInstanceId(m_instanceId, m_reportingHandler);
 
-        auto prereqFileEntities =
-            GetDownloadInfo(prereqContentId->GetName(), prereqContentId->GetVersion(), *connection);
-        auto prereqFiles =
-            AppFileEntity::FileEntitiesToAppFileVector(std::move(prereqFileEntities), m_reportingHandler);
+    ScopedRequestMemoryResource scopedResource(requestParams.memoryResource);
+
+    const auto connection = MakeConnection(ConnectionConfig(requestParams));
+
+    auto filter = AppFileFilter::Make(requestParams.applicabilityFilter);
+
+    std::vector<LatestApp> apps;
+    std::vector<std::unique_ptr<ContentId>> uniquePrerequisites;
+    GetLatestApps(requestParams, filter, *connection, apps, uniquePrerequisites);
+
+    // The returned prerequisites get their own copy of the content id, as the original one goes to the
+    // AppPrerequisiteContent once it is retrieved
+    auto promises = std::make_shared<std::vector<std::promise<AppPrerequisiteContent>>>(uniquePrerequisites.size());
+    std::vector<DeferredAppPrerequisite> prerequisites;
+    prerequisites.reserve(uniquePrerequisites.size());
+    for (size_t i = 0; i < uniquePrerequisites.size(); ++i)
+    {
+        auto contentIdCopy = CopyPooledContentId(m_stringPool.get(), *uniquePrerequisites[i], m_reportingHandler);
 
-        std::unique_ptr<AppPrerequisiteContent> prereqContent;
+        std::unique_ptr<DeferredAppPrerequisite> prerequisite;
         THROW_IF_FAILED_LOG(
-            AppPrerequisiteContent::Make(std::move(prereqContentId), std::move(prereqFiles), prereqContent),
+            DeferredAppPrerequisite::Make(std::move(contentIdCopy), (*promises)[i].get_future().share(), prerequisite),
             m_reportingHandler);
+        prerequisites.push_back(std::move(*prerequisite));
+    }
 
-        prerequisites.push_back(std::move(*prereqContent));
+    std::vector<DeferredAppContent> contents;
+    contents.reserve(apps.size());
+    for (auto& app : apps)
+    {
+        std::vector<DeferredAppPrerequisite> appPrerequisites;
+        appPrerequisites.reserve(app.prerequisites.size());
+        for (const size_t index : app.prerequisites)
+        {
+            appPrerequisites.push_back(prerequisites[index]);
+        }
+
+        std::unique_ptr<DeferredAppContent> content;
+        THROW_IF_FAILED_LOG(DeferredAppContent::Make(std::move(app.contentId),
+                                                     std::move(app.updateId),
+                                                     std::move(appPrerequisites),
+                                                     std::move(app.files),
+                                                     content),
+                            m_reportingHandler);
+        contents.push_back(std::move(*content));
     }
 
-    std::unique_ptr<AppContent> content;
-    THROW_IF_FAILED_LOG(AppContent::Make(std::move(contentId),
-                                         std::move(appVersionEntity->updateId),
-                                         std::move(prerequisites),
-                                         std::move(files),
-                                         content),
-                        m_reportingHandler);
+    if (!uniquePrerequisites.empty())
+    {
+        LOG_INFO(m_reportingHandler,
+                 "Getting download info for %zu unique prerequisites in the background",
+                 prerequisites.size());
+
+        // The memory resource is only valid during this call
+        RequestParams backgroundParams = requestParams;
+        backgroundParams.memoryResource = nullptr;
+
+        auto contentIds = std::make_shared<std::vector<std::unique_ptr<ContentId>>>(std::move(uniquePrerequisites));
+        StartDeferredTask(
+            [this, params = std::move(backgroundParams), filter = std::move(filter), contentIds, promises] {
+                try
+                {
+                    ThrowIfDeferredTasksCancelled();
+                    const auto backgroundConnection = MakeConnection(ConnectionConfig(params));
+
+                    // A cancellation thrown from the callbacks stops the other workers
+                    ForEachPrerequisite(
+                        std::move(*contentIds),
+                        params,
+                        filter,
+                        *backgroundConnection,
+                        [&](size_t index, AppPrerequisiteContent&& prerequisite) {
+                            ThrowIfDeferredTasksCancelled();
+                            (*promises)[index].set_value(std::move(prerequisite));
+                        },
+                        [&](size_t index, std::exception_ptr error) {
+                            ThrowIfDeferredTasksCancelled();
+                            (*promises)[index].set_exception(error);
+                        });
+                }
+                catch (...)
+                {
+                    FailUnsetPromises(*promises, std::current_exception());
+                }
+            },
+            [promises] {
+                FailUnsetPromises(
+                    *promises,
+                    std::make_exception_ptr(SFSException(Result::Cancelled, c_deferredTaskCancelledMessage)));
+            });
+    }
 
-    std::vector<AppContent> contents;
-    contents.push_back(std::move(*content));
+    return contents;
+}
+SFS_CATCH_LOG_RETHROW(m_reportingHandler)
+
+template <typename ConnectionManagerT>
+void SFSClientImpl<ConnectionManagerT>::StartDeferredTask(std::function<void()>&& run,
+                                                          std::function<void()>&& cancel) const
+{
+    {
+        std::lock_guard guard(m_deferredTasksMutex);
+        if (!m_deferredTaskThread.joinable())
+        {
+            m_deferredTaskThread = std::thread(&SFSClientImpl::RunDeferredTasks, this);
+        }
+        m_deferredTasks.push_back({std::move(run), std::move(cancel)});
+    }
+    m_deferredTasksCv.notify_one();
+}
+
+template <typename ConnectionManagerT>
+void SFSClientImpl<ConnectionManagerT>::RunDeferredTasks() const
+{
+    std::unique_lock lock(m_deferredTasksMutex);
+    while (true)
+    {
+        m_deferredTasksCv.wait(lock, [&] { return m_cancelDeferredTasks || !m_deferredTasks.empty(); });
+        if (m_cancelDeferredTasks)
+        {
+            break;
+        }
+
+        auto task = std::move(m_deferredTasks.front());
+        m_deferredTasks.pop_front();
+
+        // Destruction waits on the mutex, so it is released while the task runs
+        lock.unlock();
+        task.run();
+        lock.lock();
+    }
+}
+
+template <typename ConnectionManagerT>
+void SFSClientImpl<ConnectionManagerT>::ThrowIfDeferredTasksCancelled() const
+{
+    if (m_cancelDeferredTasks)
+    {
+        throw SFSException(Result::Cancelled, c_deferredTaskCancelledMessage);
+    }
+}
+
+template <typename ConnectionManagerT>
+std::vector<Content> SFSClientImpl<ConnectionManagerT>::GetLatestDownloadInfoIfUpdated(
+    const RequestParams& requestParams,
+    const ProductVersions& currentVersions) const
+try
+{
+    ValidateMultiProductRequestParams(requestParams, m_reportingHandler);
+
+    ScopedRequestMemoryResource scopedResource(requestParams.memoryResource);
+
+    const auto connection = MakeConnection(ConnectionConfig(requestParams));
+
+    auto versionEntities = GetLatestVersions(requestParams, *connection);
+
+    std::vector<Content> contents;
+    std::unordered_set<std::string> handledProducts;
+    for (auto& versionEntity : versionEntities)
+    {
+        auto contentId = ToPooledContentId(m_stringPool.get(), std::move(GetBase(versionEntity)), m_reportingHandler);
+
+        // The service returns the product name in the content id, and it was validated to match a requested product
+        const std::string& product = contentId->GetName();
+        if (!handledProducts.insert(product).second)
+        {
+            continue;
+        }
+
+        const auto currentVersion = currentVersions.find(product);
+        if (currentVersion != currentVersions.end() && currentVersion->second == contentId->GetVersion())
+        {
+            LOG_INFO(m_reportingHandler,
+                     "Product [%s] is up to date with version [%s]",
+                     LogArg("product", product),
+                     LogArg("version", contentId->GetVersion()));
+            continue;
+        }
+
+        auto files = GetFiles(product, contentId->GetVersion(), *connection);
+
+        std::unique_ptr<Content> content;
+        THROW_IF_FAILED_LOG(Content::Make(std::move(contentId), std::move(files), content), m_reportingHandler);
+        contents.push_back(std::move(*content));
+    }
+
+    LOG_INFO(m_reportingHandler,
+             "%zu of %zu products are out of date",
+             contents.size(),
+             handledProducts.size());
 
     return contents;
 }
 SFS_CATCH_LOG_RETHROW(m_reportingHandler)
 
+template <typename ConnectionManagerT>
+void SFSClientImpl<ConnectionManagerT>::StreamLatestDownloadInfo(const RequestParams& requestParams,
+                                                                 const FileCallbackFn& onFile) const
+try
+{
+    ValidateRequestParams(requestParams, m_reportingHandler);
+    THROW_CODE_IF_LOG(InvalidArg, !onFile, m_reportingHandler, "onFile must not be empty");
+
+    ScopedRequestMemoryResource scopedResource(requestParams.memoryResource);
+
+    const auto connection = MakeConnection(ConnectionConfig(requestParams));
+
+    auto versionEntity = GetLatestVersion(requestParams.productRequests[0], *connection);
+    auto contentId = ToPooledContentId(m_stringPool.get(), std::move(GetBase(versionEntity)), m_reportingHandler);
+
+    const auto& product = requestParams.productRequests[0].product;
+    ForEachFile(product, contentId->GetVersion(), *connection, [&](File&& file) {
+        onFile(*contentId, std::move(file));
+    });
+}
+SFS_CATCH_LOG_RETHROW(m_reportingHandler)
+
+template <typename ConnectionManagerT>
+void SFSClientImpl<ConnectionManagerT>::StreamLatestAppDownloadInfo(const RequestParams& requestParams,
+                                                                    const AppFileCallbackFn& onFile) const
+try
+{
+    ValidateRequestParams(requestParams, m_reportingHandler);
+    ValidateAppInstanceId(m_instanceId, m_reportingHandler);
+    THROW_CODE_IF_LOG(InvalidArg, !onFile, m_reportingHandler, "onFile must not be empty");
+
+    ScopedRequestMemoryResource scopedResource(requestParams.memoryResource);
+
+    const auto connection = MakeConnection(ConnectionConfig(requestParams));
+
+    auto versionEntity = GetLatestVersion(requestParams.productRequests[0], *connection);
+
+    auto& appVersionEntity = GetAppVersionEntity(versionEntity, m_reportingHandler);
+    auto contentId = ToPooledContentId(m_stringPool.get(), std::move(appVersionEntity), m_reportingHandler);
+
+    const auto filter = AppFileFilter::Make(requestParams.applicabilityFilter);
+
+    auto deliverFilesOf = [&](const std::string& product, const ContentId& fileContentId) {
+        ForEachAppFile(product, fileContentId.GetVersion(), *connection, filter, [&](AppFile&& file) {
+            InternIfEnabled(m_stringPool.get(), file);
+            onFile(fileContentId, std::move(file));
+        });
+    };
+
+    LOG_INFO(m_reportingHandler, "Getting download info for main app content");
+    deliverFilesOf(requestParams.productRequests[0].product, *contentId);
+
+    for (auto& prereq : appVersionEntity.prerequisites)
+    {
+        LOG_INFO(m_reportingHandler,
+                 "Getting download info for prerequisite [%s]",
+                 LogArg("product", prereq.contentId.name));
+        auto prereqContentId = ToPooledContentId(m_stringPool.get(), std::move(prereq), m_reportingHandler);
+        deliverFilesOf(prereqContentId->GetName(), *prereqContentId);
+    }
+}
+SFS_CATCH_LOG_RETHROW(m_reportingHandler)
+
 template <typename ConnectionManagerT>
 std::unique_ptr<Connection> SFSClientImpl<ConnectionManagerT>::MakeConnection(const ConnectionConfig& config) const
 {
@@ -5,15 +5,26 @@
 
 #include "SFSClientInterface.h"
 
+#include "BatchSizer.h"
 #include "ClientConfig.h"
 #include "Content.h"
 #include "Logging.h"
 #include "Result.h"
 #include "SFSUrlBuilder.h"
+#include "StringPool.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace SFS::details
 {
@@ -22,7 +33,12 @@ class SFSClientImpl : public SFSClientInterface
 {
   public:
     SFSClientImpl(ClientConfig&& config);
-    ~SFSClientImpl() override = default;
+
+    /**
+     * @brief Cancels the deferred prerequisites that are still being retrieved
+     * @details Only waits for the requests that are already in flight
+     */
+    ~SFSClientImpl() override;
 
     //
     // Combined API calls for retrieval of metadata & download URLs
@@ -37,10 +53,45 @@ class SFSClientImpl : public SFSClientInterface
 
     /**
      * @brief Retrieve combined metadata & download URLs from the latest version of specified apps
+     * @details Uses GetLatestVersions() to get the latest version of the apps. Prerequisites shared by the apps are
+     * only requested once, and their AppPrerequisiteContent is shared by the returned contents
+     * @param requestParams Parameters that define this request. Multiple products are supported
+     */
+    std::vector<AppContent> GetLatestAppDownloadInfo(const RequestParams& requestParams) const override;
+
+    /**
+     * @brief Retrieve combined metadata & download URLs from the latest version of specified apps, returning before
+     * the download info of their prerequisites is retrieved
+     * @details The prerequisites are retrieved by a background task, see StartDeferredTask()
+     * @param requestParams Parameters that define this request. Multiple products are supported
+     */
+    std::vector<DeferredAppContent> GetLatestAppDownloadInfoDeferred(const RequestParams& requestParams) const override;
+
+    /**
+     * @brief Retrieve combined metadata & download URLs from the latest version of specified products, only for the
+     * ones whose latest version differs from @param currentVersions
+     * @details Uses GetLatestVersions() to get the latest version of the products
+     * @param requestParams Parameters that define this request. Multiple products are supported
+     */
+    std::vector<Content> GetLatestDownloadInfoIfUpdated(const RequestParams& requestParams,
+                                                        const ProductVersions& currentVersions) const override;
+
+    /**
+     * @brief Retrieve download URLs from the latest version of specified products, calling @param onFile with each
+     * file as soon as it is received
      * @note At the moment only a single product request is supported
      * @param requestParams Parameters that define this request
      */
-    std::vector<AppContent> GetLatestAppDownloadInfo(const RequestParams& requestParams) const override;
+    void StreamLatestDownloadInfo(const RequestParams& requestParams, const FileCallbackFn& onFile) const override;
+
+    /**
+     * @brief Retrieve download URLs from the latest version of specified apps and their prerequisites, calling
+     * @param onFile with each file as soon as it is received
+     * @note At the moment only a single product request is supported
+     * @param requestParams Parameters that define this request
+     */
+    void StreamLatestAppDownloadInfo(const RequestParams& requestParams,
+                                     const AppFileCallbackFn& onFile) const override;
 
     //
     // Individual APIs 1:1 with service endpoints (SFSClientInterface)
@@ -51,8 +102,7 @@ class SFSClientImpl : public SFSClientInterface
      * @return Entity that describes the latest version of the product
      * @throws SFSException if the request fails
      */
-    std::unique_ptr<VersionEntity> GetLatestVersion(const ProductRequest& productRequest,
-                                                    Connection& connection) const override;
+    VersionEntity GetLatestVersion(const ProductRequest& productRequest, Connection& connection) const override;
 
     /**
      * @brief Gets the metadata for the latest available version for the specified product requests
@@ -67,9 +117,9 @@ class SFSClientImpl : public SFSClientInterface
      * @return Entity that describes the latest version of the product
      * @throws SFSException if the request fails
      */
-    std::unique_ptr<VersionEntity> GetSpecificVersion(const std::string& product,
-                                                      const std::string& version,
-                                                      Connection& connection) const override;
+    VersionEntity GetSpecificVersion(const std::string& product,
+                                     const std::string& version,
+                                     Connection& connection) const override;
 
     /**
      * @brief Gets the files metadata for a specific version of the specified product
@@ -103,12 +153,149 @@ class SFSClientImpl : public SFSClientInterface
     SFSUrlBuilder MakeUrlBuilder() const;
 
   private:
+    /**
+     * @brief Logs the download info request and sets up @param connection for it
+     * @return The URL of the request
+     */
+    std::string SetUpDownloadInfoRequest(const std::string& product,
+                                         const std::string& version,
+                                         Connection& connection) const;
+
+    /**
+     * @brief Calls @param onFile with each file of a specific version of the specified product
+     * @details Unlike GetDownloadInfo(), each File is built directly from the response as it is received, without
+     * going through FileEntities, and handed to @param onFile before the next one is parsed
+     * @throws SFSException if the request fails
+     */
+    void ForEachFile(const std::string& product,
+                     const std::string& version,
+                     Connection& connection,
+                     const std::function<void(File&&)>& onFile) const;
+
+    /**
+     * @brief Calls @param onFile with each app file of a specific version of the specified product
+     * @details Unlike GetDownloadInfo(), each AppFile is built directly from the response as it is received, without
+     * going through FileEntities, and handed to @param onFile before the next one is parsed. Files that don't match
+     * @param filter are dropped before being built
+     * @throws SFSException if the request fails
+     */
+    void ForEachAppFile(const std::string& product,
+                        const std::string& version,
+                        Connection& connection,
+                        const std::optional<AppFileFilter>& filter,
+                        const std::function<void(AppFile&&)>& onFile) const;
+
+    /**
+     * @brief Gets the files for a specific version of the specified product
+     * @details See ForEachFile()
+     * @throws SFSException if the request fails
+     */
+    std::vector<File> GetFiles(const std::string& product, const std::string& version, Connection& connection) const;
+
+    /**
+     * @brief Gets the app files for a specific version of the specified product
+     * @details See ForEachAppFile()
+     * @throws SFSException if the request fails
+     */
+    std::vector<AppFile> GetAppFiles(const std::string& product,
+                                     const std::string& version,
+                                     Connection& connection,
+                                     const std::optional<AppFileFilter>& filter) const;
+
+    /**
+     * @brief Same as GetLatestVersionBatch(), also setting @param responseSize to the size of the response body
+     */
+    VersionEntities PostLatestVersionBatch(const std::vector<ProductRequest>& productRequests,
+                                           Connection& connection,
+                                           size_t& responseSize) const;
+
+    /**
+     * @brief Gets the metadata for the latest available version of the products in @param requestParams
+     * @details Products requested more than once, always with the same attributes, are only sent once. Multiple
+     * products are split into batches sized by m_batchSizer, and up to c_maxConcurrentBatchRequests batches are sent at
+     * once. The calling thread uses @param connection, and each other thread uses a new connection made from
+     * @param requestParams
+     * @return Vector of entities that describe the latest version of the products, in the order they were requested
+     * @throws SFSException if the request fails
+     */
+    VersionEntities GetLatestVersions(const RequestParams& requestParams, Connection& connection) const;
+
+    struct LatestApp
+    {
+        std::unique_ptr<ContentId> contentId;
+        std::string updateId;
+        std::vector<AppFile> files;
+        std::vector<size_t> prerequisites; // Indexes of the prerequisites listed by GetLatestApps()
+    };
+
+    /**
+     * @brief Gets the latest version and the files of the apps in @param requestParams
+     * @param apps Receives each app, once even if requested multiple times
+     * @param prerequisites Receives the prerequisites of the apps, once even if shared by multiple apps
+     * @throws SFSException if the request fails
+     */
+    void GetLatestApps(const RequestParams& requestParams,
+                       const std::optional<AppFileFilter>& filter,
+                       Connection& connection,
+                       std::vector<LatestApp>& apps,
+                       std::vector<std::unique_ptr<ContentId>>& prerequisites) const;
+
+    /**
+     * @brief Gets the app prerequisites identified by @param contentIds, calling @param onPrerequisite with each one
+     * and its index as soon as it is retrieved
+     * @details Up to c_maxConcurrentPrerequisiteRequests prerequisites are requested at once. The calling thread uses
+     * @param connection, and each other thread uses a new connection made from @param requestParams. If getting a
+     * prerequisite fails, @param onError is called with the failure. If it throws, the remaining prerequisites are
+     * skipped and the first exception is rethrown once all threads are done
+     */
+    void ForEachPrerequisite(std::vector<std::unique_ptr<ContentId>>&& contentIds,
+                             const RequestParams& requestParams,
+                             const std::optional<AppFileFilter>& filter,
+                             Connection& connection,
+                             const std::function<void(size_t, AppPrerequisiteContent&&)>& onPrerequisite,
+                             const std::function<void(size_t, std::exception_ptr)>& onError) const;
+
+    /**
+     * @brief Queues @param run to be called on the deferred task thread, which is started on first use
+     * @details The tasks run one at a time, in order. When this object is destroyed, @param cancel is called instead
+     * of @param run for the tasks that didn't start, and the running one is expected to stop at the next call to
+     * ThrowIfDeferredTasksCancelled(). Neither function may throw
+     */
+    void StartDeferredTask(std::function<void()>&& run, std::function<void()>&& cancel) const;
+
+    void RunDeferredTasks() const;
+
+    /**
+     * @throws SFSException with Result::Cancelled once this object is being destroyed
+     */
+    void ThrowIfDeferredTasksCancelled() const;
+
     std::string m_accountId;
     std::string m_instanceId;
     std::string m_nameSpace;
 
+    ResponseSizeLimits m_responseSizeLimits;
+
     std::unique_ptr<ConnectionManagerT> m_connectionManager;
 
+    // Shares repeated strings between results. Null if disabled through ClientConfig::maxInternedStrings
+    std::unique_ptr<StringPool> m_stringPool;
+
     std::optional<std::string> m_customBaseUrl;
+
+    // Tunes the size of the batches sent by GetLatestVersions() from the ones already sent
+    mutable BatchSizer m_batchSizer;
+
+    struct DeferredTask
+    {
+        std::function<void()> run;
+        std::function<void()> cancel;
+    };
+
+    mutable std::mutex m_deferredTasksMutex;
+    mutable std::condition_variable m_deferredTasksCv;
+    mutable std::deque<DeferredTask> m_deferredTasks;
+    mutable std::atomic<bool> m_cancelDeferredTasks{false};
+    mutable std::thread m_deferredTaskThread;
 };
 } // namespace SFS::details
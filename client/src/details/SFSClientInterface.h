@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include "AppContent.h"
+#include "Content.h"
+#include "DeferredAppContent.h"
 #include "Logging.h"
 #include "ReportingHandler.h"
 #include "RequestParams.h"
@@ -14,9 +17,6 @@
 
 namespace SFS
 {
-class AppContent;
-class Content;
-
 namespace details
 {
 class Connection;
@@ -43,10 +43,42 @@ class SFSClientInterface
 
     /**
      * @brief Retrieve combined metadata & download URLs from the latest version of specified apps
+     * @param requestParams Parameters that define this request. Multiple products are supported
+     */
+    virtual std::vector<AppContent> GetLatestAppDownloadInfo(const RequestParams& requestParams) const = 0;
+
+    /**
+     * @brief Retrieve combined metadata & download URLs from the latest version of specified apps, returning before
+     * the download info of their prerequisites is retrieved
+     * @param requestParams Parameters that define this request. Multiple products are supported
+     */
+    virtual std::vector<DeferredAppContent> GetLatestAppDownloadInfoDeferred(
+        const RequestParams& requestParams) const = 0;
+
+    /**
+     * @brief Retrieve combined metadata & download URLs from the latest version of specified products, only for the
+     * ones whose latest version differs from @param currentVersions
+     * @param requestParams Parameters that define this request. Multiple products are supported
+     */
+    virtual std::vector<Content> GetLatestDownloadInfoIfUpdated(const RequestParams& requestParams,
+                                                                const ProductVersions& currentVersions) const = 0;
+
+    /**
+     * @brief Retrieve download URLs from the latest version of specified products, calling @param onFile with each
+     * file as soon as it is received
      * @note At the moment only a single product request is supported
      * @param requestParams Parameters that define this request
      */
-    virtual std::vector<AppContent> GetLatestAppDownloadInfo(const RequestParams& requestParams) const = 0;
+    virtual void StreamLatestDownloadInfo(const RequestParams& requestParams, const FileCallbackFn& onFile) const = 0;
+
+    /**
+     * @brief Retrieve download URLs from the latest version of specified apps and their prerequisites, calling
+     * @param onFile with each file as soon as it is received
+     * @note At the moment only a single product request is supported
+     * @param requestParams Parameters that define this request
+     */
+    virtual void StreamLatestAppDownloadInfo(const RequestParams& requestParams,
+                                             const AppFileCallbackFn& onFile) const = 0;
 
     //
     // Individual APIs 1:1 with service endpoints
@@ -57,8 +89,7 @@ class SFSClientInterface
      * @return Entity that describes the latest version of the product
      * @throws SFSException if the request fails
      */
-    virtual std::unique_ptr<VersionEntity> GetLatestVersion(const ProductRequest& productRequest,
-                                                            Connection& connection) const = 0;
+    virtual VersionEntity GetLatestVersion(const ProductRequest& productRequest, Connection& connection) const = 0;
 
     /**
      * @brief Gets the metadata for the latest available version for the specified product requests
@@ -73,9 +104,9 @@ class SFSClientInterface
      * @return Entity that describes the latest version of the product
      * @throws SFSException if the request fails
      */
-    virtual std::unique_ptr<VersionEntity> GetSpecificVersion(const std::string& product,
-                                                              const std::string& version,
-                                                              Connection& connection) const = 0;
+    virtual VersionEntity GetSpecificVersion(const std::string& product,
+                                             const std::string& version,
+                                             Connection& connection) const = 0;
 
     /**
      * @brief Gets the files metadata for a specific version of the specified product
@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "StringPool.h"
+
+#include "AppFile.h"
+#include "ContentId.h"
+
+using namespace SFS;
+using namespace SFS::details;
+
+namespace
+{
+template <typename MapT>
+void EraseUnreferenced(MapT& map)
+{
+    for (auto it = map.begin(); it != map.end();)
+    {
+        // A count of 1 means only the pool holds the value. It can't go up concurrently since new references are only
+        // handed out by the pool under its lock
+        it = it->second.use_count() == 1 ? map.erase(it) : std::next(it);
+    }
+}
+
+size_t Hash(const std::vector<std::string>& values)
+{
+    size_t hash = values.size();
+    for (const auto& value : values)
+    {
+        hash ^= std::hash<std::string_view>{}(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+} // namespace
+
+StringPool::StringPool(size_t maxEntries) : m_maxEntries(maxEntries)
+{
+}
+
+std::shared_ptr<const std::string> StringPool::Intern(std::string&& value)
+{
+    std::lock_guard guard(m_mutex);
+
+    if (auto it = m_strings.find(value); it != m_strings.end())
+    {
+        return it->second;
+    }
+
+    auto pooled = std::make_shared<const std::string>(std::move(value));
+    if (MakeRoom())
+    {
+        m_strings.emplace(*pooled, pooled);
+    }
+    return pooled;
+}
+
+std::shared_ptr<const std::vector<std::string>> StringPool::Intern(
+    std::shared_ptr<const std::vector<std::string>> values)
+{
+    const size_t hash = Hash(*values);
+
+    std::lock_guard guard(m_mutex);
+
+    for (auto [it, end] = m_lists.equal_range(hash); it != end; ++it)
+    {
+        if (*it->second == *values)
+        {
+            return it->second;
+        }
+    }
+
+    if (MakeRoom())
+    {
+        m_lists.emplace(hash, values);
+    }
+    return values;
+}
+
+std::unique_ptr<ContentId> StringPool::MakeContentId(std::string nameSpace, std::string name, std::string version)
+{
+    std::unique_ptr<ContentId> contentId(new ContentId());
+    contentId->m_nameSpace = Intern(std::move(nameSpace));
+    contentId->m_name = Intern(std::move(name));
+    contentId->m_version = std::move(version);
+    return contentId;
+}
+
+void StringPool::Intern(AppFile& file)
+{
+    auto& details = file.m_applicabilityDetails;
+    details.m_platformApplicabilityForPackage = Intern(std::move(details.m_platformApplicabilityForPackage));
+}
+
+size_t StringPool::Size() const
+{
+    std::lock_guard guard(m_mutex);
+    return m_strings.size() + m_lists.size();
+}
+
+bool StringPool::MakeRoom()
+{
+    if (m_strings.size() + m_lists.size() < m_maxEntries)
+    {
+        return true;
+    }
+
+    if (m_rejectionsBeforeSweep > 0)
+    {
+        --m_rejectionsBeforeSweep;
+        return false;
+    }
+
+    EraseUnreferenced(m_strings);
+    EraseUnreferenced(m_lists);
+
+    // The values left are still referenced, and likely to stay so for a while. Waiting for as many values to be turned
+    // away before searching again keeps the cost of the searches constant per interned value
+    m_rejectionsBeforeSweep = m_strings.size() + m_lists.size();
+
+    return m_rejectionsBeforeSweep < m_maxEntries;
+}
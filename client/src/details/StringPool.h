@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace SFS
+{
+class AppFile;
+class ContentId;
+
+namespace details
+{
+/**
+ * @brief Pool of immutable strings shared between the results of an SFSClient
+ * @details Namespaces, names and platform applicability values repeat across many ContentId and AppFile objects.
+ * Interning them makes those objects point to the same storage. The pool is safe to use from concurrent requests.
+ * It holds at most maxEntries values: when it is full, values no longer referenced by any result are dropped, and if
+ * that is not enough, new values are returned without being pooled. Since finding unreferenced values goes through
+ * the whole pool, the next search only happens once the pool is full again and as many values as the last search
+ * kept were turned away.
+ */
+class StringPool
+{
+  public:
+    explicit StringPool(size_t maxEntries);
+
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    /**
+     * @return The pooled value equal to @param value. If there is none, @param value is moved to new storage, which is
+     * pooled and returned
+     */
+    std::shared_ptr<const std::string> Intern(std::string&& value);
+
+    /**
+     * @return The pooled list equal to @param values. If there is none, @param values is pooled and returned
+     */
+    std::shared_ptr<const std::vector<std::string>> Intern(std::shared_ptr<const std::vector<std::string>> values);
+
+    /**
+     * @return A ContentId whose namespace and name point to pooled storage. Pooled values are looked up before any
+     * storage is made for them
+     */
+    std::unique_ptr<ContentId> MakeContentId(std::string nameSpace, std::string name, std::string version);
+
+    /**
+     * @brief Makes the platform applicability values of @param file point to pooled storage
+     */
+    void Intern(AppFile& file);
+
+    /**
+     * @return Number of values currently pooled
+     */
+    size_t Size() const;
+
+  private:
+    bool MakeRoom();
+
+    const size_t m_maxEntries;
+
+    mutable std::mutex m_mutex;
+
+    // Number of values still turned away before the pool is searched again for unreferenced values
+    size_t m_rejectionsBeforeSweep{0};
+
+    // Keys are views into the pooled values
+    std::unordered_map<std::string_view, std::shared_ptr<const std::string>> m_strings;
+
+    // Keys are hashes of the pooled lists, so looking a list up doesn't need a copy of it
+    std::unordered_multimap<size_t, std::shared_ptr<const std::vector<std::string>>> m_lists;
+};
+} // namespace details
+} // namespace SFS
@@ -8,6 +8,36 @@
 
 using namespace SFS::details;
 
+namespace
+{
+constexpr char c_base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+int Base64Value(char c) noexcept
+{
+    if (c >= 'A' && c <= 'Z')
+    {
+        return c - 'A';
+    }
+    if (c >= 'a' && c <= 'z')
+    {
+        return c - 'a' + 26;
+    }
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0' + 52;
+    }
+    if (c == '+')
+    {
+        return 62;
+    }
+    if (c == '/')
+    {
+        return 63;
+    }
+    return -1;
+}
+} // namespace
+
 bool util::AreEqualI(std::string_view a, std::string_view b)
 {
     return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](char a, char b) {
@@ -19,3 +49,81 @@ bool util::AreNotEqualI(std::string_view a, std::string_view b)
 {
     return !AreEqualI(a, b);
 }
+
+std::string util::Base64Encode(const uint8_t* data, size_t size)
+{
+    std::string encoded;
+    encoded.reserve(((size + 2) / 3) * 4);
+
+    size_t i = 0;
+    for (; i + 2 < size; i += 3)
+    {
+        const uint32_t group = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+        encoded += c_base64Alphabet[(group >> 18) & 0x3F];
+        encoded += c_base64Alphabet[(group >> 12) & 0x3F];
+        encoded += c_base64Alphabet[(group >> 6) & 0x3F];
+        encoded += c_base64Alphabet[group & 0x3F];
+    }
+
+    if (i < size)
+    {
+        const bool hasTwo = i + 1 < size;
+        const uint32_t group = (data[i] << 16) | (hasTwo ? data[i + 1] << 8 : 0);
+        encoded += c_base64Alphabet[(group >> 18) & 0x3F];
+        encoded += c_base64Alphabet[(group >> 12) & 0x3F];
+        encoded += hasTwo ? c_base64Alphabet[(group >> 6) & 0x3F] : '=';
+        encoded += '=';
+    }
+
+    return encoded;
+}
+
+bool util::Base64Decode(std::string_view encoded, uint8_t* out, size_t size) noexcept
+{
+    if (encoded.size() != ((size + 2) / 3) * 4)
+    {
+        return false;
+    }
+
+    const size_t padding = (3 - size % 3) % 3;
+    size_t written = 0;
+    for (size_t i = 0; i < encoded.size(); i += 4)
+    {
+        const bool isLast = i + 4 == encoded.size();
+        uint32_t group = 0;
+        for (size_t j = 0; j < 4; ++j)
+        {
+            const char c = encoded[i + j];
+            if (isLast && j >= 4 - padding)
+            {
+                if (c != '=')
+                {
+                    return false;
+                }
+                group <<= 6;
+                continue;
+            }
+
+            const int value = Base64Value(c);
+            if (value < 0)
+            {
+                return false;
+            }
+            group = (group << 6) | static_cast<uint32_t>(value);
+        }
+
+        const size_t bytes = isLast ? 3 - padding : 3;
+        for (size_t j = 0; j < bytes; ++j)
+        {
+            out[written++] = static_cast<uint8_t>(group >> (16 - 8 * j));
+        }
+
+        // Bits beyond the last byte must be zero, otherwise the encoding is not canonical
+        if (isLast && (group & ((1u << (8 * padding)) - 1)) != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
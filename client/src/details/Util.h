@@ -3,10 +3,25 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
 #include <string_view>
 
 namespace SFS::details::util
 {
 bool AreEqualI(std::string_view a, std::string_view b);
 bool AreNotEqualI(std::string_view a, std::string_view b);
+
+/**
+ * @return Padded base64 encoding of the @param size bytes in @param data
+ */
+std::string Base64Encode(const uint8_t* data, size_t size);
+
+/**
+ * @brief Decodes the padded base64 string @param encoded into exactly @param size bytes written to @param out
+ * @return false if @param encoded is not the canonical encoding of @param size bytes, in which case @param out is left
+ * in an unspecified state
+ */
+bool Base64Decode(std::string_view encoded, uint8_t* out, size_t size) noexcept;
 } // namespace SFS::details::util
@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "WatchSchedule.h"
+
+#include "Fingerprint.h"
+
+#include <algorithm>
+
+using namespace SFS::details;
+
+std::chrono::milliseconds SFS::details::JitterOffset(std::string_view deviceId, std::chrono::milliseconds interval)
+{
+    if (interval.count() <= 0)
+    {
+        return std::chrono::milliseconds::zero();
+    }
+
+    // The offset depends only on the device and the interval, so products with the same interval stay due together
+    const uint64_t hash = FingerprintBuilder().Add(deviceId).Finish().low;
+    return std::chrono::milliseconds(static_cast<std::chrono::milliseconds::rep>(
+        hash % static_cast<uint64_t>(interval.count())));
+}
+
+WatchSchedule::WatchSchedule(const std::vector<std::chrono::milliseconds>& intervals,
+                             std::string_view deviceId,
+                             Clock::time_point start,
+                             std::chrono::milliseconds batchWindow)
+    : m_batchWindow(std::max(batchWindow, std::chrono::milliseconds::zero()))
+{
+    m_entries.reserve(intervals.size());
+    for (const auto& interval : intervals)
+    {
+        m_entries.push_back({interval, start + JitterOffset(deviceId, interval)});
+    }
+}
+
+WatchSchedule::Clock::time_point WatchSchedule::NextDue() const
+{
+    if (m_entries.empty())
+    {
+        return Clock::time_point::max();
+    }
+    return std::min_element(m_entries.begin(),
+                            m_entries.end(),
+                            [](const Entry& a, const Entry& b) { return a.due < b.due; })
+        ->due;
+}
+
+std::vector<size_t> WatchSchedule::TakeDue(Clock::time_point now)
+{
+    std::vector<size_t> taken;
+    if (NextDue() > now)
+    {
+        return taken;
+    }
+
+    const auto limit = now + m_batchWindow;
+    for (size_t i = 0; i < m_entries.size(); ++i)
+    {
+        auto& entry = m_entries[i];
+        if (entry.due > limit)
+        {
+            continue;
+        }
+
+        taken.push_back(i);
+        if (entry.interval.count() <= 0)
+        {
+            entry.due = Clock::time_point::max();
+            continue;
+        }
+
+        entry.due += entry.interval;
+        if (entry.due <= now)
+        {
+            const auto missed = (now - entry.due) / entry.interval + 1;
+            entry.due += missed * entry.interval;
+        }
+    }
+    return taken;
+}
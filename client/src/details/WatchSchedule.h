@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <string_view>
+#include <vector>
+
+namespace SFS::details
+{
+/**
+ * @return A stable offset in [0, @param interval) derived from @param deviceId
+ * @details Used to spread the polls of many devices over the interval instead of having them all poll at once
+ */
+std::chrono::milliseconds JitterOffset(std::string_view deviceId, std::chrono::milliseconds interval);
+
+/**
+ * @brief Keeps track of when each of a set of watched products is due to be polled
+ * @details Each product is first due at its jitter offset from the start time, and then every poll interval. Not
+ * thread-safe.
+ */
+class WatchSchedule
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @param intervals The poll interval of each product, indexed like the products. Each must be greater than 0
+     * @param deviceId Identifies this device, see JitterOffset()
+     * @param start Time from which the products are scheduled
+     * @param batchWindow Products due within this time of the first due one are taken with it
+     */
+    WatchSchedule(const std::vector<std::chrono::milliseconds>& intervals,
+                  std::string_view deviceId,
+                  Clock::time_point start,
+                  std::chrono::milliseconds batchWindow);
+
+    /**
+     * @return The earliest time a product is due
+     */
+    Clock::time_point NextDue() const;
+
+    /**
+     * @brief Takes the products due at @param now, or within the batch window after it, and schedules their next poll
+     * @details The next poll is kept in phase with the first one. Polls missed while the caller wasn't checking are
+     * skipped rather than made in a row
+     * @return The indexes of the products taken, in ascending order. Empty if none is due
+     */
+    std::vector<size_t> TakeDue(Clock::time_point now);
+
+  private:
+    struct Entry
+    {
+        std::chrono::milliseconds interval;
+        Clock::time_point due;
+    };
+
+    std::vector<Entry> m_entries;
+    std::chrono::milliseconds m_batchWindow;
+};
+} // namespace SFS::details
@@ -3,6 +3,8 @@
 
 #include "Connection.h"
 
+#include <sstream>
+
 using namespace SFS;
 using namespace SFS::details;
 
@@ -13,9 +15,21 @@ Connection::Connection(const ConnectionConfig& config, const ReportingHandler& h
         m_cv = std::move(CorrelationVector(*config.baseCV, m_handler));
     }
     m_maxRetries = config.maxRetries;
+    m_compressRequestBody = config.compressRequestBody;
 }
 
 std::string Connection::Post(const std::string& url)
 {
     return Post(url, {});
 }
+
+void Connection::StreamingPost(const std::string& url, const std::string& data, const ResponseStreamHandler& handler)
+{
+    std::istringstream stream(Post(url, data));
+    handler(stream);
+}
+
+void Connection::SetMaxResponseSize(size_t maxResponseSize)
+{
+    m_maxResponseSize = maxResponseSize;
+}
@@ -4,14 +4,21 @@
 #pragma once
 
 #include "../CorrelationVector.h"
+#include "ClientConfig.h"
 #include "ConnectionConfig.h"
 
+#include <cstddef>
+#include <functional>
+#include <istream>
 #include <string>
 
 namespace SFS::details
 {
 class ReportingHandler;
 
+/// @brief Consumes the body of a successful response as it is received
+using ResponseStreamHandler = std::function<void(std::istream&)>;
+
 class Connection
 {
   public:
@@ -45,6 +52,24 @@ class Connection
      */
     std::string Post(const std::string& url);
 
+    /**
+     * @brief Perform a POST request to the given @param url with @param data as the request body, and hand the
+     * response body to @param handler as it is received
+     * @details Lets large responses be parsed while they are transferred, without holding the whole body in memory.
+     * The handler may be called from a different thread, and is only called for a successful response. Exceptions
+     * thrown by the handler are rethrown by this method. The default implementation calls the handler with the result
+     * of Post() once the transfer is complete.
+     * @throws SFSException if the request fails
+     */
+    virtual void StreamingPost(const std::string& url, const std::string& data, const ResponseStreamHandler& handler);
+
+    /**
+     * @brief Sets the maximum size in bytes of the response accepted for the next requests
+     * @details Requests whose response goes over this size fail. Defaults to c_defaultMaxResponseSize.
+     * Responses consumed through StreamingPost() may be bigger, as long as no more than this size is waiting to be read
+     */
+    void SetMaxResponseSize(size_t maxResponseSize);
+
   protected:
     const ReportingHandler& m_handler;
 
@@ -53,5 +78,11 @@ class Connection
 
     /// @brief Expected number of retries for a web request after a failed attempt
     unsigned m_maxRetries{3};
+
+    /// @brief Whether large request bodies should be sent gzip-compressed
+    bool m_compressRequestBody{false};
+
+    /// @brief Maximum size in bytes of the response accepted for a request
+    size_t m_maxResponseSize{c_defaultMaxResponseSize};
 };
 } // namespace SFS::details
@@ -3,6 +3,7 @@
 
 #include "ConnectionConfig.h"
 
+#include "ClientConfig.h"
 #include "RequestParams.h"
 
 using namespace SFS;
@@ -12,5 +13,11 @@ ConnectionConfig::ConnectionConfig(const SFS::RequestParams& requestParams)
     : maxRetries(requestParams.retryOnError ? c_maxRetries : 0)
     , baseCV(requestParams.baseCV)
     , proxy(requestParams.proxy)
+    , compressRequestBody(requestParams.compressRequestBody)
+{
+}
+
+ConnectionManagerConfig::ConnectionManagerConfig(const SFS::ClientConfig& clientConfig)
+    : maxStreamsPerConnection(clientConfig.maxStreamsPerConnection)
 {
 }
@@ -8,6 +8,7 @@
 
 namespace SFS
 {
+struct ClientConfig;
 struct RequestParams;
 
 namespace details
@@ -25,6 +26,18 @@ struct ConnectionConfig
 
     /// @brief Proxy setting which can be used to establish connections with the server
     std::optional<std::string> proxy;
+
+    /// @brief Whether large request bodies should be sent gzip-compressed
+    bool compressRequestBody{false};
+};
+
+struct ConnectionManagerConfig
+{
+    ConnectionManagerConfig() = default;
+    explicit ConnectionManagerConfig(const ClientConfig& clientConfig);
+
+    /// @brief Maximum number of concurrent HTTP/2 streams over a single connection. 0 disables multiplexing
+    unsigned maxStreamsPerConnection{0};
 };
 } // namespace details
 } // namespace SFS
@@ -3,18 +3,19 @@
 
 #pragma once
 
+#include "ConnectionConfig.h"
+
 #include <memory>
 
 namespace SFS::details
 {
 class Connection;
 class ReportingHandler;
-struct ConnectionConfig;
 
 class ConnectionManager
 {
   public:
-    ConnectionManager(const ReportingHandler& handler);
+    ConnectionManager(const ReportingHandler& handler, const ConnectionManagerConfig& config = {});
     virtual ~ConnectionManager();
 
     ConnectionManager(const ConnectionManager&) = delete;
@@ -24,5 +25,6 @@ class ConnectionManager
 
   protected:
     const ReportingHandler& m_handler;
+    const ConnectionManagerConfig m_config;
 };
 } // namespace SFS::details
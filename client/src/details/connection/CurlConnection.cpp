@@ -6,12 +6,19 @@
 #include "../ErrorHandling.h"
 #include "../ReportingHandler.h"
 #include "../TestOverride.h"
+#include "CurlMultiplexer.h"
 #include "HttpHeader.h"
+#include "ResponseStreamBuffer.h"
 
 #include <curl/curl.h>
+#include <zlib.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstring>
+#include <exception>
+#include <future>
+#include <istream>
 #include <optional>
 #include <thread>
 
@@ -26,8 +33,8 @@
 #define THROW_IF_CURL_SETUP_ERROR(curlCall) THROW_IF_CURL_ERROR(curlCall, ConnectionSetupFailed)
 #define THROW_IF_CURL_UNEXPECTED_ERROR(curlCall) THROW_IF_CURL_ERROR(curlCall, ConnectionUnexpectedError)
 
-// Setting a hard limit of 100k characters for the response to avoid rogue servers sending huge amounts of data
-#define MAX_RESPONSE_CHARACTERS 100000
+// Request bodies smaller than this are not worth the gzip overhead
+#define MIN_BODY_SIZE_TO_COMPRESS 1024
 
 using namespace SFS;
 using namespace SFS::details;
@@ -35,29 +42,160 @@ using namespace std::chrono_literals;
 
 namespace
 {
-// Curl callback for writing data to a std::string. Must return the number of bytes written.
+// The size limit of a response applies both to the bytes received over the wire and to the decompressed body, so
+// compression can't be used to inflate the response beyond the limit
+struct ResponseBuffer
+{
+    CURL* handle;
+
+    /// @brief Maximum size in bytes accepted for the response
+    size_t maxSize;
+
+    /// @brief The decompressed response body
+    std::string data;
+
+    /// @brief Set when the transfer was aborted because the response went over the size limit
+    bool sizeLimitExceeded{false};
+
+    /// @brief When set, the body of a successful response is written to it instead of to data, and the size limit
+    /// only applies to the bytes not yet read from it. Points to the buffer of the streaming attempt in progress
+    ResponseStreamBuffer* stream{nullptr};
+
+    /// @brief Whether the response being received is written to stream. Checked on the first write of each attempt
+    std::optional<bool> isStreamingResponse;
+};
+
+// Content-Length is the size of the response over the wire, so a response announcing more than the size limit is
+// rejected before any of its body is buffered. Otherwise, its size is reserved upfront, which the size limit bounds, to
+// avoid reallocations while appending it. If the response is compressed, Content-Length is still a good lower bound
+// for the buffer.
+// Returns false if the response goes over the size limit
+bool ReserveFromContentLength(ResponseBuffer& readBuffer)
+{
+    curl_off_t contentLength = -1;
+    if (curl_easy_getinfo(readBuffer.handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &contentLength) != CURLE_OK ||
+        contentLength <= 0)
+    {
+        return true;
+    }
+
+    if (static_cast<uint64_t>(contentLength) > readBuffer.maxSize)
+    {
+        return false;
+    }
+
+    readBuffer.data.reserve(std::min(static_cast<size_t>(contentLength), readBuffer.maxSize));
+    return true;
+}
+
+// Only the body of a successful response is streamed. Other responses are only inspected for their status code and
+// headers, so their body is dropped. Returns the value for WriteCallback to return
+size_t WriteToStream(ResponseBuffer& readBuffer, const char* contents, size_t size)
+{
+    if (!readBuffer.isStreamingResponse)
+    {
+        long httpCode = 0;
+        curl_easy_getinfo(readBuffer.handle, CURLINFO_RESPONSE_CODE, &httpCode);
+        readBuffer.isStreamingResponse = httpCode == 200;
+    }
+
+    if (!*readBuffer.isStreamingResponse)
+    {
+        return size;
+    }
+
+    // Pauses the transfer until the reader catches up if too much data is pending. Curl keeps the data, and writes it
+    // again once the transfer is resumed
+    switch (readBuffer.stream->Write(contents, size))
+    {
+    case ResponseStreamBuffer::WriteResult::Written:
+        return size;
+    case ResponseStreamBuffer::WriteResult::Full:
+        return CURL_WRITEFUNC_PAUSE;
+    case ResponseStreamBuffer::WriteResult::ReaderFailed:
+        break;
+    }
+    return CURL_WRITEFUNC_ERROR;
+}
+
+// Curl callback for writing data to a ResponseBuffer. Must return the number of bytes written.
 // This callback may be called multiple times for a single request, and will keep appending
-// to userData until the request is complete. The data received is not null-terminated.
+// to userData until the request is complete. The data received is not null-terminated and is already decompressed
+// if the server used one of the encodings negotiated through CURLOPT_ACCEPT_ENCODING.
 // For SFS, this data will likely be a JSON string.
 size_t WriteCallback(char* contents, size_t sizeInBytes, size_t numElements, void* userData)
 {
-    auto readBufferPtr = static_cast<std::string*>(userData);
-    if (readBufferPtr)
+    auto readBufferPtr = static_cast<ResponseBuffer*>(userData);
+    if (readBufferPtr && readBufferPtr->stream)
+    {
+        return WriteToStream(*readBufferPtr, contents, sizeInBytes * numElements);
+    }
+    else if (readBufferPtr)
     {
         size_t totalSize = sizeInBytes * numElements;
 
         // Checking final response size to avoid unexpected amounts of data
-        if ((readBufferPtr->length() + totalSize) > MAX_RESPONSE_CHARACTERS)
+        if ((readBufferPtr->data.length() + totalSize) > readBufferPtr->maxSize ||
+            (readBufferPtr->data.empty() && !ReserveFromContentLength(*readBufferPtr)))
         {
+            readBufferPtr->sizeLimitExceeded = true;
             return CURL_WRITEFUNC_ERROR;
         }
 
-        readBufferPtr->append(contents, totalSize);
+        readBufferPtr->data.append(contents, totalSize);
         return totalSize;
     }
     return CURL_WRITEFUNC_ERROR;
 }
 
+// Curl callback for transfer progress. Returning a non-zero value aborts the transfer.
+// downloadedNow counts the bytes received over the wire, before any decompression, so this enforces the size limit
+// on the compressed response.
+int ProgressCallback(void* userData,
+                     curl_off_t /*downloadTotal*/,
+                     curl_off_t downloadedNow,
+                     curl_off_t /*uploadTotal*/,
+                     curl_off_t /*uploadedNow*/)
+{
+    auto readBufferPtr = static_cast<ResponseBuffer*>(userData);
+    if (readBufferPtr && !readBufferPtr->stream && static_cast<size_t>(downloadedNow) > readBufferPtr->maxSize)
+    {
+        readBufferPtr->sizeLimitExceeded = true;
+        return 1;
+    }
+    return 0;
+}
+
+std::string GzipCompress(const std::string& data, const ReportingHandler& handler)
+{
+    z_stream stream{};
+
+    // Adding 16 to the default window bits makes zlib write a gzip header and trailer instead of a zlib one
+    const int gzipWindowBits = 15 + 16;
+    const int defaultMemLevel = 8;
+    THROW_CODE_IF_NOT_LOG(
+        ConnectionSetupFailed,
+        deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, gzipWindowBits, defaultMemLevel, Z_DEFAULT_STRATEGY) ==
+            Z_OK,
+        handler,
+        "Failed to initialize gzip compression");
+
+    std::string compressed(deflateBound(&stream, static_cast<uLong>(data.size())), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+    stream.avail_out = static_cast<uInt>(compressed.size());
+
+    // The output buffer is big enough for the whole input, so a single call must finish the stream
+    const int ret = deflate(&stream, Z_FINISH);
+    compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    THROW_CODE_IF_NOT_LOG(ConnectionSetupFailed, ret == Z_STREAM_END, handler, "Failed to gzip-compress request body");
+
+    return compressed;
+}
+
 struct CurlErrorBuffer
 {
   public:
@@ -239,6 +377,66 @@ std::chrono::milliseconds ParseRetryAfterValue(const std::string& retryAfter, co
     }
     return retryAfterSec;
 }
+
+// Performs one attempt of a streaming request. The transfer runs on the thread of @param multiplexer, and is paused
+// whenever the reader falls behind, while the body of a successful response is handed to @param handler on the calling
+// thread as it arrives. An exception thrown by the handler is stored in @param handlerError, unless it comes from the
+// transfer being aborted, in which case the failure of the transfer is the meaningful one
+CURLcode PerformStreamingAttempt(CurlMultiplexer& multiplexer,
+                                 ResponseBuffer& readBuffer,
+                                 const ResponseStreamHandler& handler,
+                                 std::exception_ptr& handlerError)
+{
+    // Only the data not yet consumed by the handler counts towards the size limit, so the response can be bigger
+    ResponseStreamBuffer stream(readBuffer.maxSize, [&] { multiplexer.Resume(readBuffer.handle); });
+    readBuffer.stream = &stream;
+
+    std::promise<CURLcode> done;
+    auto transferResult = done.get_future();
+    multiplexer.Start(readBuffer.handle, [&](CURLcode result) {
+        if (result == CURLE_OK)
+        {
+            stream.Close();
+        }
+        else
+        {
+            stream.Abort();
+        }
+        done.set_value(result);
+    });
+
+    // The handler is only called for a successful response, which is known once its body arrives or the transfer ends
+    std::optional<CURLcode> result;
+    if (!stream.WaitForData())
+    {
+        result = transferResult.get();
+
+        long httpCode = 0;
+        curl_easy_getinfo(readBuffer.handle, CURLINFO_RESPONSE_CODE, &httpCode);
+        if (*result != CURLE_OK || !IsSuccessfulSFSHttpCode(httpCode))
+        {
+            return *result;
+        }
+    }
+
+    std::istream input(&stream);
+    try
+    {
+        handler(input);
+        stream.StopReading(false /*failed*/);
+    }
+    catch (...)
+    {
+        if (!stream.IsAborted())
+        {
+            handlerError = std::current_exception();
+        }
+        stream.StopReading(true /*failed*/);
+    }
+
+    // The stream must outlive the transfer
+    return result ? *result : transferResult.get();
+}
 } // namespace
 
 namespace SFS::details
@@ -271,8 +469,13 @@ struct CurlHeaderList
 };
 } // namespace SFS::details
 
-CurlConnection::CurlConnection(const ConnectionConfig& config, const ReportingHandler& handler)
+CurlConnection::CurlConnection(const ConnectionConfig& config,
+                               const ReportingHandler& handler,
+                               CurlMultiplexer* multiplexer,
+                               CurlMultiplexer* streamingMultiplexer)
     : Connection(config, handler)
+    , m_multiplexer(multiplexer)
+    , m_streamingMultiplexer(streamingMultiplexer)
 {
     m_handle = curl_easy_init();
     THROW_CODE_IF_NOT_LOG(ConnectionSetupFailed, m_handle, m_handler, "Failed to init curl connection");
@@ -289,6 +492,18 @@ CurlConnection::CurlConnection(const ConnectionConfig& config, const ReportingHa
         THROW_IF_CURL_SETUP_ERROR(curl_easy_setopt(m_handle, CURLOPT_PROXY, config.proxy->c_str()));
     }
 
+    // Let the server compress the response with any of the encodings supported by this build of curl.
+    // Responses are transparently decompressed before reaching WriteCallback
+    THROW_IF_CURL_SETUP_ERROR(curl_easy_setopt(m_handle, CURLOPT_ACCEPT_ENCODING, ""));
+
+    if (m_multiplexer)
+    {
+        // Negotiate HTTP/2 over TLS, and wait for an existing connection to the host to become available for
+        // multiplexing rather than opening a new one
+        THROW_IF_CURL_SETUP_ERROR(curl_easy_setopt(m_handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS));
+        THROW_IF_CURL_SETUP_ERROR(curl_easy_setopt(m_handle, CURLOPT_PIPEWAIT, 1L));
+    }
+
     // TODO #41: Pass AAD token in the header if it is available
     // TODO #42: Cert pinning with service
 }
@@ -316,18 +531,62 @@ std::string CurlConnection::Post(const std::string& url, const std::string& data
 {
     THROW_CODE_IF_LOG(InvalidArg, url.empty(), m_handler, "url cannot be empty");
 
-    CurlHeaderList headerList;
-    headerList.Add(HttpHeader::ContentType, "application/json");
+    CurlHeaderList headers;
+    SetUpPostBody(data, headers);
+    return CurlPerform(url, headers);
+}
 
-    THROW_IF_CURL_SETUP_ERROR(curl_easy_setopt(m_handle, CURLOPT_POST, 1L));
-    THROW_IF_CURL_SETUP_ERROR(curl_easy_setopt(m_handle, CURLOPT_COPYPOSTFIELDS, data.c_str()));
+void CurlConnection::StreamingPost(const std::string& url,
+                                   const std::string& data,
+                                   const ResponseStreamHandler& handler)
+{
+    THROW_CODE_IF_LOG(InvalidArg, url.empty(), m_handler, "url cannot be empty");
+
+    if (!GetStreamingMultiplexer())
+    {
+        Connection::StreamingPost(url, data, handler);
+        return;
+    }
 
     CurlHeaderList headers;
+    SetUpPostBody(data, headers);
+    Perform(url, headers, &handler);
+}
+
+void CurlConnection::SetUpPostBody(const std::string& data, CurlHeaderList& headers)
+{
     headers.Add(HttpHeader::ContentType, "application/json");
-    return CurlPerform(url, headers);
+
+    std::string compressedData;
+    const bool compress = m_compressRequestBody && data.size() >= MIN_BODY_SIZE_TO_COMPRESS;
+    if (compress)
+    {
+        compressedData = GzipCompress(data, m_handler);
+        headers.Add(HttpHeader::ContentEncoding, "gzip");
+        LOG_VERBOSE(m_handler, "Compressed request body from %zu to %zu bytes", data.size(), compressedData.size());
+    }
+    const std::string& body = compress ? compressedData : data;
+
+    // The size must be set before the data since a compressed body may contain null characters
+    THROW_IF_CURL_SETUP_ERROR(curl_easy_setopt(m_handle, CURLOPT_POST, 1L));
+    THROW_IF_CURL_SETUP_ERROR(
+        curl_easy_setopt(m_handle, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(body.size())));
+    THROW_IF_CURL_SETUP_ERROR(curl_easy_setopt(m_handle, CURLOPT_COPYPOSTFIELDS, body.data()));
 }
 
 std::string CurlConnection::CurlPerform(const std::string& url, CurlHeaderList& headers)
+{
+    return Perform(url, headers, nullptr /*handler*/);
+}
+
+CurlMultiplexer* CurlConnection::GetStreamingMultiplexer() const
+{
+    return m_multiplexer ? m_multiplexer : m_streamingMultiplexer;
+}
+
+std::string CurlConnection::Perform(const std::string& url,
+                                    CurlHeaderList& headers,
+                                    const ResponseStreamHandler* handler)
 {
     THROW_IF_CURL_SETUP_ERROR(curl_easy_setopt(m_handle, CURLOPT_URL, url.c_str()));
 
@@ -340,25 +599,55 @@ std::string CurlConnection::CurlPerform(const std::string& url, CurlHeaderList&
     // Setting up error buffer where error messages get written - this gets unset in the destructor
     CurlErrorBuffer errorBuffer(m_handle, m_handler);
 
-    std::string readBuffer;
+    ResponseBuffer readBuffer{m_handle, m_maxResponseSize, {}, false, nullptr, std::nullopt};
     THROW_IF_CURL_SETUP_ERROR(curl_easy_setopt(m_handle, CURLOPT_WRITEFUNCTION, WriteCallback));
     THROW_IF_CURL_SETUP_ERROR(curl_easy_setopt(m_handle, CURLOPT_WRITEDATA, &readBuffer));
+    THROW_IF_CURL_SETUP_ERROR(curl_easy_setopt(m_handle, CURLOPT_XFERINFOFUNCTION, ProgressCallback));
+    THROW_IF_CURL_SETUP_ERROR(curl_easy_setopt(m_handle, CURLOPT_XFERINFODATA, &readBuffer));
+    THROW_IF_CURL_SETUP_ERROR(curl_easy_setopt(m_handle, CURLOPT_NOPROGRESS, 0L));
 
     // Retry the connection a specified number of times
     const unsigned totalAttempts = 1 + m_maxRetries;
     for (unsigned i = 0; i < totalAttempts; i++)
     {
         const unsigned attempt = i + 1;
-        LOG_INFO(m_handler, "Request attempt %u out of %u (cv: %s)", attempt, totalAttempts, cv.c_str());
+        LOG_INFO(m_handler,
+                 "Request attempt %u out of %u (cv: %s)",
+                 LogArg("attempt", attempt),
+                 LogArg("totalAttempts", totalAttempts),
+                 LogArg("cv", cv));
         const bool lastAttempt = attempt == totalAttempts;
 
         // Clear the buffer before each attempt
-        readBuffer.clear();
+        readBuffer.data.clear();
+        readBuffer.sizeLimitExceeded = false;
+        readBuffer.isStreamingResponse.reset();
 
         // Perform the request
-        const auto result = curl_easy_perform(m_handle);
+        std::exception_ptr handlerError;
+        CURLcode result;
+        if (handler)
+        {
+            result = PerformStreamingAttempt(*GetStreamingMultiplexer(), readBuffer, *handler, handlerError);
+        }
+        else
+        {
+            result = m_multiplexer ? m_multiplexer->Perform(m_handle) : curl_easy_perform(m_handle);
+        }
+
+        // If the handler failed, the transfer was aborted because of it and its error is the meaningful one
+        if (handlerError)
+        {
+            std::rethrow_exception(handlerError);
+        }
+
         if (result != CURLE_OK)
         {
+            THROW_CODE_IF_LOG(ConnectionUnexpectedError,
+                              readBuffer.sizeLimitExceeded,
+                              m_handler,
+                              "Response exceeded the maximum size of " + std::to_string(m_maxResponseSize) +
+                                  " bytes");
             THROW_LOG(CurlCodeToResult(result, errorBuffer.Get()), m_handler);
         }
 
@@ -380,7 +669,7 @@ std::string CurlConnection::CurlPerform(const std::string& url, CurlHeaderList&
         ProcessRetry(attempt, httpResult);
     }
 
-    return readBuffer;
+    return std::move(readBuffer.data);
 }
 
 bool CurlConnection::CanRetryRequest(bool lastAttempt, long httpCode)
@@ -393,7 +682,7 @@ bool CurlConnection::CanRetryRequest(bool lastAttempt, long httpCode)
 
     if (!IsRetriableHttpError(httpCode))
     {
-        LOG_INFO(m_handler, "Error %ld is not retriable, stopping", httpCode);
+        LOG_INFO(m_handler, "Error %ld is not retriable, stopping", LogArg("httpCode", httpCode));
         return false;
     }
 
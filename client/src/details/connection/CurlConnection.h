@@ -17,12 +17,22 @@ class Result;
 namespace details
 {
 struct CurlHeaderList;
+class CurlMultiplexer;
 class ReportingHandler;
 
 class CurlConnection : public Connection
 {
   public:
-    CurlConnection(const ConnectionConfig& config, const ReportingHandler& handler);
+    /**
+     * @param multiplexer When set, transfers are performed through it so they can share connections with other
+     * concurrent transfers. Must outlive this object.
+     * @param streamingMultiplexer Performs the transfers of StreamingPost() when @param multiplexer is not set. Must
+     * outlive this object.
+     */
+    CurlConnection(const ConnectionConfig& config,
+                   const ReportingHandler& handler,
+                   CurlMultiplexer* multiplexer = nullptr,
+                   CurlMultiplexer* streamingMultiplexer = nullptr);
     ~CurlConnection() override;
 
     /**
@@ -39,7 +49,37 @@ class CurlConnection : public Connection
      */
     std::string Post(const std::string& url, const std::string& data) override;
 
+    /**
+     * @brief Perform a POST request to the given @param url with @param data as the request body, and hand the
+     * response body to @param handler as it is received
+     * @details The handler runs on the calling thread while the transfer is performed by a CurlMultiplexer, which
+     * pauses it whenever the handler falls behind. Without any multiplexer, the handler gets the response once it is
+     * complete, like with Connection::StreamingPost()
+     * @throws SFSException if the request fails
+     */
+    void StreamingPost(const std::string& url, const std::string& data, const ResponseStreamHandler& handler) override;
+
   private:
+    /**
+     * @brief Set up @param data as the body of the next request, adding any required header to @param headers
+     */
+    void SetUpPostBody(const std::string& data, CurlHeaderList& headers);
+
+    /**
+     * @brief Perform a REST request to the given @param url with the given @param headers
+     * @param handler If set, the body of a successful response is handed to it as it is received instead of being
+     * returned
+     * @return The response body, or an empty string if @param handler is set
+     * @throws SFSException if the request fails
+     */
+    std::string Perform(const std::string& url, CurlHeaderList& headers, const ResponseStreamHandler* handler);
+
+    /**
+     * @brief The multiplexer that performs streaming requests, as its thread receives the response while the calling
+     * thread reads it. Null if the connection has none
+     */
+    CurlMultiplexer* GetStreamingMultiplexer() const;
+
     /**
      * @brief Perform checks that the request can be retried
      */
@@ -59,6 +99,10 @@ class CurlConnection : public Connection
     virtual std::string CurlPerform(const std::string& url, CurlHeaderList& headers);
 
     CURL* m_handle;
+
+    CurlMultiplexer* m_multiplexer;
+
+    CurlMultiplexer* m_streamingMultiplexer;
 };
 } // namespace details
 } // namespace SFS
@@ -4,7 +4,9 @@
 #include "CurlConnectionManager.h"
 
 #include "../ErrorHandling.h"
+#include "../ReportingHandler.h"
 #include "CurlConnection.h"
+#include "CurlMultiplexer.h"
 
 #include <curl/curl.h>
 
@@ -31,23 +33,47 @@ void CheckCurlFeatures(const ReportingHandler& handler)
                           handler,
                           "Curl was not built with async DNS resolutions");
 }
+
+void CheckCurlMultiplexingFeatures(const ReportingHandler& handler)
+{
+    curl_version_info_data* ver = curl_version_info(CURLVERSION_NOW);
+    if (ver && !(ver->features & CURL_VERSION_HTTP2))
+    {
+        LOG_WARNING(handler, "Curl was not built with HTTP/2 support, connections will not be multiplexed");
+    }
+}
 } // namespace
 
-CurlConnectionManager::CurlConnectionManager(const ReportingHandler& handler) : ConnectionManager(handler)
+CurlConnectionManager::CurlConnectionManager(const ReportingHandler& handler, const ConnectionManagerConfig& config)
+    : ConnectionManager(handler, config)
 {
     THROW_CODE_IF_NOT_LOG(HttpUnexpected,
                           curl_global_init(CURL_GLOBAL_ALL) == CURLE_OK,
                           m_handler,
                           "Curl failed to initialize");
     CheckCurlFeatures(m_handler);
+
+    if (m_config.maxStreamsPerConnection > 0)
+    {
+        CheckCurlMultiplexingFeatures(m_handler);
+        m_multiplexer = std::make_unique<CurlMultiplexer>(m_config.maxStreamsPerConnection, m_handler);
+    }
+    else
+    {
+        // Its worker thread is only started by the first streaming request
+        m_streamingMultiplexer = std::make_unique<CurlMultiplexer>(1 /*maxStreamsPerConnection*/, m_handler);
+    }
 }
 
 CurlConnectionManager::~CurlConnectionManager()
 {
+    // The multiplexers hold curl handles, so they must be cleaned up before curl itself
+    m_multiplexer.reset();
+    m_streamingMultiplexer.reset();
     curl_global_cleanup();
 }
 
 std::unique_ptr<Connection> CurlConnectionManager::MakeConnection(const ConnectionConfig& config)
 {
-    return std::make_unique<CurlConnection>(config, m_handler);
+    return std::make_unique<CurlConnection>(config, m_handler, m_multiplexer.get(), m_streamingMultiplexer.get());
 }
@@ -10,15 +10,24 @@
 namespace SFS::details
 {
 class Connection;
+class CurlMultiplexer;
 class ReportingHandler;
 struct ConnectionConfig;
 
 class CurlConnectionManager : public ConnectionManager
 {
   public:
-    CurlConnectionManager(const ReportingHandler& handler);
+    CurlConnectionManager(const ReportingHandler& handler, const ConnectionManagerConfig& config = {});
     ~CurlConnectionManager() override;
 
     std::unique_ptr<Connection> MakeConnection(const ConnectionConfig& config) override;
+
+  private:
+    /// @brief Shared by all connections made by this manager so concurrent requests can reuse connections
+    std::unique_ptr<CurlMultiplexer> m_multiplexer;
+
+    /// @brief Performs the streaming requests of all connections when multiplexing is disabled, one stream per
+    /// connection to the service, so they don't each start a transfer thread
+    std::unique_ptr<CurlMultiplexer> m_streamingMultiplexer;
 };
 } // namespace SFS::details
@@ -0,0 +1,193 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "CurlMultiplexer.h"
+
+#include "../ErrorHandling.h"
+#include "../ReportingHandler.h"
+
+#include <future>
+#include <unordered_map>
+
+using namespace SFS;
+using namespace SFS::details;
+
+namespace
+{
+// Maximum time the worker waits for socket activity before checking for new transfers. New transfers wake it up
+// earlier, so this only bounds the wait when nothing is happening.
+constexpr int c_pollTimeoutMs = 1000;
+} // namespace
+
+CurlMultiplexer::CurlMultiplexer(unsigned maxStreamsPerConnection, const ReportingHandler& handler)
+    : m_handler(handler)
+{
+    m_multi = curl_multi_init();
+    THROW_CODE_IF_NOT_LOG(ConnectionSetupFailed, m_multi, m_handler, "Failed to init curl multi handle");
+
+    // Prefer multiplexing transfers to the same host over a single HTTP/2 connection over opening new connections
+    THROW_CODE_IF_NOT_LOG(ConnectionSetupFailed,
+                          curl_multi_setopt(m_multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX) == CURLM_OK,
+                          m_handler,
+                          "Failed to enable multiplexing in curl multi handle");
+    THROW_CODE_IF_NOT_LOG(
+        ConnectionSetupFailed,
+        curl_multi_setopt(m_multi, CURLMOPT_MAX_CONCURRENT_STREAMS, static_cast<long>(maxStreamsPerConnection)) ==
+            CURLM_OK,
+        m_handler,
+        "Failed to set the maximum number of concurrent streams in curl multi handle");
+}
+
+CurlMultiplexer::~CurlMultiplexer()
+{
+    {
+        std::lock_guard guard(m_mutex);
+        m_stop = true;
+    }
+
+    if (m_worker.joinable())
+    {
+        curl_multi_wakeup(m_multi);
+        m_worker.join();
+    }
+
+    curl_multi_cleanup(m_multi);
+}
+
+CURLcode CurlMultiplexer::Perform(CURL* handle)
+{
+    std::promise<CURLcode> promise;
+    auto future = promise.get_future();
+    Start(handle, [&promise](CURLcode result) { promise.set_value(result); });
+    return future.get();
+}
+
+void CurlMultiplexer::Start(CURL* handle, std::function<void(CURLcode)> onDone)
+{
+    {
+        std::unique_lock lock(m_mutex);
+        if (m_stop)
+        {
+            lock.unlock();
+            onDone(CURLE_ABORTED_BY_CALLBACK);
+            return;
+        }
+
+        StartWorkerIfNeeded();
+        m_pendingTransfers.push_back({handle, std::move(onDone)});
+    }
+
+    curl_multi_wakeup(m_multi);
+}
+
+void CurlMultiplexer::Resume(CURL* handle)
+{
+    {
+        std::lock_guard guard(m_mutex);
+        if (m_stop)
+        {
+            return;
+        }
+        m_resumedTransfers.push_back(handle);
+    }
+
+    curl_multi_wakeup(m_multi);
+}
+
+void CurlMultiplexer::StartWorkerIfNeeded()
+{
+    // Must be called with m_mutex held
+    if (!m_worker.joinable())
+    {
+        m_worker = std::thread(&CurlMultiplexer::Run, this);
+    }
+}
+
+void CurlMultiplexer::Run()
+{
+    std::unordered_map<CURL*, std::function<void(CURLcode)>> activeTransfers;
+
+    while (true)
+    {
+        std::vector<Transfer> newTransfers;
+        std::vector<CURL*> resumedTransfers;
+        {
+            std::lock_guard guard(m_mutex);
+            if (m_stop)
+            {
+                break;
+            }
+            newTransfers.swap(m_pendingTransfers);
+            resumedTransfers.swap(m_resumedTransfers);
+        }
+
+        // The callbacks of the transfers may take locks of their own, so they are never called with m_mutex held
+        for (auto& transfer : newTransfers)
+        {
+            if (curl_multi_add_handle(m_multi, transfer.handle) != CURLM_OK)
+            {
+                transfer.onDone(CURLE_FAILED_INIT);
+                continue;
+            }
+            activeTransfers.emplace(transfer.handle, std::move(transfer.onDone));
+        }
+
+        // Unpausing may call the write callback right away with the data held while paused
+        for (auto handle : resumedTransfers)
+        {
+            if (activeTransfers.count(handle) > 0)
+            {
+                curl_easy_pause(handle, CURLPAUSE_CONT);
+            }
+        }
+
+        int runningTransfers = 0;
+        const CURLMcode performCode = curl_multi_perform(m_multi, &runningTransfers);
+        if (performCode != CURLM_OK)
+        {
+            LOG_ERROR(m_handler, "Curl multi perform failed: %s", curl_multi_strerror(performCode));
+        }
+
+        int messagesLeft = 0;
+        while (CURLMsg* message = curl_multi_info_read(m_multi, &messagesLeft))
+        {
+            if (message->msg != CURLMSG_DONE)
+            {
+                continue;
+            }
+
+            auto it = activeTransfers.find(message->easy_handle);
+            if (it == activeTransfers.end())
+            {
+                continue;
+            }
+
+            // The handle must be removed before the waiting thread is released, as it may reuse it right away
+            const CURLcode result = message->data.result;
+            curl_multi_remove_handle(m_multi, it->first);
+            auto onDone = std::move(it->second);
+            activeTransfers.erase(it);
+            onDone(result);
+        }
+
+        curl_multi_poll(m_multi, nullptr, 0, c_pollTimeoutMs, nullptr);
+    }
+
+    // Release any transfer still waiting, which can only happen if the manager is destroyed while requests are ongoing
+    for (auto& [handle, onDone] : activeTransfers)
+    {
+        curl_multi_remove_handle(m_multi, handle);
+        onDone(CURLE_ABORTED_BY_CALLBACK);
+    }
+
+    std::vector<Transfer> pendingTransfers;
+    {
+        std::lock_guard guard(m_mutex);
+        pendingTransfers.swap(m_pendingTransfers);
+        m_resumedTransfers.clear();
+    }
+    for (auto& transfer : pendingTransfers)
+    {
+        transfer.onDone(CURLE_ABORTED_BY_CALLBACK);
+    }
+}
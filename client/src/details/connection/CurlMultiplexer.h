@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <curl/curl.h>
+
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SFS::details
+{
+class ReportingHandler;
+
+/**
+ * @brief Drives transfers from multiple CurlConnection objects through a single curl multi handle.
+ * @details Transfers submitted concurrently from different threads are performed by one worker thread, which allows
+ * curl to multiplex them as HTTP/2 streams over a shared connection to the same host, and to keep connections alive
+ * between requests. The worker thread is started on the first transfer and stopped when this object is destroyed.
+ */
+class CurlMultiplexer
+{
+  public:
+    CurlMultiplexer(unsigned maxStreamsPerConnection, const ReportingHandler& handler);
+    ~CurlMultiplexer();
+
+    CurlMultiplexer(const CurlMultiplexer&) = delete;
+    CurlMultiplexer& operator=(const CurlMultiplexer&) = delete;
+
+    /**
+     * @brief Performs the transfer already set up in @param handle
+     * @details Blocks the calling thread until the transfer is complete. The callbacks set in the handle are called
+     * from the worker thread.
+     * @return The result of the transfer, like curl_easy_perform() would return
+     */
+    CURLcode Perform(CURL* handle);
+
+    /**
+     * @brief Starts the transfer already set up in @param handle without waiting for it
+     * @details @param onDone is called from the worker thread with the result of the transfer once it is complete,
+     * and must not throw. The handle must not be used by the caller until then.
+     */
+    void Start(CURL* handle, std::function<void(CURLcode)> onDone);
+
+    /**
+     * @brief Resumes the transfer of @param handle, paused by its write callback returning CURL_WRITEFUNC_PAUSE
+     * @details Can be called from any thread, as the transfer is resumed by the worker thread. Does nothing if the
+     * transfer is already complete.
+     */
+    void Resume(CURL* handle);
+
+  private:
+    struct Transfer
+    {
+        CURL* handle;
+        std::function<void(CURLcode)> onDone;
+    };
+
+    void StartWorkerIfNeeded();
+    void Run();
+
+    const ReportingHandler& m_handler;
+
+    CURLM* m_multi;
+
+    std::mutex m_mutex;
+    std::vector<Transfer> m_pendingTransfers;
+    std::vector<CURL*> m_resumedTransfers;
+    bool m_stop{false};
+
+    std::thread m_worker;
+};
+} // namespace SFS::details
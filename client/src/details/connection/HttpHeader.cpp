@@ -15,6 +15,8 @@ std::string SFS::details::ToString(HttpHeader header)
 {
     switch (header)
     {
+    case HttpHeader::ContentEncoding:
+        return "Content-Encoding";
     case HttpHeader::ContentType:
         return "Content-Type";
     case HttpHeader::MSCV:
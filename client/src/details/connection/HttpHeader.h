@@ -9,6 +9,7 @@ namespace SFS::details
 {
 enum class HttpHeader
 {
+    ContentEncoding,
     ContentType,
     MSCV,
     RetryAfter,
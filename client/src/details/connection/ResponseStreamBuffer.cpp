@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "ResponseStreamBuffer.h"
+
+#include "../ErrorHandling.h"
+
+using namespace SFS;
+using namespace SFS::details;
+
+ResponseStreamBuffer::ResponseStreamBuffer(size_t maxBufferedBytes, std::function<void()> resumeWriter)
+    : m_maxBufferedBytes(maxBufferedBytes)
+    , m_resumeWriter(std::move(resumeWriter))
+{
+}
+
+ResponseStreamBuffer::WriteResult ResponseStreamBuffer::Write(const char* data, size_t size)
+{
+    std::lock_guard guard(m_mutex);
+
+    if (m_readerStopped)
+    {
+        return m_readerFailed ? WriteResult::ReaderFailed : WriteResult::Written;
+    }
+
+    // A single chunk bigger than the limit is still accepted once the queue is empty, so writes are never refused
+    // forever
+    if (m_bufferedBytes != 0 && m_bufferedBytes + size > m_maxBufferedBytes)
+    {
+        m_refusedBytes = size;
+        return WriteResult::Full;
+    }
+
+    m_refusedBytes.reset();
+    m_chunks.emplace_back(data, size);
+    m_bufferedBytes += size;
+    m_cv.notify_all();
+    return WriteResult::Written;
+}
+
+void ResponseStreamBuffer::Close()
+{
+    std::lock_guard guard(m_mutex);
+    m_closed = true;
+    m_cv.notify_all();
+}
+
+void ResponseStreamBuffer::Abort()
+{
+    std::lock_guard guard(m_mutex);
+    m_aborted = true;
+    m_cv.notify_all();
+}
+
+bool ResponseStreamBuffer::WaitForData()
+{
+    std::unique_lock lock(m_mutex);
+    m_cv.wait(lock, [&] { return m_aborted || m_closed || !m_chunks.empty(); });
+    return !m_chunks.empty();
+}
+
+bool ResponseStreamBuffer::IsAborted()
+{
+    std::lock_guard guard(m_mutex);
+    return m_aborted;
+}
+
+void ResponseStreamBuffer::StopReading(bool failed)
+{
+    bool resumeWriter = false;
+    {
+        std::lock_guard guard(m_mutex);
+        m_readerStopped = true;
+        m_readerFailed = failed;
+        m_chunks.clear();
+        m_bufferedBytes = 0;
+
+        // The writer is resumed so it can finish the transfer, or abort it if the reader failed
+        resumeWriter = m_refusedBytes.has_value();
+        m_refusedBytes.reset();
+    }
+
+    if (resumeWriter)
+    {
+        m_resumeWriter();
+    }
+}
+
+bool ResponseStreamBuffer::HasRoomForRefusedWrite() const
+{
+    return m_refusedBytes && (m_bufferedBytes == 0 || m_bufferedBytes + *m_refusedBytes <= m_maxBufferedBytes);
+}
+
+ResponseStreamBuffer::int_type ResponseStreamBuffer::underflow()
+{
+    if (gptr() < egptr())
+    {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    bool resumeWriter = false;
+    {
+        std::unique_lock lock(m_mutex);
+        m_cv.wait(lock, [&] { return m_aborted || m_closed || !m_chunks.empty(); });
+
+        THROW_CODE_IF(ConnectionUnexpectedError, m_aborted, "The transfer of the response was aborted");
+
+        if (m_chunks.empty())
+        {
+            return traits_type::eof();
+        }
+
+        m_current = std::move(m_chunks.front());
+        m_chunks.pop_front();
+        m_bufferedBytes -= m_current.size();
+
+        // The refused write is expected again once resumed, so the writer is only resumed once
+        if (HasRoomForRefusedWrite())
+        {
+            resumeWriter = true;
+            m_refusedBytes.reset();
+        }
+    }
+
+    // Resuming may lead to a write right away, so it happens without holding the lock
+    if (resumeWriter)
+    {
+        m_resumeWriter();
+    }
+
+    setg(m_current.data(), m_current.data(), m_current.data() + m_current.size());
+    return traits_type::to_int_type(*gptr());
+}
@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <streambuf>
+#include <string>
+
+namespace SFS::details
+{
+/**
+ * @brief Stream buffer that hands the chunks of a response received by one thread to a reader in another thread.
+ * @details The transfer thread calls Write() as data arrives and Close() or Abort() when the transfer ends, while the
+ * reader consumes the data through an std::istream built on top of this buffer. Reads block until more data arrives or
+ * the transfer ends. Writes never block: a write that would leave more than maxBufferedBytes waiting to be read is
+ * refused so the transfer can be paused, and resumeWriter is called once the reader makes room for it. This bounds the
+ * memory used by the response no matter its total size.
+ */
+class ResponseStreamBuffer : public std::streambuf
+{
+  public:
+    enum class WriteResult
+    {
+        Written,
+        Full,
+        ReaderFailed
+    };
+
+    /**
+     * @param resumeWriter Called from the reader's thread once there is room for a write that was refused. Must not
+     * throw
+     */
+    ResponseStreamBuffer(size_t maxBufferedBytes, std::function<void()> resumeWriter);
+
+    ResponseStreamBuffer(const ResponseStreamBuffer&) = delete;
+    ResponseStreamBuffer& operator=(const ResponseStreamBuffer&) = delete;
+
+    /**
+     * @brief Queues @param size bytes from @param data to be read
+     * @details If the reader already stopped, the data is dropped.
+     * @return Full if the data doesn't fit yet, in which case nothing is queued and the same data should be written
+     * again once resumeWriter is called. ReaderFailed if the reader stopped because of a failure, in which case the
+     * transfer should be aborted
+     */
+    WriteResult Write(const char* data, size_t size);
+
+    /// @brief Signals the reader that the response is complete. Reads return end-of-file once the queue is drained
+    void Close();
+
+    /// @brief Signals the reader that the transfer failed. Pending and future reads throw an SFSException
+    void Abort();
+
+    /**
+     * @brief Waits until there is data to read or the transfer ended
+     * @return Whether there is data to read
+     */
+    bool WaitForData();
+
+    /// @return Whether Abort() was called
+    bool IsAborted();
+
+    /**
+     * @brief Called by the reader once it is done with the stream, so writes don't wait for it anymore
+     * @param failed Whether the reader stopped because of a failure
+     */
+    void StopReading(bool failed);
+
+  protected:
+    int_type underflow() override;
+
+  private:
+    /// @brief Whether a refused write of m_refusedBytes fits now. Must be called with m_mutex held
+    bool HasRoomForRefusedWrite() const;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+
+    const size_t m_maxBufferedBytes;
+    std::deque<std::string> m_chunks;
+    size_t m_bufferedBytes{0};
+
+    // Chunk currently exposed to the reader through the get area
+    std::string m_current;
+
+    bool m_closed{false};
+    bool m_aborted{false};
+    bool m_readerStopped{false};
+    bool m_readerFailed{false};
+
+    std::function<void()> m_resumeWriter;
+
+    // Size of the last refused write, while the writer waits to be resumed
+    std::optional<size_t> m_refusedBytes;
+};
+} // namespace SFS::details
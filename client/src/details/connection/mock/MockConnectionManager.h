@@ -16,7 +16,7 @@ struct ConnectionConfig;
 class MockConnectionManager : public ConnectionManager
 {
   public:
-    MockConnectionManager(const ReportingHandler& handler);
+    MockConnectionManager(const ReportingHandler& handler, const ConnectionManagerConfig& config = {});
     ~MockConnectionManager() override;
 
     std::unique_ptr<Connection> MakeConnection(const ConnectionConfig& config) override;
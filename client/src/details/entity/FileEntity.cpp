@@ -4,6 +4,7 @@
 #include "FileEntity.h"
 
 #include "../ErrorHandling.h"
+#include "../OSInfo.h"
 #include "../ReportingHandler.h"
 #include "../Util.h"
 #include "AppFile.h"
@@ -17,7 +18,6 @@
 using namespace SFS;
 using namespace SFS::details;
 using namespace SFS::details::util;
-using json = nlohmann::json;
 
 namespace
 {
@@ -67,18 +67,36 @@ Architecture ArchitectureFromString(const std::string& arch, const ReportingHand
     }
 }
 
-void ValidateContentType(const FileEntity& entity, ContentType expectedType, const ReportingHandler& handler)
+void ValidateContentType(ContentType type,
+                         ContentType expectedType,
+                         const std::string& fileId,
+                         const ReportingHandler& handler)
 {
     THROW_CODE_IF_LOG(Result::ServiceUnexpectedContentType,
-                      entity.GetContentType() != expectedType,
+                      type != expectedType,
                       handler,
-                      "The service returned file \"" + entity.fileId + "\" with content type [" +
-                          ToString(entity.GetContentType()) + "] while the expected type was [" +
-                          ToString(expectedType) + "]");
+                      "The service returned file \"" + fileId + "\" with content type [" + ToString(type) +
+                          "] while the expected type was [" + ToString(expectedType) + "]");
+}
+
+void ValidateContentType(const FileEntity& entity, ContentType expectedType, const ReportingHandler& handler)
+{
+    ValidateContentType(GetContentType(entity), expectedType, GetBase(entity).fileId, handler);
 }
-} // namespace
 
-std::unique_ptr<FileEntity> FileEntity::FromJson(const nlohmann::json& file, const ReportingHandler& handler)
+std::unordered_map<HashType, std::string> ToHashes(std::unordered_map<std::string, std::string>&& entityHashes,
+                                                   const ReportingHandler& handler)
+{
+    std::unordered_map<HashType, std::string> hashes;
+    hashes.reserve(entityHashes.size());
+    for (auto& [hashType, hashValue] : entityHashes)
+    {
+        hashes[HashTypeFromString(hashType, handler)] = std::move(hashValue);
+    }
+    return hashes;
+}
+
+void ValidateFileJson(const json& file, const ReportingHandler& handler)
 {
     // Expected format for a generic file entity:
     // {
@@ -108,46 +126,27 @@ std::unique_ptr<FileEntity> FileEntity::FromJson(const nlohmann::json& file, con
 
     THROW_INVALID_RESPONSE_IF_NOT(file.is_object(), "File is not a JSON object", handler);
 
-    std::unique_ptr<FileEntity> tmp;
-    const bool isAppEntity = file.contains("FileMoniker");
-    if (isAppEntity)
-    {
-        tmp = std::make_unique<AppFileEntity>();
-    }
-    else
-    {
-        tmp = std::make_unique<GenericFileEntity>();
-    }
-
     THROW_INVALID_RESPONSE_IF_NOT(file.contains("FileId"), "Missing File.FileId in response", handler);
     THROW_INVALID_RESPONSE_IF_NOT(file["FileId"].is_string(), "File.FileId is not a string", handler);
-    tmp->fileId = file["FileId"];
 
     THROW_INVALID_RESPONSE_IF_NOT(file.contains("Url"), "Missing File.Url in response", handler);
     THROW_INVALID_RESPONSE_IF_NOT(file["Url"].is_string(), "File.Url is not a string", handler);
-    tmp->url = file["Url"];
 
     THROW_INVALID_RESPONSE_IF_NOT(file.contains("SizeInBytes"), "Missing File.SizeInBytes in response", handler);
     THROW_INVALID_RESPONSE_IF_NOT(file["SizeInBytes"].is_number_unsigned(),
                                   "File.SizeInBytes is not an unsigned number",
                                   handler);
-    tmp->sizeInBytes = file["SizeInBytes"];
 
     THROW_INVALID_RESPONSE_IF_NOT(file.contains("Hashes"), "Missing File.Hashes in response", handler);
     THROW_INVALID_RESPONSE_IF_NOT(file["Hashes"].is_object(), "File.Hashes is not an object", handler);
-
-    for (const auto& [hashType, hashValue] : file["Hashes"].items())
+    for (const auto& hashValue : file["Hashes"])
     {
         THROW_INVALID_RESPONSE_IF_NOT(hashValue.is_string(), "File.Hashes object value is not a string", handler);
-        tmp->hashes[hashType] = hashValue;
     }
 
-    if (isAppEntity)
+    if (file.contains("FileMoniker"))
     {
-        auto appEntity = dynamic_cast<AppFileEntity*>(tmp.get());
-
         THROW_INVALID_RESPONSE_IF_NOT(file["FileMoniker"].is_string(), "File.FileMoniker is not a string", handler);
-        appEntity->fileMoniker = file["FileMoniker"];
 
         THROW_INVALID_RESPONSE_IF_NOT(file.contains("ApplicabilityDetails"),
                                       "Missing File.ApplicabilityDetails in response",
@@ -168,7 +167,6 @@ std::unique_ptr<FileEntity> FileEntity::FromJson(const nlohmann::json& file, con
                                           "File.ApplicabilityDetails.Architectures array value is not a string",
                                           handler);
         }
-        appEntity->applicabilityDetails.architectures = details["Architectures"];
 
         THROW_INVALID_RESPONSE_IF_NOT(details.contains("PlatformApplicabilityForPackage"),
                                       "Missing File.ApplicabilityDetails.PlatformApplicabilityForPackage in response",
@@ -183,81 +181,229 @@ std::unique_ptr<FileEntity> FileEntity::FromJson(const nlohmann::json& file, con
                 "File.ApplicabilityDetails.PlatformApplicabilityForPackage array value is not a string",
                 handler);
         }
-        appEntity->applicabilityDetails.platformApplicabilityForPackage = details["PlatformApplicabilityForPackage"];
+    }
+}
+
+ContentType GetContentTypeFromJson(const json& file)
+{
+    return file.contains("FileMoniker") ? ContentType::App : ContentType::Generic;
+}
+
+// Moves the string out of a JSON value that was already validated to be a string
+std::string TakeString(json& value)
+{
+    return std::move(value.get_ref<std::string&>());
+}
+
+const std::string& AsString(const std::string& value)
+{
+    return value;
+}
+
+const std::string& AsString(const json& value)
+{
+    return value.get_ref<const std::string&>();
+}
+
+uint8_t ArchitectureBit(Architecture architecture)
+{
+    return static_cast<uint8_t>(1u << static_cast<unsigned>(architecture));
+}
+
+std::unordered_map<HashType, std::string> HashesFromJson(json& jsonHashes, const ReportingHandler& handler)
+{
+    std::unordered_map<HashType, std::string> hashes;
+    hashes.reserve(jsonHashes.size());
+    for (auto it = jsonHashes.begin(); it != jsonHashes.end(); ++it)
+    {
+        hashes[HashTypeFromString(it.key(), handler)] = TakeString(it.value());
+    }
+    return hashes;
+}
+
+// Builds an AppFile from a download info response element already validated to be an app file
+std::unique_ptr<AppFile> AppFileFromValidatedJson(json& file, const ReportingHandler& handler)
+{
+    auto hashes = HashesFromJson(file["Hashes"], handler);
+
+    auto& details = file["ApplicabilityDetails"];
+    std::vector<Architecture> architectures;
+    architectures.reserve(details["Architectures"].size());
+    for (const auto& arch : details["Architectures"])
+    {
+        architectures.push_back(ArchitectureFromString(arch.get_ref<const std::string&>(), handler));
+    }
+
+    std::vector<std::string> platformApplicabilityForPackage;
+    platformApplicabilityForPackage.reserve(details["PlatformApplicabilityForPackage"].size());
+    for (auto& app : details["PlatformApplicabilityForPackage"])
+    {
+        platformApplicabilityForPackage.push_back(TakeString(app));
+    }
+
+    std::unique_ptr<AppFile> tmp;
+    THROW_IF_FAILED_LOG(AppFile::Make(TakeString(file["FileId"]),
+                                      TakeString(file["Url"]),
+                                      file["SizeInBytes"],
+                                      std::move(hashes),
+                                      std::move(architectures),
+                                      std::move(platformApplicabilityForPackage),
+                                      TakeString(file["FileMoniker"]),
+                                      tmp),
+                        handler);
+    return tmp;
+}
+} // namespace
+
+ContentType SFS::details::GetContentType(const FileEntity& entity)
+{
+    return std::visit([](const auto& alternative) { return alternative.c_contentType; }, entity);
+}
+
+const FileEntityBase& SFS::details::GetBase(const FileEntity& entity)
+{
+    return std::visit([](const auto& alternative) -> const FileEntityBase& { return alternative; }, entity);
+}
+
+FileEntityBase& SFS::details::GetBase(FileEntity& entity)
+{
+    return std::visit([](auto& alternative) -> FileEntityBase& { return alternative; }, entity);
+}
+
+FileEntity SFS::details::FileEntityFromJson(const json& file, const ReportingHandler& handler)
+{
+    ValidateFileJson(file, handler);
+
+    FileEntity tmp;
+    if (GetContentTypeFromJson(file) == ContentType::App)
+    {
+        auto& appEntity = tmp.emplace<AppFileEntity>();
+        appEntity.fileMoniker = file["FileMoniker"];
+
+        const auto& details = file["ApplicabilityDetails"];
+        appEntity.applicabilityDetails.architectures = details["Architectures"];
+        appEntity.applicabilityDetails.platformApplicabilityForPackage = details["PlatformApplicabilityForPackage"];
+    }
+
+    auto& base = GetBase(tmp);
+    base.fileId = file["FileId"];
+    base.url = file["Url"];
+    base.sizeInBytes = file["SizeInBytes"];
+    for (const auto& [hashType, hashValue] : file["Hashes"].items())
+    {
+        base.hashes[hashType] = hashValue;
     }
 
     return tmp;
 }
 
-FileEntities FileEntity::DownloadInfoResponseToFileEntities(const nlohmann::json& data, const ReportingHandler& handler)
+std::unique_ptr<File> SFS::details::FileFromJson(json&& file, const ReportingHandler& handler)
+{
+    ValidateFileJson(file, handler);
+    ValidateContentType(GetContentTypeFromJson(file),
+                        ContentType::Generic,
+                        file["FileId"].get_ref<const std::string&>(),
+                        handler);
+
+    auto hashes = HashesFromJson(file["Hashes"], handler);
+
+    std::unique_ptr<File> tmp;
+    THROW_IF_FAILED_LOG(File::Make(TakeString(file["FileId"]),
+                                   TakeString(file["Url"]),
+                                   file["SizeInBytes"],
+                                   std::move(hashes),
+                                   tmp),
+                        handler);
+    return tmp;
+}
+
+std::unique_ptr<AppFile> SFS::details::AppFileFromJson(json&& file, const ReportingHandler& handler)
+{
+    ValidateFileJson(file, handler);
+    ValidateContentType(GetContentTypeFromJson(file),
+                        ContentType::App,
+                        file["FileId"].get_ref<const std::string&>(),
+                        handler);
+
+    return AppFileFromValidatedJson(file, handler);
+}
+
+std::unique_ptr<AppFile> SFS::details::AppFileFromJson(json&& file,
+                                                       const AppFileFilter& filter,
+                                                       const ReportingHandler& handler)
+{
+    ValidateFileJson(file, handler);
+    ValidateContentType(GetContentTypeFromJson(file),
+                        ContentType::App,
+                        file["FileId"].get_ref<const std::string&>(),
+                        handler);
+
+    const auto& details = file["ApplicabilityDetails"];
+    if (!filter.Matches(details["Architectures"], details["PlatformApplicabilityForPackage"], handler))
+    {
+        return nullptr;
+    }
+
+    return AppFileFromValidatedJson(file, handler);
+}
+
+FileEntities SFS::details::DownloadInfoResponseToFileEntities(const json& data,
+                                                              const ReportingHandler& handler)
 {
     // Expected format is an array of FileEntity
     THROW_CODE_IF_NOT_LOG(ServiceInvalidResponse, data.is_array(), handler, "Response is not a JSON array");
 
     FileEntities tmp;
+    tmp.reserve(data.size());
     for (const auto& fileData : data)
     {
         THROW_CODE_IF_NOT_LOG(ServiceInvalidResponse,
                               fileData.is_object(),
                               handler,
                               "Array element is not a JSON object");
-        tmp.push_back(std::move(FileEntity::FromJson(fileData, handler)));
+        tmp.push_back(FileEntityFromJson(fileData, handler));
     }
 
     return tmp;
 }
 
-ContentType GenericFileEntity::GetContentType() const
-{
-    return ContentType::Generic;
-}
-
 std::unique_ptr<File> GenericFileEntity::ToFile(FileEntity&& entity, const ReportingHandler& handler)
 {
     ValidateContentType(entity, ContentType::Generic, handler);
 
-    std::unordered_map<HashType, std::string> hashes;
-    for (auto& [hashType, hashValue] : entity.hashes)
-    {
-        hashes[HashTypeFromString(hashType, handler)] = std::move(hashValue);
-    }
+    auto& genericEntity = std::get<GenericFileEntity>(entity);
 
     std::unique_ptr<File> tmp;
-    THROW_IF_FAILED_LOG(
-        File::Make(std::move(entity.fileId), std::move(entity.url), entity.sizeInBytes, std::move(hashes), tmp),
-        handler);
+    THROW_IF_FAILED_LOG(File::Make(std::move(genericEntity.fileId),
+                                   std::move(genericEntity.url),
+                                   genericEntity.sizeInBytes,
+                                   ToHashes(std::move(genericEntity.hashes), handler),
+                                   tmp),
+                        handler);
     return tmp;
 }
 
 std::vector<File> GenericFileEntity::FileEntitiesToFileVector(FileEntities&& entities, const ReportingHandler& handler)
 {
     std::vector<File> tmp;
+    tmp.reserve(entities.size());
     for (auto& entity : entities)
     {
-        tmp.push_back(std::move(*GenericFileEntity::ToFile(std::move(*entity), handler)));
+        tmp.push_back(std::move(*GenericFileEntity::ToFile(std::move(entity), handler)));
     }
 
     return tmp;
 }
 
-ContentType AppFileEntity::GetContentType() const
-{
-    return ContentType::App;
-}
-
 std::unique_ptr<AppFile> AppFileEntity::ToAppFile(FileEntity&& entity, const ReportingHandler& handler)
 {
     ValidateContentType(entity, ContentType::App, handler);
 
-    auto appEntity = dynamic_cast<AppFileEntity&&>(entity);
-
-    std::unordered_map<HashType, std::string> hashes;
-    for (auto& [hashType, hashValue] : appEntity.hashes)
-    {
-        hashes[HashTypeFromString(hashType, handler)] = std::move(hashValue);
-    }
+    auto& appEntity = std::get<AppFileEntity>(entity);
+    auto hashes = ToHashes(std::move(appEntity.hashes), handler);
 
     std::vector<Architecture> architectures;
+    architectures.reserve(appEntity.applicabilityDetails.architectures.size());
     for (auto& arch : appEntity.applicabilityDetails.architectures)
     {
         architectures.push_back(ArchitectureFromString(arch, handler));
@@ -276,14 +422,125 @@ std::unique_ptr<AppFile> AppFileEntity::ToAppFile(FileEntity&& entity, const Rep
     return tmp;
 }
 
-std::vector<AppFile> AppFileEntity::FileEntitiesToAppFileVector(std::vector<std::unique_ptr<FileEntity>>&& entities,
+std::vector<AppFile> AppFileEntity::FileEntitiesToAppFileVector(FileEntities&& entities,
+                                                                const ReportingHandler& handler)
+{
+    std::vector<AppFile> tmp;
+    tmp.reserve(entities.size());
+    for (auto& entity : entities)
+    {
+        tmp.push_back(std::move(*AppFileEntity::ToAppFile(std::move(entity), handler)));
+    }
+
+    return tmp;
+}
+
+std::vector<AppFile> AppFileEntity::FileEntitiesToAppFileVector(FileEntities&& entities,
+                                                                const AppFileFilter& filter,
                                                                 const ReportingHandler& handler)
 {
     std::vector<AppFile> tmp;
     for (auto& entity : entities)
     {
-        tmp.push_back(std::move(*AppFileEntity::ToAppFile(std::move(*entity), handler)));
+        ValidateContentType(entity, ContentType::App, handler);
+
+        const auto& details = std::get<AppFileEntity>(entity).applicabilityDetails;
+        if (filter.Matches(details.architectures, details.platformApplicabilityForPackage, handler))
+        {
+            tmp.push_back(std::move(*AppFileEntity::ToAppFile(std::move(entity), handler)));
+        }
+    }
+
+    return tmp;
+}
+
+std::optional<AppFileFilter> AppFileFilter::Make(const std::optional<ApplicabilityFilter>& filter)
+{
+    if (!filter)
+    {
+        return std::nullopt;
+    }
+
+    AppFileFilter tmp;
+    if (filter->architectures.empty())
+    {
+        const auto machineArchitecture = osinfo::GetOSArchitecture();
+        if (machineArchitecture != Architecture::None)
+        {
+            tmp.m_architectures = ArchitectureBit(machineArchitecture);
+        }
+    }
+    else
+    {
+        for (const auto architecture : filter->architectures)
+        {
+            tmp.m_architectures |= ArchitectureBit(architecture);
+        }
     }
 
+    if (tmp.m_architectures != 0)
+    {
+        tmp.m_architectures |= ArchitectureBit(Architecture::None);
+    }
+
+    tmp.m_platforms = filter->platforms;
+
+    if (tmp.m_architectures == 0 && tmp.m_platforms.empty())
+    {
+        return std::nullopt;
+    }
     return tmp;
 }
+
+bool AppFileFilter::Matches(const std::vector<std::string>& architectures,
+                            const std::vector<std::string>& platforms,
+                            const ReportingHandler& handler) const
+{
+    return MatchesImpl(architectures, platforms, handler);
+}
+
+bool AppFileFilter::Matches(const json& architectures, const json& platforms, const ReportingHandler& handler) const
+{
+    return MatchesImpl(architectures, platforms, handler);
+}
+
+template <typename ArchitecturesT, typename PlatformsT>
+bool AppFileFilter::MatchesImpl(const ArchitecturesT& architectures,
+                                const PlatformsT& platforms,
+                                const ReportingHandler& handler) const
+{
+    // A file that lists no architecture is architecture-neutral
+    if (m_architectures != 0 && !architectures.empty())
+    {
+        bool matchesArchitecture = false;
+        for (const auto& architecture : architectures)
+        {
+            if (m_architectures & ArchitectureBit(ArchitectureFromString(AsString(architecture), handler)))
+            {
+                matchesArchitecture = true;
+                break;
+            }
+        }
+        if (!matchesArchitecture)
+        {
+            return false;
+        }
+    }
+
+    if (!m_platforms.empty())
+    {
+        for (const auto& platform : platforms)
+        {
+            for (const auto& acceptedPlatform : m_platforms)
+            {
+                if (AreEqualI(AsString(platform), acceptedPlatform))
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    return true;
+}
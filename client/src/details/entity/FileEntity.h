@@ -3,15 +3,18 @@
 
 #pragma once
 
+#include "../Json.h"
 #include "ContentType.h"
+#include "RequestParams.h"
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <variant>
 #include <vector>
 
-#include <nlohmann/json_fwd.hpp>
-
 namespace SFS
 {
 class File;
@@ -21,30 +24,29 @@ namespace details
 {
 class ReportingHandler;
 
-struct FileEntity;
+struct GenericFileEntity;
+struct AppFileEntity;
 
-using FileEntities = std::vector<std::unique_ptr<FileEntity>>;
+/**
+ * @brief A file entity is held by value as one of the alternatives below, chosen while parsing the response.
+ * @details Entities are stored contiguously in FileEntities, without a separate allocation per file, and are moved
+ * into the public File and AppFile objects.
+ */
+using FileEntity = std::variant<GenericFileEntity, AppFileEntity>;
+using FileEntities = std::vector<FileEntity>;
 
-struct FileEntity
+/// Members common to all file entities
+struct FileEntityBase
 {
-    virtual ~FileEntity()
-    {
-    }
-
-    virtual ContentType GetContentType() const = 0;
-
     std::string fileId;
     std::string url;
-    uint64_t sizeInBytes;
+    uint64_t sizeInBytes{0};
     std::unordered_map<std::string, std::string> hashes;
-
-    static std::unique_ptr<FileEntity> FromJson(const nlohmann::json& file, const ReportingHandler& handler);
-    static FileEntities DownloadInfoResponseToFileEntities(const nlohmann::json& data, const ReportingHandler& handler);
 };
 
-struct GenericFileEntity : public FileEntity
+struct GenericFileEntity : public FileEntityBase
 {
-    ContentType GetContentType() const override;
+    static constexpr ContentType c_contentType = ContentType::Generic;
 
     static std::unique_ptr<File> ToFile(FileEntity&& entity, const ReportingHandler& handler);
     static std::vector<File> FileEntitiesToFileVector(FileEntities&& entities, const ReportingHandler& handler);
@@ -56,16 +58,96 @@ struct ApplicabilityDetailsEntity
     std::vector<std::string> platformApplicabilityForPackage;
 };
 
-struct AppFileEntity : public FileEntity
+/**
+ * @brief ApplicabilityFilter resolved to the form used to match files while the response is parsed
+ */
+class AppFileFilter
 {
-    ContentType GetContentType() const override;
+  public:
+    /**
+     * @return The filter to apply for @param filter, or std::nullopt if it doesn't drop any file
+     * @details An empty list of architectures is resolved to the architecture of this machine
+     */
+    static std::optional<AppFileFilter> Make(const std::optional<ApplicabilityFilter>& filter);
+
+    /**
+     * @return true if a file with these @param architectures and @param platforms should be kept
+     * @throws SFSException if an architecture is unknown
+     */
+    bool Matches(const std::vector<std::string>& architectures,
+                 const std::vector<std::string>& platforms,
+                 const ReportingHandler& handler) const;
+    bool Matches(const json& architectures, const json& platforms, const ReportingHandler& handler) const;
+
+  private:
+    AppFileFilter() = default;
+
+    template <typename ArchitecturesT, typename PlatformsT>
+    bool MatchesImpl(const ArchitecturesT& architectures,
+                     const PlatformsT& platforms,
+                     const ReportingHandler& handler) const;
+
+    // One bit per accepted Architecture value, 0 to accept any
+    uint8_t m_architectures{0};
+    std::vector<std::string> m_platforms;
+};
+
+struct AppFileEntity : public FileEntityBase
+{
+    static constexpr ContentType c_contentType = ContentType::App;
 
     std::string fileMoniker;
     ApplicabilityDetailsEntity applicabilityDetails;
 
     static std::unique_ptr<AppFile> ToAppFile(FileEntity&& entity, const ReportingHandler& handler);
     static std::vector<AppFile> FileEntitiesToAppFileVector(FileEntities&& entities, const ReportingHandler& handler);
+
+    /**
+     * @brief Same as above, but entities that don't match @param filter are dropped before being converted
+     */
+    static std::vector<AppFile> FileEntitiesToAppFileVector(FileEntities&& entities,
+                                                            const AppFileFilter& filter,
+                                                            const ReportingHandler& handler);
 };
 
+ContentType GetContentType(const FileEntity& entity);
+
+const FileEntityBase& GetBase(const FileEntity& entity);
+FileEntityBase& GetBase(FileEntity& entity);
+
+FileEntity FileEntityFromJson(const json& file, const ReportingHandler& handler);
+FileEntities DownloadInfoResponseToFileEntities(const json& data, const ReportingHandler& handler);
+
+/**
+ * @brief Builds a File directly from a download info response element, without an intermediate FileEntity
+ * @details Validation is the same as FileEntityFromJson() followed by GenericFileEntity::ToFile(). Strings are moved
+ * out of @param file.
+ */
+std::unique_ptr<File> FileFromJson(json&& file, const ReportingHandler& handler);
+
+/**
+ * @brief Builds an AppFile directly from a download info response element, without an intermediate FileEntity
+ * @details Validation is the same as FileEntityFromJson() followed by AppFileEntity::ToAppFile(). Strings are moved
+ * out of @param file.
+ */
+std::unique_ptr<AppFile> AppFileFromJson(json&& file, const ReportingHandler& handler);
+
+/**
+ * @brief Same as above, but returns nullptr without building the AppFile if @param file doesn't match @param filter
+ */
+std::unique_ptr<AppFile> AppFileFromJson(json&& file, const AppFileFilter& filter, const ReportingHandler& handler);
+
+#ifdef SFS_JSON_BACKEND_SIMDJSON
+/**
+ * @brief Parses a download info response with simdjson's on-demand parser, with the same validation as the
+ * nlohmann::json overload
+ * @param data The response body. The padding simdjson requires is appended to it in place
+ * @param method Name of the service method that returned the response, used in parsing error messages
+ */
+FileEntities DownloadInfoResponseToFileEntities(std::string& data,
+                                                const std::string& method,
+                                                const ReportingHandler& handler);
+#endif
+
 } // namespace details
 } // namespace SFS
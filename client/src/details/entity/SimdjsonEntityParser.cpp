@@ -0,0 +1,511 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+// Entity parsing with simdjson's on-demand parser, built when SFS_JSON_BACKEND is "simdjson".
+//
+// The on-demand parser reads each value at most once and in document order, so the fields of an object are first
+// collected in a single pass and only then validated. Validation follows the same order and uses the same messages
+// as the nlohmann::json implementations in FileEntity.cpp and VersionEntity.cpp.
+
+#include "FileEntity.h"
+#include "VersionEntity.h"
+
+#include "../ErrorHandling.h"
+#include "../ReportingHandler.h"
+
+#include <simdjson.h>
+
+#include <optional>
+
+#define THROW_INVALID_RESPONSE_IF_NOT(condition, message, handler)                                                     \
+    THROW_CODE_IF_NOT_LOG(ServiceInvalidResponse, condition, handler, message)
+
+using namespace SFS;
+using namespace SFS::details;
+using simdjson::ondemand::json_type;
+
+namespace ondemand = simdjson::ondemand;
+
+namespace
+{
+struct StringField
+{
+    bool present{false};
+    bool isString{false};
+    std::string value;
+};
+
+struct UnsignedField
+{
+    bool present{false};
+    bool isUnsigned{false};
+    uint64_t value{0};
+};
+
+struct StringArrayField
+{
+    bool present{false};
+    bool isArray{false};
+    bool allStrings{true};
+    std::vector<std::string> values;
+};
+
+struct StringMapField
+{
+    bool present{false};
+    bool isObject{false};
+    bool allStrings{true};
+    std::unordered_map<std::string, std::string> values;
+};
+
+struct ApplicabilityDetailsField
+{
+    bool present{false};
+    bool isObject{false};
+    StringArrayField architectures;
+    StringArrayField platformApplicabilityForPackage;
+};
+
+struct ContentIdField
+{
+    bool present{false};
+    bool isObject{false};
+    StringField nameSpace;
+    StringField name;
+    StringField version;
+};
+
+// Returns a parser per thread, which reuses its internal buffers across responses
+ondemand::parser& GetParser()
+{
+    thread_local ondemand::parser parser;
+    return parser;
+}
+
+std::string_view GetKey(ondemand::field& field)
+{
+    return field.unescaped_key();
+}
+
+void ReadString(ondemand::value value, StringField& field)
+{
+    field.present = true;
+    field.isString = value.type() == json_type::string;
+    if (field.isString)
+    {
+        field.value = std::string_view(value.get_string());
+    }
+}
+
+void ReadUnsigned(ondemand::value value, UnsignedField& field)
+{
+    field.present = true;
+
+    // Matches nlohmann::json::is_number_unsigned(): integers without a sign that fit in 64 bits
+    field.isUnsigned = false;
+    if (value.type() == json_type::number && value.get_number_type() != ondemand::number_type::floating_point_number &&
+        value.get_number_type() != ondemand::number_type::big_integer && !value.is_negative())
+    {
+        field.isUnsigned = true;
+        field.value = value.get_uint64();
+    }
+}
+
+void ReadStringArray(ondemand::value value, StringArrayField& field)
+{
+    field = StringArrayField{};
+    field.present = true;
+    field.isArray = value.type() == json_type::array;
+    if (!field.isArray)
+    {
+        return;
+    }
+
+    for (ondemand::value element : value.get_array())
+    {
+        if (element.type() != json_type::string)
+        {
+            field.allStrings = false;
+            continue;
+        }
+        field.values.emplace_back(std::string_view(element.get_string()));
+    }
+}
+
+void ReadStringMap(ondemand::value value, StringMapField& field)
+{
+    field = StringMapField{};
+    field.present = true;
+    field.isObject = value.type() == json_type::object;
+    if (!field.isObject)
+    {
+        return;
+    }
+
+    for (ondemand::field member : value.get_object())
+    {
+        const std::string key{GetKey(member)};
+        ondemand::value memberValue = member.value();
+        if (memberValue.type() != json_type::string)
+        {
+            field.allStrings = false;
+            continue;
+        }
+        field.values[key] = std::string_view(memberValue.get_string());
+    }
+}
+
+void ReadApplicabilityDetails(ondemand::value value, ApplicabilityDetailsField& field)
+{
+    field = ApplicabilityDetailsField{};
+    field.present = true;
+    field.isObject = value.type() == json_type::object;
+    if (!field.isObject)
+    {
+        return;
+    }
+
+    for (ondemand::field member : value.get_object())
+    {
+        const std::string_view key = GetKey(member);
+        if (key == "Architectures")
+        {
+            ReadStringArray(member.value(), field.architectures);
+        }
+        else if (key == "PlatformApplicabilityForPackage")
+        {
+            ReadStringArray(member.value(), field.platformApplicabilityForPackage);
+        }
+    }
+}
+
+// Reads the Namespace, Name and Version members of a ContentId or Prerequisite object
+void ReadContentId(ondemand::value value, ContentIdField& field)
+{
+    field = ContentIdField{};
+    field.present = true;
+    field.isObject = value.type() == json_type::object;
+    if (!field.isObject)
+    {
+        return;
+    }
+
+    for (ondemand::field member : value.get_object())
+    {
+        const std::string_view key = GetKey(member);
+        if (key == "Namespace")
+        {
+            ReadString(member.value(), field.nameSpace);
+        }
+        else if (key == "Name")
+        {
+            ReadString(member.value(), field.name);
+        }
+        else if (key == "Version")
+        {
+            ReadString(member.value(), field.version);
+        }
+    }
+}
+
+FileEntity FileEntityFromObject(ondemand::object file, const ReportingHandler& handler)
+{
+    StringField fileId;
+    StringField url;
+    UnsignedField sizeInBytes;
+    StringMapField hashes;
+    StringField fileMoniker;
+    ApplicabilityDetailsField applicabilityDetails;
+
+    for (ondemand::field member : file)
+    {
+        const std::string_view key = GetKey(member);
+        if (key == "FileId")
+        {
+            ReadString(member.value(), fileId);
+        }
+        else if (key == "Url")
+        {
+            ReadString(member.value(), url);
+        }
+        else if (key == "SizeInBytes")
+        {
+            ReadUnsigned(member.value(), sizeInBytes);
+        }
+        else if (key == "Hashes")
+        {
+            ReadStringMap(member.value(), hashes);
+        }
+        else if (key == "FileMoniker")
+        {
+            ReadString(member.value(), fileMoniker);
+        }
+        else if (key == "ApplicabilityDetails")
+        {
+            ReadApplicabilityDetails(member.value(), applicabilityDetails);
+        }
+    }
+
+    FileEntity tmp;
+    const bool isAppEntity = fileMoniker.present;
+    if (isAppEntity)
+    {
+        tmp.emplace<AppFileEntity>();
+    }
+    auto& base = GetBase(tmp);
+
+    THROW_INVALID_RESPONSE_IF_NOT(fileId.present, "Missing File.FileId in response", handler);
+    THROW_INVALID_RESPONSE_IF_NOT(fileId.isString, "File.FileId is not a string", handler);
+    base.fileId = std::move(fileId.value);
+
+    THROW_INVALID_RESPONSE_IF_NOT(url.present, "Missing File.Url in response", handler);
+    THROW_INVALID_RESPONSE_IF_NOT(url.isString, "File.Url is not a string", handler);
+    base.url = std::move(url.value);
+
+    THROW_INVALID_RESPONSE_IF_NOT(sizeInBytes.present, "Missing File.SizeInBytes in response", handler);
+    THROW_INVALID_RESPONSE_IF_NOT(sizeInBytes.isUnsigned, "File.SizeInBytes is not an unsigned number", handler);
+    base.sizeInBytes = sizeInBytes.value;
+
+    THROW_INVALID_RESPONSE_IF_NOT(hashes.present, "Missing File.Hashes in response", handler);
+    THROW_INVALID_RESPONSE_IF_NOT(hashes.isObject, "File.Hashes is not an object", handler);
+    THROW_INVALID_RESPONSE_IF_NOT(hashes.allStrings, "File.Hashes object value is not a string", handler);
+    base.hashes = std::move(hashes.values);
+
+    if (isAppEntity)
+    {
+        auto& appEntity = std::get<AppFileEntity>(tmp);
+
+        THROW_INVALID_RESPONSE_IF_NOT(fileMoniker.isString, "File.FileMoniker is not a string", handler);
+        appEntity.fileMoniker = std::move(fileMoniker.value);
+
+        THROW_INVALID_RESPONSE_IF_NOT(applicabilityDetails.present,
+                                      "Missing File.ApplicabilityDetails in response",
+                                      handler);
+        THROW_INVALID_RESPONSE_IF_NOT(applicabilityDetails.isObject,
+                                      "File.ApplicabilityDetails is not an object",
+                                      handler);
+
+        auto& architectures = applicabilityDetails.architectures;
+        THROW_INVALID_RESPONSE_IF_NOT(architectures.present,
+                                      "Missing File.ApplicabilityDetails.Architectures in response",
+                                      handler);
+        THROW_INVALID_RESPONSE_IF_NOT(architectures.isArray,
+                                      "File.ApplicabilityDetails.Architectures is not an array",
+                                      handler);
+        THROW_INVALID_RESPONSE_IF_NOT(architectures.allStrings,
+                                      "File.ApplicabilityDetails.Architectures array value is not a string",
+                                      handler);
+        appEntity.applicabilityDetails.architectures = std::move(architectures.values);
+
+        auto& platforms = applicabilityDetails.platformApplicabilityForPackage;
+        THROW_INVALID_RESPONSE_IF_NOT(platforms.present,
+                                      "Missing File.ApplicabilityDetails.PlatformApplicabilityForPackage in response",
+                                      handler);
+        THROW_INVALID_RESPONSE_IF_NOT(platforms.isArray,
+                                      "File.ApplicabilityDetails.PlatformApplicabilityForPackage is not an array",
+                                      handler);
+        THROW_INVALID_RESPONSE_IF_NOT(
+            platforms.allStrings,
+            "File.ApplicabilityDetails.PlatformApplicabilityForPackage array value is not a string",
+            handler);
+        appEntity.applicabilityDetails.platformApplicabilityForPackage = std::move(platforms.values);
+    }
+
+    return tmp;
+}
+
+VersionEntity VersionEntityFromObject(ondemand::object data, const ReportingHandler& handler)
+{
+    ContentIdField contentId;
+    StringField updateId;
+    bool prerequisitesPresent = false;
+    bool prerequisitesIsArray = false;
+    std::vector<std::optional<ContentIdField>> prerequisites; // nullopt for elements that are not objects
+
+    for (ondemand::field member : data)
+    {
+        const std::string_view key = GetKey(member);
+        if (key == "ContentId")
+        {
+            ReadContentId(member.value(), contentId);
+        }
+        else if (key == "UpdateId")
+        {
+            ReadString(member.value(), updateId);
+        }
+        else if (key == "Prerequisites")
+        {
+            ondemand::value value = member.value();
+            prerequisitesPresent = true;
+            prerequisitesIsArray = value.type() == json_type::array;
+            prerequisites.clear();
+            if (prerequisitesIsArray)
+            {
+                for (ondemand::value element : value.get_array())
+                {
+                    if (element.type() != json_type::object)
+                    {
+                        prerequisites.emplace_back(std::nullopt);
+                        continue;
+                    }
+                    ReadContentId(element, prerequisites.emplace_back(ContentIdField{}).value());
+                }
+            }
+        }
+    }
+
+    VersionEntity tmp;
+    const bool isAppEntity = updateId.present;
+    if (isAppEntity)
+    {
+        tmp.emplace<AppVersionEntity>();
+    }
+    auto& base = GetBase(tmp);
+
+    THROW_INVALID_RESPONSE_IF_NOT(contentId.present, "Missing ContentId in response", handler);
+    THROW_INVALID_RESPONSE_IF_NOT(contentId.isObject, "ContentId is not a JSON object", handler);
+
+    THROW_INVALID_RESPONSE_IF_NOT(contentId.nameSpace.present, "Missing ContentId.Namespace in response", handler);
+    THROW_INVALID_RESPONSE_IF_NOT(contentId.nameSpace.isString, "ContentId.Namespace is not a string", handler);
+    base.contentId.nameSpace = std::move(contentId.nameSpace.value);
+
+    THROW_INVALID_RESPONSE_IF_NOT(contentId.name.present, "Missing ContentId.Name in response", handler);
+    THROW_INVALID_RESPONSE_IF_NOT(contentId.name.isString, "ContentId.Name is not a string", handler);
+    base.contentId.name = std::move(contentId.name.value);
+
+    THROW_INVALID_RESPONSE_IF_NOT(contentId.version.present, "Missing ContentId.Version in response", handler);
+    THROW_INVALID_RESPONSE_IF_NOT(contentId.version.isString, "ContentId.Version is not a string", handler);
+    base.contentId.version = std::move(contentId.version.value);
+
+    if (isAppEntity)
+    {
+        auto& appEntity = std::get<AppVersionEntity>(tmp);
+
+        THROW_INVALID_RESPONSE_IF_NOT(updateId.isString, "UpdateId is not a string", handler);
+        appEntity.updateId = std::move(updateId.value);
+
+        THROW_INVALID_RESPONSE_IF_NOT(prerequisitesPresent, "Missing Prerequisites in response", handler);
+        THROW_INVALID_RESPONSE_IF_NOT(prerequisitesIsArray, "Prerequisites is not an array", handler);
+
+        appEntity.prerequisites.reserve(prerequisites.size());
+        for (auto& prereq : prerequisites)
+        {
+            THROW_INVALID_RESPONSE_IF_NOT(prereq.has_value(), "Prerequisite element is not a JSON object", handler);
+
+            GenericVersionEntity prereqEntity;
+            THROW_INVALID_RESPONSE_IF_NOT(prereq->nameSpace.present,
+                                          "Missing Prerequisite.Namespace in response",
+                                          handler);
+            THROW_INVALID_RESPONSE_IF_NOT(prereq->nameSpace.isString,
+                                          "Prerequisite.Namespace is not a string",
+                                          handler);
+            prereqEntity.contentId.nameSpace = std::move(prereq->nameSpace.value);
+
+            THROW_INVALID_RESPONSE_IF_NOT(prereq->name.present, "Missing Prerequisite.Name in response", handler);
+            THROW_INVALID_RESPONSE_IF_NOT(prereq->name.isString, "Prerequisite.Name is not a string", handler);
+            prereqEntity.contentId.name = std::move(prereq->name.value);
+
+            THROW_INVALID_RESPONSE_IF_NOT(prereq->version.present,
+                                          "Missing Prerequisite.Version in response",
+                                          handler);
+            THROW_INVALID_RESPONSE_IF_NOT(prereq->version.isString,
+                                          "Prerequisite.Version is not a string",
+                                          handler);
+            prereqEntity.contentId.version = std::move(prereq->version.value);
+
+            appEntity.prerequisites.push_back(std::move(prereqEntity));
+        }
+    }
+    return tmp;
+}
+
+[[noreturn]] void ThrowParsingError(const std::string& method, const char* error, const ReportingHandler& handler)
+{
+    THROW_LOG(Result(Result::ServiceInvalidResponse, "(" + method + ") JSON Parsing error: " + error), handler);
+    throw SFSException(Result::ServiceInvalidResponse); // Unreachable code, but the compiler doesn't know that.
+}
+
+// Parses @param data as a single JSON document and calls @param parse with its root value. simdjson errors, which
+// can surface at any point since the document is parsed as it is read, are reported as parsing errors
+template <typename ParseFn>
+auto ParseDocument(std::string& data, const std::string& method, const ReportingHandler& handler, ParseFn&& parse)
+{
+    try
+    {
+        // The parser may read past the end of the data, so the buffer is grown in place to avoid copying the response
+        data.reserve(data.size() + simdjson::SIMDJSON_PADDING);
+        ondemand::document doc = GetParser().iterate(data.data(), data.size(), data.capacity());
+        auto result = parse(doc);
+        if (!doc.at_end())
+        {
+            ThrowParsingError(method, simdjson::error_message(simdjson::TRAILING_CONTENT), handler);
+        }
+        return result;
+    }
+    catch (const simdjson::simdjson_error& ex)
+    {
+        ThrowParsingError(method, ex.what(), handler);
+    }
+}
+} // namespace
+
+FileEntities SFS::details::DownloadInfoResponseToFileEntities(std::string& data,
+                                                              const std::string& method,
+                                                              const ReportingHandler& handler)
+{
+    return ParseDocument(data, method, handler, [&](ondemand::document& doc) {
+        // Expected format is an array of FileEntity
+        THROW_CODE_IF_NOT_LOG(ServiceInvalidResponse,
+                              doc.type() == json_type::array,
+                              handler,
+                              "Response is not a JSON array");
+
+        FileEntities tmp;
+        for (ondemand::value fileData : doc.get_array())
+        {
+            THROW_CODE_IF_NOT_LOG(ServiceInvalidResponse,
+                                  fileData.type() == json_type::object,
+                                  handler,
+                                  "Array element is not a JSON object");
+            tmp.push_back(FileEntityFromObject(fileData.get_object(), handler));
+        }
+        return tmp;
+    });
+}
+
+VersionEntity SFS::details::VersionEntityFromJson(std::string& data,
+                                                 const std::string& method,
+                                                 const ReportingHandler& handler)
+{
+    return ParseDocument(data, method, handler, [&](ondemand::document& doc) {
+        THROW_INVALID_RESPONSE_IF_NOT(doc.type() == json_type::object, "Response is not a JSON object", handler);
+        return VersionEntityFromObject(doc.get_object(), handler);
+    });
+}
+
+VersionEntities SFS::details::BatchResponseToVersionEntities(std::string& data,
+                                                            const std::string& method,
+                                                            const ReportingHandler& handler)
+{
+    return ParseDocument(data, method, handler, [&](ondemand::document& doc) {
+        THROW_CODE_IF_NOT_LOG(ServiceInvalidResponse,
+                              doc.type() == json_type::array,
+                              handler,
+                              "Response is not a JSON array");
+
+        VersionEntities entities;
+        for (ondemand::value versionData : doc.get_array())
+        {
+            THROW_INVALID_RESPONSE_IF_NOT(versionData.type() == json_type::object,
+                                          "Response is not a JSON object",
+                                          handler);
+            entities.push_back(VersionEntityFromObject(versionData.get_object(), handler));
+        }
+
+        THROW_CODE_IF_NOT_LOG(ServiceInvalidResponse,
+                              !entities.empty(),
+                              handler,
+                              "Response does not have the expected size");
+        return entities;
+    });
+}
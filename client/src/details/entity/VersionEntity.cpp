@@ -14,22 +14,36 @@
 
 using namespace SFS;
 using namespace SFS::details;
-using json = nlohmann::json;
 
 namespace
 {
 void ValidateContentType(const VersionEntity& entity, ContentType expectedType, const ReportingHandler& handler)
 {
     THROW_CODE_IF_LOG(Result::ServiceUnexpectedContentType,
-                      entity.GetContentType() != expectedType,
+                      GetContentType(entity) != expectedType,
                       handler,
-                      "The service returned entity \"" + entity.contentId.name + "\" with content type [" +
-                          ToString(entity.GetContentType()) + "] while the expected type was [" +
+                      "The service returned entity \"" + GetBase(entity).contentId.name + "\" with content type [" +
+                          ToString(GetContentType(entity)) + "] while the expected type was [" +
                           ToString(expectedType) + "]");
 }
 } // namespace
 
-std::unique_ptr<VersionEntity> VersionEntity::FromJson(const nlohmann::json& data, const ReportingHandler& handler)
+ContentType SFS::details::GetContentType(const VersionEntity& entity)
+{
+    return std::visit([](const auto& alternative) { return alternative.c_contentType; }, entity);
+}
+
+const VersionEntityBase& SFS::details::GetBase(const VersionEntity& entity)
+{
+    return std::visit([](const auto& alternative) -> const VersionEntityBase& { return alternative; }, entity);
+}
+
+VersionEntityBase& SFS::details::GetBase(VersionEntity& entity)
+{
+    return std::visit([](auto& alternative) -> VersionEntityBase& { return alternative; }, entity);
+}
+
+VersionEntity SFS::details::VersionEntityFromJson(const json& data, const ReportingHandler& handler)
 {
     // Expected format for a generic version entity:
     // {
@@ -55,16 +69,13 @@ std::unique_ptr<VersionEntity> VersionEntity::FromJson(const nlohmann::json& dat
 
     THROW_INVALID_RESPONSE_IF_NOT(data.is_object(), "Response is not a JSON object", handler);
 
-    std::unique_ptr<VersionEntity> tmp;
+    VersionEntity tmp;
     const bool isAppEntity = data.contains("UpdateId");
     if (isAppEntity)
     {
-        tmp = std::make_unique<AppVersionEntity>();
-    }
-    else
-    {
-        tmp = std::make_unique<GenericVersionEntity>();
+        tmp.emplace<AppVersionEntity>();
     }
+    auto& base = GetBase(tmp);
 
     THROW_INVALID_RESPONSE_IF_NOT(data.contains("ContentId"), "Missing ContentId in response", handler);
 
@@ -73,26 +84,27 @@ std::unique_ptr<VersionEntity> VersionEntity::FromJson(const nlohmann::json& dat
 
     THROW_INVALID_RESPONSE_IF_NOT(contentId.contains("Namespace"), "Missing ContentId.Namespace in response", handler);
     THROW_INVALID_RESPONSE_IF_NOT(contentId["Namespace"].is_string(), "ContentId.Namespace is not a string", handler);
-    tmp->contentId.nameSpace = contentId["Namespace"];
+    base.contentId.nameSpace = contentId["Namespace"];
 
     THROW_INVALID_RESPONSE_IF_NOT(contentId.contains("Name"), "Missing ContentId.Name in response", handler);
     THROW_INVALID_RESPONSE_IF_NOT(contentId["Name"].is_string(), "ContentId.Name is not a string", handler);
-    tmp->contentId.name = contentId["Name"];
+    base.contentId.name = contentId["Name"];
 
     THROW_INVALID_RESPONSE_IF_NOT(contentId.contains("Version"), "Missing ContentId.Version in response", handler);
     THROW_INVALID_RESPONSE_IF_NOT(contentId["Version"].is_string(), "ContentId.Version is not a string", handler);
-    tmp->contentId.version = contentId["Version"];
+    base.contentId.version = contentId["Version"];
 
     if (isAppEntity)
     {
-        auto appEntity = dynamic_cast<AppVersionEntity*>(tmp.get());
+        auto& appEntity = std::get<AppVersionEntity>(tmp);
 
         THROW_INVALID_RESPONSE_IF_NOT(data["UpdateId"].is_string(), "UpdateId is not a string", handler);
-        appEntity->updateId = data["UpdateId"];
+        appEntity.updateId = data["UpdateId"];
 
         THROW_INVALID_RESPONSE_IF_NOT(data.contains("Prerequisites"), "Missing Prerequisites in response", handler);
         THROW_INVALID_RESPONSE_IF_NOT(data["Prerequisites"].is_array(), "Prerequisites is not an array", handler);
 
+        appEntity.prerequisites.reserve(data["Prerequisites"].size());
         for (const auto& prereq : data["Prerequisites"])
         {
             THROW_INVALID_RESPONSE_IF_NOT(prereq.is_object(), "Prerequisite element is not a JSON object", handler);
@@ -118,13 +130,13 @@ std::unique_ptr<VersionEntity> VersionEntity::FromJson(const nlohmann::json& dat
                                           handler);
             prereqEntity.contentId.version = prereq["Version"];
 
-            appEntity->prerequisites.push_back(std::move(prereqEntity));
+            appEntity.prerequisites.push_back(std::move(prereqEntity));
         }
     }
     return tmp;
 }
 
-std::unique_ptr<ContentId> VersionEntity::ToContentId(VersionEntity&& entity, const ReportingHandler& handler)
+std::unique_ptr<ContentId> SFS::details::ToContentId(VersionEntityBase&& entity, const ReportingHandler& handler)
 {
     std::unique_ptr<ContentId> tmp;
     THROW_IF_FAILED_LOG(ContentId::Make(std::move(entity.contentId.nameSpace),
@@ -135,19 +147,8 @@ std::unique_ptr<ContentId> VersionEntity::ToContentId(VersionEntity&& entity, co
     return tmp;
 }
 
-ContentType GenericVersionEntity::GetContentType() const
-{
-    return ContentType::Generic;
-}
-
-ContentType AppVersionEntity::GetContentType() const
-{
-    return ContentType::App;
-}
-
-AppVersionEntity* AppVersionEntity::GetAppVersionEntityPtr(std::unique_ptr<VersionEntity>& versionEntity,
-                                                           const ReportingHandler& handler)
+AppVersionEntity& SFS::details::GetAppVersionEntity(VersionEntity& entity, const ReportingHandler& handler)
 {
-    ValidateContentType(*versionEntity, ContentType::App, handler);
-    return dynamic_cast<AppVersionEntity*>(versionEntity.get());
+    ValidateContentType(entity, ContentType::App, handler);
+    return std::get<AppVersionEntity>(entity);
 }
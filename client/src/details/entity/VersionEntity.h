@@ -3,14 +3,14 @@
 
 #pragma once
 
+#include "../Json.h"
 #include "ContentType.h"
 
 #include <memory>
 #include <string>
+#include <variant>
 #include <vector>
 
-#include <nlohmann/json_fwd.hpp>
-
 namespace SFS
 {
 class ContentId;
@@ -26,36 +26,62 @@ struct ContentIdEntity
     std::string version;
 };
 
-struct VersionEntity
+/// Members common to all version entities
+struct VersionEntityBase
 {
-    virtual ~VersionEntity()
-    {
-    }
-
-    virtual ContentType GetContentType() const = 0;
-
     ContentIdEntity contentId;
-
-    static std::unique_ptr<VersionEntity> FromJson(const nlohmann::json& data, const ReportingHandler& handler);
-    static std::unique_ptr<ContentId> ToContentId(VersionEntity&& entity, const ReportingHandler& handler);
 };
 
-struct GenericVersionEntity : public VersionEntity
+struct GenericVersionEntity : public VersionEntityBase
 {
-    ContentType GetContentType() const override;
+    static constexpr ContentType c_contentType = ContentType::Generic;
 };
 
-struct AppVersionEntity : public VersionEntity
+struct AppVersionEntity : public VersionEntityBase
 {
-    ContentType GetContentType() const override;
+    static constexpr ContentType c_contentType = ContentType::App;
 
     std::string updateId;
     std::vector<GenericVersionEntity> prerequisites;
-
-    static AppVersionEntity* GetAppVersionEntityPtr(std::unique_ptr<VersionEntity>& versionEntity,
-                                                    const ReportingHandler& handler);
 };
 
-using VersionEntities = std::vector<std::unique_ptr<VersionEntity>>;
+/**
+ * @brief A version entity is held by value as one of the alternatives above, chosen while parsing the response.
+ */
+using VersionEntity = std::variant<GenericVersionEntity, AppVersionEntity>;
+using VersionEntities = std::vector<VersionEntity>;
+
+ContentType GetContentType(const VersionEntity& entity);
+
+const VersionEntityBase& GetBase(const VersionEntity& entity);
+VersionEntityBase& GetBase(VersionEntity& entity);
+
+/**
+ * @return The AppVersionEntity held by @param entity
+ * @throws SFSException with ServiceUnexpectedContentType if @param entity does not hold an AppVersionEntity
+ */
+AppVersionEntity& GetAppVersionEntity(VersionEntity& entity, const ReportingHandler& handler);
+
+VersionEntity VersionEntityFromJson(const json& data, const ReportingHandler& handler);
+std::unique_ptr<ContentId> ToContentId(VersionEntityBase&& entity, const ReportingHandler& handler);
+
+#ifdef SFS_JSON_BACKEND_SIMDJSON
+/**
+ * @brief Parses a version response with simdjson's on-demand parser, with the same validation as the nlohmann::json
+ * overload
+ * @param data The response body. The padding simdjson requires is appended to it in place
+ * @param method Name of the service method that returned the response, used in parsing error messages
+ */
+VersionEntity VersionEntityFromJson(std::string& data, const std::string& method, const ReportingHandler& handler);
+
+/**
+ * @brief Parses a batch response, which is an array of versions, with simdjson's on-demand parser
+ * @param data The response body. The padding simdjson requires is appended to it in place
+ * @param method Name of the service method that returned the response, used in parsing error messages
+ */
+VersionEntities BatchResponseToVersionEntities(std::string& data,
+                                               const std::string& method,
+                                               const ReportingHandler& handler);
+#endif
 } // namespace details
 } // namespace SFS
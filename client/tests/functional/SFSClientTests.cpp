@@ -10,6 +10,9 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <chrono>
+#include <condition_variable>
+#include <memory_resource>
+#include <mutex>
 
 #define TEST(...) TEST_CASE("[Functional][SFSClientTests] " __VA_ARGS__)
 
@@ -126,6 +129,20 @@ TEST("Testing SFSClient::GetLatestDownloadInfo()")
             REQUIRE(proxy.Stop() == Result::Success);
         }
 
+        SECTION("No attributes + memory resource")
+        {
+            std::pmr::monotonic_buffer_resource arena;
+
+            params.productRequests = {{c_productName, {}}};
+            params.memoryResource = &arena;
+            REQUIRE(sfsClient->GetLatestDownloadInfo(params, contents) == Result::Success);
+
+            // The contents are not allocated from the resource
+            arena.release();
+            REQUIRE(contents.size() == 1);
+            CheckMockContent(contents[0], c_version);
+        }
+
         SECTION("With attributes")
         {
             const TargetingAttributes attributes{{"attr1", "value"}};
@@ -156,11 +173,219 @@ TEST("Testing SFSClient::GetLatestDownloadInfo()")
             REQUIRE(contents.size() == 1);
             CheckMockContent(contents[0], c_nextVersion);
         }
+
+        SECTION("Results share repeated strings")
+        {
+            params.productRequests = {{c_productName, {}}};
+            REQUIRE(sfsClient->GetLatestDownloadInfo(params, contents) == Result::Success);
+
+            std::vector<Content> otherContents;
+            REQUIRE(sfsClient->GetLatestDownloadInfo(params, otherContents) == Result::Success);
+            REQUIRE(contents[0].GetContentId().GetNameSpace().data() ==
+                    otherContents[0].GetContentId().GetNameSpace().data());
+            REQUIRE(contents[0].GetContentId().GetName().data() == otherContents[0].GetContentId().GetName().data());
+        }
+
+        SECTION("Streaming files")
+        {
+            params.productRequests = {{c_productName, {}}};
+            std::vector<File> files;
+            REQUIRE(sfsClient->StreamLatestDownloadInfo(params, [&](const ContentId& contentId, File&& file) {
+                CheckContentId(contentId, c_productName, c_version);
+                files.push_back(std::move(file));
+            }) == Result::Success);
+            CheckFiles(files);
+
+            params.productRequests = {{"badName", {}}};
+            REQUIRE(sfsClient->StreamLatestDownloadInfo(params, [](const ContentId&, File&&) {}) ==
+                    Result::HttpNotFound);
+        }
+
+        SECTION("Streaming files fails if the callback throws")
+        {
+            params.productRequests = {{c_productName, {}}};
+            size_t fileCount = 0;
+            auto result = sfsClient->StreamLatestDownloadInfo(params, [&](const ContentId&, File&&) {
+                ++fileCount;
+                throw std::runtime_error("stop");
+            });
+            REQUIRE(result.GetCode() == Result::Unexpected);
+            REQUIRE(fileCount == 1);
+        }
+    }
+
+    REQUIRE(server.Stop() == Result::Success);
+}
+
+TEST("Testing SFSClient::GetLatestDownloadInfoIfUpdated()")
+{
+    if (!AreTestOverridesAllowed())
+    {
+        return;
+    }
+
+    test::MockWebServer server;
+    ScopedTestOverride override(TestOverride::BaseUrl, server.GetBaseUrl());
+
+    std::unique_ptr<SFSClient> sfsClient;
+    REQUIRE(SFSClient::Make({"testAccountId", c_instanceId, c_namespace, LogCallbackToTest}, sfsClient) ==
+            Result::Success);
+    REQUIRE(sfsClient != nullptr);
+
+    server.RegisterProduct(c_productName, c_version);
+
+    std::vector<Content> contents;
+    RequestParams params;
+    params.productRequests = {{c_productName, {}}};
+
+    SECTION("Single product")
+    {
+        REQUIRE(sfsClient->GetLatestDownloadInfoIfUpdated(params, {{c_productName, c_version}}, contents) ==
+                Result::Success);
+        REQUIRE(contents.empty());
+
+        REQUIRE(sfsClient->GetLatestDownloadInfoIfUpdated(params, {{c_productName, "0.0.0"}}, contents) ==
+                Result::Success);
+        REQUIRE(contents.size() == 1);
+        CheckMockContent(contents[0], c_version);
+
+        // Products without a current version are out of date
+        REQUIRE(sfsClient->GetLatestDownloadInfoIfUpdated(params, {}, contents) == Result::Success);
+        REQUIRE(contents.size() == 1);
+        CheckMockContent(contents[0], c_version);
+
+        server.RegisterProduct(c_productName, c_nextVersion);
+        REQUIRE(sfsClient->GetLatestDownloadInfoIfUpdated(params, {{c_productName, c_version}}, contents) ==
+                Result::Success);
+        REQUIRE(contents.size() == 1);
+        CheckMockContent(contents[0], c_nextVersion);
+    }
+
+    SECTION("Multiple products")
+    {
+        const std::string otherProduct = "otherProduct";
+        server.RegisterProduct(otherProduct, c_version);
+        params.productRequests.push_back({otherProduct, {}});
+
+        REQUIRE(sfsClient->GetLatestDownloadInfoIfUpdated(params,
+                                                          {{c_productName, c_version}, {otherProduct, c_version}},
+                                                          contents) == Result::Success);
+        REQUIRE(contents.empty());
+
+        REQUIRE(sfsClient->GetLatestDownloadInfoIfUpdated(params,
+                                                          {{c_productName, c_version}, {otherProduct, "0.0.0"}},
+                                                          contents) == Result::Success);
+        REQUIRE(contents.size() == 1);
+        CheckContentId(contents[0].GetContentId(), otherProduct, c_version);
+
+        // Products the service doesn't know are skipped
+        params.productRequests.push_back({"badName", {}});
+        REQUIRE(sfsClient->GetLatestDownloadInfoIfUpdated(params, {}, contents) == Result::Success);
+        REQUIRE(contents.size() == 2);
+    }
+
+    SECTION("Many products are split into batches")
+    {
+        // More products than fit in the first batch, registered in reverse to check the results keep request order
+        const size_t productCount = 250;
+        ProductVersions currentVersions;
+        params.productRequests.clear();
+        for (size_t i = productCount; i > 0; --i)
+        {
+            const std::string product = "product" + std::to_string(i);
+            server.RegisterProduct(product, c_version);
+            params.productRequests.push_back({product, {}});
+            currentVersions[product] = i % 100 == 0 ? "0.0.0" : c_version;
+        }
+
+        // Repeated products are only sent once
+        params.productRequests.push_back({"product100", {}});
+
+        REQUIRE(sfsClient->GetLatestDownloadInfoIfUpdated(params, currentVersions, contents) == Result::Success);
+        REQUIRE(contents.size() == 2);
+        CheckContentId(contents[0].GetContentId(), "product200", c_version);
+        CheckContentId(contents[1].GetContentId(), "product100", c_version);
+    }
+
+    SECTION("Wrong product name")
+    {
+        params.productRequests = {{"badName", {}}};
+        REQUIRE(sfsClient->GetLatestDownloadInfoIfUpdated(params, {}, contents) == Result::HttpNotFound);
+        REQUIRE(contents.empty());
     }
 
     REQUIRE(server.Stop() == Result::Success);
 }
 
+TEST("Testing SFSClient::Watch()")
+{
+    if (!AreTestOverridesAllowed())
+    {
+        return;
+    }
+
+    test::MockWebServer server;
+    ScopedTestOverride override(TestOverride::BaseUrl, server.GetBaseUrl());
+
+    std::unique_ptr<SFSClient> sfsClient;
+    REQUIRE(SFSClient::Make({"testAccountId", c_instanceId, c_namespace, LogCallbackToTest}, sfsClient) ==
+            Result::Success);
+    REQUIRE(sfsClient != nullptr);
+
+    const std::string otherProduct = "otherProduct";
+    server.RegisterProduct(c_productName, c_version);
+    server.RegisterProduct(otherProduct, c_version);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<Content> changes;
+    size_t errorCount = 0;
+
+    WatchParams params;
+    params.products = {{{c_productName, {}}, 100ms, c_version}, {{otherProduct, {}}, 100ms, std::nullopt}};
+    params.deviceId = "testDevice";
+    params.batchWindow = 100ms;
+    params.onChange = [&](Content&& content) {
+        std::lock_guard guard(mutex);
+        changes.push_back(std::move(content));
+        cv.notify_all();
+    };
+    params.onError = [&](const Result&) {
+        std::lock_guard guard(mutex);
+        ++errorCount;
+        cv.notify_all();
+    };
+
+    auto waitFor = [&](auto condition) {
+        std::unique_lock lock(mutex);
+        return cv.wait_for(lock, 10s, condition);
+    };
+
+    std::unique_ptr<ProductWatcher> watcher;
+    REQUIRE(sfsClient->Watch(params, watcher) == Result::Success);
+
+    // Only the product without a current version is reported at first
+    REQUIRE(waitFor([&] { return !changes.empty(); }));
+    {
+        std::lock_guard guard(mutex);
+        REQUIRE(changes.size() == 1);
+        CheckContentId(changes[0].GetContentId(), otherProduct, c_version);
+    }
+
+    server.RegisterProduct(c_productName, c_nextVersion);
+    REQUIRE(waitFor([&] { return changes.size() >= 2; }));
+    {
+        std::lock_guard guard(mutex);
+        CheckContentId(changes[1].GetContentId(), c_productName, c_nextVersion);
+    }
+
+    watcher.reset();
+    REQUIRE(changes.size() == 2);
+    REQUIRE(errorCount == 0);
+
+    REQUIRE(server.Stop() == Result::Success);
+}
+
 TEST("Testing SFSClient::GetLatestAppDownloadInfo()")
 {
     if (!AreTestOverridesAllowed())
@@ -228,6 +453,54 @@ TEST("Testing SFSClient::GetLatestAppDownloadInfo()")
                 REQUIRE(contents.size() == 1);
                 CheckMockAppContent(contents[0], c_nextVersion, mockPrereqs);
             }
+
+            SECTION("Applicability filter")
+            {
+                // The mock files are x86 for "Windows" and amd64 for "Linux"
+                params.productRequests = {{c_productName, {}}};
+                params.applicabilityFilter = ApplicabilityFilter{{Architecture::Amd64}, {}};
+                REQUIRE(sfsClient->GetLatestAppDownloadInfo(params, contents) == Result::Success);
+                REQUIRE(contents.size() == 1);
+                REQUIRE(contents[0].GetFiles().size() == 1);
+                REQUIRE(contents[0].GetFiles()[0].GetFileId() == (c_productName + ".bin"));
+                REQUIRE(contents[0].GetPrerequisites().size() == mockPrereqs.size());
+                for (const auto& prereq : contents[0].GetPrerequisites())
+                {
+                    REQUIRE(prereq.GetFiles().size() == 1);
+                    REQUIRE(prereq.GetFiles()[0].GetApplicabilityDetails().HasArchitecture(Architecture::Amd64));
+                }
+
+                params.applicabilityFilter = ApplicabilityFilter{{Architecture::Amd64, Architecture::x86}, {"windows"}};
+                REQUIRE(sfsClient->GetLatestAppDownloadInfo(params, contents) == Result::Success);
+                REQUIRE(contents[0].GetFiles().size() == 1);
+                REQUIRE(contents[0].GetFiles()[0].GetFileId() == (c_productName + ".json"));
+
+                params.applicabilityFilter = ApplicabilityFilter{{Architecture::Arm64}, {}};
+                REQUIRE(sfsClient->GetLatestAppDownloadInfo(params, contents) == Result::Success);
+                REQUIRE(contents[0].GetFiles().empty());
+            }
+
+            SECTION("Streaming files")
+            {
+                params.productRequests = {{c_productName, {}}};
+                std::vector<std::pair<std::string, std::vector<AppFile>>> filesByContent;
+                REQUIRE(sfsClient->StreamLatestAppDownloadInfo(params, [&](const ContentId& contentId, AppFile&& file) {
+                    if (filesByContent.empty() || filesByContent.back().first != contentId.GetName())
+                    {
+                        filesByContent.emplace_back(contentId.GetName(), std::vector<AppFile>{});
+                    }
+                    filesByContent.back().second.push_back(std::move(file));
+                }) == Result::Success);
+
+                REQUIRE(filesByContent.size() == mockPrereqs.size() + 1);
+                REQUIRE(filesByContent[0].first == c_productName);
+                CheckAppFiles(filesByContent[0].second, c_productName);
+                for (size_t i = 0; i < mockPrereqs.size(); ++i)
+                {
+                    REQUIRE(filesByContent[i + 1].first == mockPrereqs[i].name);
+                    CheckAppFiles(filesByContent[i + 1].second, mockPrereqs[i].name);
+                }
+            }
         };
 
         SECTION("No prerequisites")
@@ -246,6 +519,97 @@ TEST("Testing SFSClient::GetLatestAppDownloadInfo()")
         }
     }
 
+    SECTION("Multiple apps")
+    {
+        const std::string otherApp = "otherApp";
+        server.RegisterAppProduct(c_productName, c_version, {{prereq1, prereq1Version}, {prereq2, prereq2Version}});
+        server.RegisterAppProduct(otherApp, c_version, {{prereq2, prereq2Version}});
+
+        std::vector<AppContent> contents;
+
+        RequestParams params;
+        params.productRequests = {{c_productName, {}}, {otherApp, {}}};
+        REQUIRE(sfsClient->GetLatestAppDownloadInfo(params, contents) == Result::Success);
+        REQUIRE(contents.size() == 2);
+
+        const auto& app = contents[0].GetContentId().GetName() == c_productName ? contents[0] : contents[1];
+        const auto& other = &app == &contents[0] ? contents[1] : contents[0];
+        CheckMockAppContent(app, c_version, {{prereq1, prereq1Version}, {prereq2, prereq2Version}});
+        CheckContentId(other.GetContentId(), otherApp, c_version);
+        CheckAppFiles(other.GetFiles(), otherApp);
+
+        // The shared prerequisite is fetched once, and both apps share its data
+        REQUIRE(other.GetPrerequisites().size() == 1);
+        CheckContentId(other.GetPrerequisites()[0].GetContentId(), prereq2, prereq2Version);
+        REQUIRE(&other.GetPrerequisites()[0].GetFiles() == &app.GetPrerequisites()[1].GetFiles());
+
+        // Apps the service doesn't know are skipped
+        params.productRequests.push_back({"badName", {}});
+        REQUIRE(sfsClient->GetLatestAppDownloadInfo(params, contents) == Result::Success);
+        REQUIRE(contents.size() == 2);
+    }
+
+    SECTION("Deferred prerequisites")
+    {
+        const std::vector<MockPrerequisite> mockPrereqs{{prereq1, prereq1Version}, {prereq2, prereq2Version}};
+        server.RegisterAppProduct(c_productName, c_version, mockPrereqs);
+
+        std::vector<DeferredAppContent> contents;
+
+        RequestParams params;
+        params.productRequests = {{c_productName, {}}};
+        REQUIRE(sfsClient->GetLatestAppDownloadInfoDeferred(params, contents) == Result::Success);
+        REQUIRE(contents.size() == 1);
+
+        const auto& content = contents[0];
+        CheckContentId(content.GetContentId(), c_productName, c_version);
+        REQUIRE_FALSE(content.GetUpdateId().empty());
+        CheckAppFiles(content.GetFiles(), c_productName);
+
+        REQUIRE(content.GetPrerequisites().size() == mockPrereqs.size());
+        for (size_t i = 0; i < mockPrereqs.size(); ++i)
+        {
+            const auto& prereq = content.GetPrerequisites()[i];
+            CheckContentId(prereq.GetContentId(), mockPrereqs[i].name, mockPrereqs[i].version);
+
+            std::unique_ptr<AppPrerequisiteContent> prereqContent;
+            REQUIRE(prereq.Get(prereqContent) == Result::Success);
+            REQUIRE(prereq.IsReady());
+            CheckContentId(prereqContent->GetContentId(), mockPrereqs[i].name, mockPrereqs[i].version);
+            CheckAppFiles(prereqContent->GetFiles(), mockPrereqs[i].name);
+        }
+    }
+
+    SECTION("Destroying the client cancels deferred prerequisites")
+    {
+        std::vector<MockPrerequisite> mockPrereqs;
+        for (size_t i = 0; i < 20; ++i)
+        {
+            mockPrereqs.push_back({"prereq" + std::to_string(i), "1.0.0.0"});
+        }
+        server.RegisterAppProduct(c_productName, c_version, mockPrereqs);
+
+        std::vector<DeferredAppContent> contents;
+
+        RequestParams params;
+        params.productRequests = {{c_productName, {}}};
+        REQUIRE(sfsClient->GetLatestAppDownloadInfoDeferred(params, contents) == Result::Success);
+        REQUIRE(contents.size() == 1);
+
+        sfsClient.reset();
+
+        // Whatever was not retrieved before the client went away is failed rather than left waiting
+        for (const auto& prereq : contents[0].GetPrerequisites())
+        {
+            REQUIRE(prereq.IsReady());
+
+            std::unique_ptr<AppPrerequisiteContent> prereqContent;
+            const auto result = prereq.Get(prereqContent);
+            REQUIRE((result == Result::Success || result == Result::Cancelled));
+            REQUIRE((prereqContent != nullptr) == result.IsSuccess());
+        }
+    }
+
     SECTION("Non-app products")
     {
         server.RegisterProduct(c_productName, c_version);
@@ -17,8 +17,11 @@
 #include <curl/curl.h>
 #include <nlohmann/json.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #define TEST(...) TEST_CASE("[Functional][CurlConnectionTests] " __VA_ARGS__)
 
@@ -195,6 +198,24 @@ TEST("Testing CurlConnection()")
 
                 REQUIRE(proxy.Stop() == Result::Success);
             }
+
+            SECTION("Testing with a compressed body")
+            {
+                ConnectionConfig config;
+                config.compressRequestBody = true;
+                connection = connectionManager.MakeConnection(config);
+
+                // Repeating the product so the body is large enough to be compressed. The server decompresses it
+                json largeBody = json::array();
+                for (int i = 0; i < 100; ++i)
+                {
+                    largeBody.push_back(body[0]);
+                }
+                server.RegisterExpectedRequestHeader(HttpHeader::ContentEncoding, "gzip");
+
+                REQUIRE_NOTHROW(out = connection->Post(url, largeBody.dump()));
+                REQUIRE(json::parse(out) == expectedResponse);
+            }
         }
 
         SECTION("With GetDownloadInfo mock")
@@ -324,6 +345,114 @@ TEST("Testing CurlConnection works from a second ConnectionManager")
     }
 }
 
+TEST("Testing concurrent requests through a multiplexing CurlConnectionManager")
+{
+    ReportingHandler handler;
+    handler.SetLoggingCallback(LogCallbackToTest);
+
+    test::MockWebServer server;
+    ConnectionManagerConfig managerConfig;
+    managerConfig.maxStreamsPerConnection = 10;
+    CurlConnectionManager connectionManager(handler, managerConfig);
+    SFSUrlBuilder urlBuilder(SFSCustomUrl(server.GetBaseUrl()), c_instanceId, c_namespace, handler);
+
+    const std::string url = urlBuilder.GetSpecificVersionUrl(c_productName, c_version);
+    server.RegisterProduct(c_productName, c_version);
+
+    json expectedResponse;
+    expectedResponse["ContentId"] = {{"Namespace", "default"}, {"Name", c_productName}, {"Version", c_version}};
+
+    // Each thread uses its own connection, and all transfers are driven by the manager's multiplexer
+    const size_t threadCount = 8;
+    std::atomic<size_t> successCount{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back([&]() {
+            try
+            {
+                auto connection = connectionManager.MakeConnection({});
+                if (json::parse(connection->Get(url)) == expectedResponse)
+                {
+                    ++successCount;
+                }
+            }
+            catch (...)
+            {
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE(successCount == threadCount);
+
+    INFO("Errors are still reported to each caller");
+    auto connection = connectionManager.MakeConnection({});
+    REQUIRE_THROWS_CODE(connection->Get(urlBuilder.GetSpecificVersionUrl("badProduct", c_version)), HttpNotFound);
+}
+
+TEST("Testing a response bigger than the maximum response size")
+{
+    test::MockWebServer server;
+    ReportingHandler handler;
+    handler.SetLoggingCallback(LogCallbackToTest);
+    CurlConnectionManager connectionManager(handler);
+    auto connection = connectionManager.MakeConnection({});
+    SFSUrlBuilder urlBuilder(SFSCustomUrl(server.GetBaseUrl()), c_instanceId, c_namespace, handler);
+
+    const std::string url = urlBuilder.GetSpecificVersionUrl(c_productName, c_version);
+    server.RegisterProduct(c_productName, c_version);
+
+    REQUIRE_NOTHROW(connection->Get(url));
+
+    connection->SetMaxResponseSize(10);
+    REQUIRE_THROWS_CODE_MSG(connection->Get(url),
+                            ConnectionUnexpectedError,
+                            "Response exceeded the maximum size of 10 bytes");
+
+    connection->SetMaxResponseSize(c_defaultMaxResponseSize);
+    REQUIRE_NOTHROW(connection->Get(url));
+}
+
+TEST("Testing a compressed response is limited by its decompressed size")
+{
+    test::MockWebServer server;
+    ReportingHandler handler;
+    handler.SetLoggingCallback(LogCallbackToTest);
+    CurlConnectionManager connectionManager(handler);
+    auto connection = connectionManager.MakeConnection({});
+    SFSUrlBuilder urlBuilder(SFSCustomUrl(server.GetBaseUrl()), c_instanceId, c_namespace, handler);
+
+    // A long name made of a single character makes a response that compresses to a tiny fraction of its size
+    const std::string largeProductName(200000, 'a');
+    server.RegisterProduct(largeProductName, c_version);
+
+    const std::string url = urlBuilder.GetLatestVersionBatchUrl();
+    const json body = {{{"TargetingAttributes", {}}, {"Product", largeProductName}}};
+
+    // The client accepts gzip, so the server compresses the response, which reaches the caller decompressed
+    std::string out;
+    REQUIRE_NOTHROW(out = connection->Post(url, body.dump()));
+    const auto acceptEncoding = server.GetLastRequestHeader("Accept-Encoding");
+    REQUIRE(acceptEncoding);
+    REQUIRE_THAT(*acceptEncoding, Catch::Matchers::ContainsSubstring("gzip"));
+    REQUIRE(json::parse(out)[0]["ContentId"]["Name"] == largeProductName);
+
+    // The bytes received over the wire are far under the limit, but the decompressed body goes over it
+    const size_t maxResponseSize = out.size() - 1;
+    connection->SetMaxResponseSize(maxResponseSize);
+    REQUIRE_THROWS_CODE_MSG(connection->Post(url, body.dump()),
+                            ConnectionUnexpectedError,
+                            "Response exceeded the maximum size of " + std::to_string(maxResponseSize) + " bytes");
+
+    connection->SetMaxResponseSize(out.size());
+    REQUIRE_NOTHROW(connection->Post(url, body.dump()));
+}
+
 TEST("Testing a url that's too big throws 414")
 {
     ReportingHandler handler;
@@ -11,6 +11,7 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <optional>
 #include <set>
 
 #define TEST(...) TEST_CASE("[Functional][SFSClientImplTests] " __VA_ARGS__)
@@ -23,16 +24,16 @@ namespace
 {
 void CheckProduct(const VersionEntity& entity, std::string_view ns, std::string_view name, std::string_view version)
 {
-    REQUIRE(entity.GetContentType() == ContentType::Generic);
-    REQUIRE(entity.contentId.nameSpace == ns);
-    REQUIRE(entity.contentId.name == name);
-    REQUIRE(entity.contentId.version == version);
+    REQUIRE(GetContentType(entity) == ContentType::Generic);
+    REQUIRE(GetBase(entity).contentId.nameSpace == ns);
+    REQUIRE(GetBase(entity).contentId.name == name);
+    REQUIRE(GetBase(entity).contentId.version == version);
 }
 
 void CheckAppProduct(const VersionEntity& entity, std::string_view ns, std::string_view name, std::string_view version)
 {
-    REQUIRE(entity.GetContentType() == ContentType::App);
-    auto appEntity = dynamic_cast<const AppVersionEntity&>(entity);
+    REQUIRE(GetContentType(entity) == ContentType::App);
+    const auto& appEntity = std::get<AppVersionEntity>(entity);
     REQUIRE(appEntity.contentId.nameSpace == ns);
     REQUIRE(appEntity.contentId.name == name);
     REQUIRE(appEntity.contentId.version == version);
@@ -48,8 +49,8 @@ void CheckProducts(const VersionEntities& entities,
     std::set<std::pair<std::string, std::string>> uniqueNameVersionPairs;
     for (const auto& entity : entities)
     {
-        REQUIRE(entity->contentId.nameSpace == ns);
-        uniqueNameVersionPairs.emplace(entity->contentId.name, entity->contentId.version);
+        REQUIRE(GetBase(entity).contentId.nameSpace == ns);
+        uniqueNameVersionPairs.emplace(GetBase(entity).contentId.name, GetBase(entity).contentId.version);
     }
 
     for (const auto& nameVersionPair : nameVersionPairs)
@@ -61,23 +62,23 @@ void CheckProducts(const VersionEntities& entities,
 void CheckDownloadInfo(const FileEntities& files, const std::string& name)
 {
     REQUIRE(files.size() == 2);
-    REQUIRE(files[0]->GetContentType() == ContentType::Generic);
-    REQUIRE(files[0]->fileId == (name + ".json"));
-    REQUIRE(files[0]->url == ("http://localhost/1.json"));
-    REQUIRE(files[1]->GetContentType() == ContentType::Generic);
-    REQUIRE(files[1]->fileId == (name + ".bin"));
-    REQUIRE(files[1]->url == ("http://localhost/2.bin"));
+    REQUIRE(GetContentType(files[0]) == ContentType::Generic);
+    REQUIRE(GetBase(files[0]).fileId == (name + ".json"));
+    REQUIRE(GetBase(files[0]).url == ("http://localhost/1.json"));
+    REQUIRE(GetContentType(files[1]) == ContentType::Generic);
+    REQUIRE(GetBase(files[1]).fileId == (name + ".bin"));
+    REQUIRE(GetBase(files[1]).url == ("http://localhost/2.bin"));
 }
 
 void CheckAppDownloadInfo(const FileEntities& files, const std::string& name)
 {
     REQUIRE(files.size() == 2);
-    REQUIRE(files[0]->GetContentType() == ContentType::App);
-    REQUIRE(files[0]->fileId == (name + ".json"));
-    REQUIRE(files[0]->url == ("http://localhost/1.json"));
-    REQUIRE(files[1]->GetContentType() == ContentType::App);
-    REQUIRE(files[1]->fileId == (name + ".bin"));
-    REQUIRE(files[1]->url == ("http://localhost/2.bin"));
+    REQUIRE(GetContentType(files[0]) == ContentType::App);
+    REQUIRE(GetBase(files[0]).fileId == (name + ".json"));
+    REQUIRE(GetBase(files[0]).url == ("http://localhost/1.json"));
+    REQUIRE(GetContentType(files[1]) == ContentType::App);
+    REQUIRE(GetBase(files[1]).fileId == (name + ".bin"));
+    REQUIRE(GetBase(files[1]).url == ("http://localhost/2.bin"));
 }
 } // namespace
 
@@ -102,7 +103,7 @@ TEST("Testing class SFSClientImpl()")
         SECTION("Testing SFSClientImpl::GetLatestVersion()")
         {
             server.RegisterExpectedRequestHeader(HttpHeader::ContentType, "application/json");
-            std::unique_ptr<VersionEntity> entity;
+            std::optional<VersionEntity> entity;
 
             SECTION("No attributes")
             {
@@ -140,7 +141,7 @@ TEST("Testing class SFSClientImpl()")
             {
                 REQUIRE_NOTHROW(entities = sfsClient.GetLatestVersionBatch({{"productName", {}}}, *connection));
                 REQUIRE(!entities.empty());
-                CheckProduct(*entities[0], ns, "productName", "0.0.0.2");
+                CheckProduct(entities[0], ns, "productName", "0.0.0.2");
             }
 
             SECTION("With attributes")
@@ -148,7 +149,7 @@ TEST("Testing class SFSClientImpl()")
                 const TargetingAttributes attributes{{"attr1", "value"}};
                 REQUIRE_NOTHROW(entities = sfsClient.GetLatestVersionBatch({{"productName", attributes}}, *connection));
                 REQUIRE(!entities.empty());
-                CheckProduct(*entities[0], ns, "productName", "0.0.0.2");
+                CheckProduct(entities[0], ns, "productName", "0.0.0.2");
             }
 
             SECTION("Wrong product name")
@@ -188,7 +189,7 @@ TEST("Testing class SFSClientImpl()")
                 REQUIRE_NOTHROW(entities = sfsClient.GetLatestVersionBatch({{"productName", {}}, {"productName", {}}},
                                                                            *connection));
                 REQUIRE(entities.size() == 1);
-                CheckProduct(*entities[0], ns, "productName", "0.0.0.2");
+                CheckProduct(entities[0], ns, "productName", "0.0.0.2");
 
                 server.RegisterProduct("productName2", "0.0.0.3");
 
@@ -213,13 +214,13 @@ TEST("Testing class SFSClientImpl()")
                 REQUIRE_NOTHROW(
                     entities = sfsClient.GetLatestVersionBatch({{"productName", {}}, {"badName", {}}}, *connection));
                 REQUIRE(entities.size() == 1);
-                CheckProduct(*entities[0], ns, "productName", "0.0.0.2");
+                CheckProduct(entities[0], ns, "productName", "0.0.0.2");
             }
         }
 
         SECTION("Testing SFSClientImpl::GetSpecificVersion()")
         {
-            std::unique_ptr<VersionEntity> entity;
+            std::optional<VersionEntity> entity;
             SECTION("Getting 0.0.0.1")
             {
                 REQUIRE_NOTHROW(entity = sfsClient.GetSpecificVersion("productName", "0.0.0.1", *connection));
@@ -291,7 +292,7 @@ TEST("Testing class SFSClientImpl()")
         SECTION("Testing SFSClientImpl::GetLatestVersion()")
         {
             server.RegisterExpectedRequestHeader(HttpHeader::ContentType, "application/json");
-            std::unique_ptr<VersionEntity> entity;
+            std::optional<VersionEntity> entity;
 
             SECTION("No attributes")
             {
@@ -219,6 +219,7 @@ class MockWebServerImpl : public BaseServerImpl
     void RegisterExpectedRequestHeader(std::string&& header, std::string&& value);
     void SetForcedHttpErrors(std::queue<HttpCode> forcedErrors);
     void SetResponseHeaders(std::unordered_map<HttpCode, HeaderMap> headersByCode);
+    std::optional<std::string> GetLastRequestHeader(const std::string& name) const;
 
   private:
     void ConfigureRequestHandlers() override;
@@ -245,6 +246,10 @@ class MockWebServerImpl : public BaseServerImpl
     std::unordered_map<std::string, std::string> m_expectedRequestHeaders;
     std::queue<HttpCode> m_forcedHttpErrors;
     std::unordered_map<HttpCode, HeaderMap> m_headersByCode;
+
+    // Requests are handled by the server threads while the test reads the headers of the last one
+    mutable std::mutex m_lastRequestMutex;
+    httplib::Headers m_lastRequestHeaders;
 };
 } // namespace SFS::test::details
 
@@ -301,6 +306,11 @@ void MockWebServer::SetResponseHeaders(std::unordered_map<HttpCode, HeaderMap> h
     m_impl->SetResponseHeaders(std::move(headersByCode));
 }
 
+std::optional<std::string> MockWebServer::GetLastRequestHeader(const std::string& name) const
+{
+    return m_impl->GetLastRequestHeader(name);
+}
+
 void MockWebServerImpl::ConfigureRequestHandlers()
 {
     ConfigurePostLatestVersion();
@@ -454,22 +464,29 @@ void MockWebServerImpl::ConfigurePostLatestVersionBatch()
                 json response = json::array();
                 for (const auto& [name, _] : requestedProducts)
                 {
-                    auto it = m_products.find(name);
-                    if (it == m_products.end())
+                    const std::string ns = req.path_params.at("ns");
+                    if (auto it = m_products.find(name); it != m_products.end())
                     {
-                        continue;
+                        const VersionList& versions = it->second;
+                        if (versions.empty())
+                        {
+                            throw StatusCodeException(httplib::StatusCode::InternalServerError_500);
+                        }
+
+                        const auto& latestVersion = *versions.rbegin();
+                        response.push_back(GenerateContentIdJsonObject(name, latestVersion, ns));
                     }
-
-                    const VersionList& versions = it->second;
-                    if (versions.empty())
+                    else if (auto appIt = m_appProducts.find(name); appIt != m_appProducts.end())
                     {
-                        throw StatusCodeException(httplib::StatusCode::InternalServerError_500);
+                        const auto& appList = appIt->second;
+                        if (appList.empty())
+                        {
+                            throw StatusCodeException(httplib::StatusCode::InternalServerError_500);
+                        }
+
+                        const auto& latestApp = *appList.rbegin();
+                        response.push_back(GenerateGetAppVersionJsonObject(name, latestApp, ns));
                     }
-
-                    const std::string ns = req.path_params.at("ns");
-                    const auto& latestVersion = *versions.rbegin();
-
-                    response.push_back(GenerateContentIdJsonObject(name, latestVersion, ns));
                 }
 
                 if (response.empty())
@@ -593,6 +610,11 @@ void MockWebServerImpl::RunHttpCallback(const httplib::Request& req,
                                         const std::string& apiVersion,
                                         const std::function<void(const httplib::Request, httplib::Response&)>& callback)
 {
+    {
+        std::lock_guard guard(m_lastRequestMutex);
+        m_lastRequestHeaders = req.headers;
+    }
+
     if (m_forcedHttpErrors.size() > 0)
     {
         res.status = m_forcedHttpErrors.front();
@@ -696,3 +718,14 @@ void MockWebServerImpl::SetResponseHeaders(std::unordered_map<HttpCode, HeaderMa
 {
     m_headersByCode = std::move(headersByCode);
 }
+
+std::optional<std::string> MockWebServerImpl::GetLastRequestHeader(const std::string& name) const
+{
+    std::lock_guard guard(m_lastRequestMutex);
+    const auto it = m_lastRequestHeaders.find(name);
+    if (it == m_lastRequestHeaders.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
@@ -6,6 +6,7 @@
 #include "Result.h"
 
 #include <memory>
+#include <optional>
 #include <queue>
 #include <string>
 #include <unordered_map>
@@ -62,6 +63,9 @@ class MockWebServer
     /// @brief Registers a set of headers that will be sent depending on the HTTP code
     void SetResponseHeaders(std::unordered_map<HttpCode, HeaderMap> headersByCode);
 
+    /// @brief Returns the value of the header @param name in the last request received, if it had it
+    std::optional<std::string> GetLastRequestHeader(const std::string& name) const;
+
   private:
     std::unique_ptr<details::MockWebServerImpl> m_impl;
 };
@@ -151,6 +151,153 @@ TEST("Testing AppContent::Make()")
     std::unique_ptr<AppContent> appContent =
         GetAppContent(contentNameSpace, contentName, contentVersion, "updateId", prerequisites, files);
     REQUIRE(appContent != nullptr);
+
+    SECTION("Copies share the same data")
+    {
+        const AppContent copy = *appContent;
+        REQUIRE((copy == *appContent));
+        REQUIRE(&copy.GetContentId() == &appContent->GetContentId());
+        REQUIRE(&copy.GetUpdateId() == &appContent->GetUpdateId());
+        REQUIRE(&copy.GetFiles() == &appContent->GetFiles());
+        REQUIRE(&copy.GetPrerequisites() == &appContent->GetPrerequisites());
+
+        const AppPrerequisiteContent prereqCopy = appContent->GetPrerequisites()[0];
+        REQUIRE(&prereqCopy.GetFiles() == &appContent->GetPrerequisites()[0].GetFiles());
+
+        // The data outlives the original
+        appContent.reset();
+        REQUIRE(copy.GetUpdateId() == "updateId");
+        REQUIRE(copy.GetFiles().size() == 2);
+        REQUIRE(prereqCopy.GetContentId().GetName() == "prereqName");
+    }
+}
+
+TEST("Testing AppContent file lookups")
+{
+    std::vector<AppFile> files;
+    files.push_back(std::move(
+        *GetAppFile("neutral", "url1", 1 /*sizeInBytes*/, {}, {Architecture::None}, {"platform"}, "moniker1")));
+    files.push_back(std::move(*GetAppFile("x64",
+                                          "url2",
+                                          1 /*sizeInBytes*/,
+                                          {},
+                                          {Architecture::x86, Architecture::Amd64},
+                                          {"platform"},
+                                          "moniker2")));
+    files.push_back(std::move(
+        *GetAppFile("arm64", "url3", 1 /*sizeInBytes*/, {}, {Architecture::Arm64}, {"platform"}, "moniker3")));
+
+    std::vector<AppPrerequisiteContent> prerequisites;
+    prerequisites.push_back(std::move(*GetPrerequisiteContent("myNameSpace", "prereqName", "prereqVersion", files)));
+
+    std::unique_ptr<AppContent> appContent =
+        GetAppContent("myNameSpace", "myName", "myVersion", "updateId", prerequisites, files);
+
+    auto checkLookups = [](const auto& content) {
+        const auto& contentFiles = content.GetFiles();
+
+        REQUIRE(content.FindFile("x64") == &contentFiles[1]);
+        REQUIRE(content.FindFile("moniker2") == nullptr);
+        REQUIRE(content.FindFileByMoniker("moniker3") == &contentFiles[2]);
+        REQUIRE(content.FindFileByMoniker("x64") == nullptr);
+
+        REQUIRE(content.FindApplicableFile(Architecture::Amd64) == &contentFiles[1]);
+        REQUIRE(content.FindApplicableFile(Architecture::x86) == &contentFiles[1]);
+        REQUIRE(content.FindApplicableFile(Architecture::Arm64) == &contentFiles[2]);
+
+        // Falls back to the architecture-neutral file
+        REQUIRE(content.FindApplicableFile(Architecture::Arm) == &contentFiles[0]);
+        REQUIRE(content.FindApplicableFile(Architecture::None) == &contentFiles[0]);
+
+        // There is a neutral file, so a file is found whatever the architecture of this machine
+        REQUIRE(content.FindApplicableFile() != nullptr);
+    };
+
+    SECTION("AppContent")
+    {
+        checkLookups(*appContent);
+    }
+
+    SECTION("AppPrerequisiteContent")
+    {
+        checkLookups(appContent->GetPrerequisites()[0]);
+    }
+
+    SECTION("No applicable file")
+    {
+        std::vector<AppFile> armFiles;
+        armFiles.push_back(std::move(
+            *GetAppFile("arm", "url", 1 /*sizeInBytes*/, {}, {Architecture::Arm}, {"platform"}, "moniker")));
+        std::unique_ptr<AppContent> armContent =
+            GetAppContent("myNameSpace", "myName", "myVersion", "updateId", {}, armFiles);
+        REQUIRE(armContent->FindApplicableFile(Architecture::Amd64) == nullptr);
+        REQUIRE(armContent->FindApplicableFile(Architecture::Arm) == &armContent->GetFiles()[0]);
+    }
+
+    SECTION("No architecture listed")
+    {
+        std::vector<AppFile> unlistedFiles;
+        unlistedFiles.push_back(std::move(
+            *GetAppFile("arm", "url1", 1 /*sizeInBytes*/, {}, {Architecture::Arm}, {"platform"}, "moniker1")));
+        unlistedFiles.push_back(
+            std::move(*GetAppFile("unlisted", "url2", 1 /*sizeInBytes*/, {}, {}, {"platform"}, "moniker2")));
+        std::unique_ptr<AppContent> unlistedContent =
+            GetAppContent("myNameSpace", "myName", "myVersion", "updateId", {}, unlistedFiles);
+
+        // Treated as architecture-neutral, like ApplicabilityFilter does
+        REQUIRE(unlistedContent->FindApplicableFile(Architecture::Amd64) == &unlistedContent->GetFiles()[1]);
+        REQUIRE(unlistedContent->FindApplicableFile(Architecture::None) == &unlistedContent->GetFiles()[1]);
+        REQUIRE(unlistedContent->FindApplicableFile(Architecture::Arm) == &unlistedContent->GetFiles()[0]);
+    }
+}
+
+TEST("Testing AppContent::GetFingerprint()")
+{
+    auto makeFiles = [](const std::string& platform) {
+        std::vector<AppFile> files;
+        files.push_back(std::move(
+            *GetAppFile("fileId1", "url1", 1 /*sizeInBytes*/, {}, {Architecture::Amd64}, {platform}, "moniker1")));
+        files.push_back(std::move(
+            *GetAppFile("fileId2", "url2", 1 /*sizeInBytes*/, {}, {Architecture::Arm64}, {platform}, "moniker2")));
+        return files;
+    };
+
+    std::vector<AppPrerequisiteContent> prerequisites;
+    prerequisites.push_back(
+        std::move(*GetPrerequisiteContent("myNameSpace", "prereq1", "1.0", makeFiles("myPlatform"))));
+    prerequisites.push_back(
+        std::move(*GetPrerequisiteContent("myNameSpace", "prereq2", "1.0", makeFiles("myPlatform"))));
+
+    std::unique_ptr<AppContent> appContent =
+        GetAppContent("myNameSpace", "myName", "myVersion", "updateId", prerequisites, makeFiles("myPlatform"));
+
+    SECTION("Equal contents have the same fingerprint")
+    {
+        std::unique_ptr<AppContent> other =
+            GetAppContent("myNameSpace", "myName", "myVersion", "updateId", prerequisites, makeFiles("myPlatform"));
+        REQUIRE((*other == *appContent));
+        REQUIRE(other->GetFingerprint() == appContent->GetFingerprint());
+        REQUIRE(other->GetPrerequisites()[0].GetFingerprint() == appContent->GetPrerequisites()[0].GetFingerprint());
+    }
+
+    SECTION("Different contents have different fingerprints")
+    {
+        std::unique_ptr<AppContent> other =
+            GetAppContent("myNameSpace", "myName", "myVersion", "otherId", prerequisites, makeFiles("myPlatform"));
+        REQUIRE(other->GetFingerprint() != appContent->GetFingerprint());
+
+        // Applicability details are part of the fingerprint
+        other =
+            GetAppContent("myNameSpace", "myName", "myVersion", "updateId", prerequisites, makeFiles("otherPlatform"));
+        REQUIRE(other->GetFingerprint() != appContent->GetFingerprint());
+
+        // Prerequisites are compared in order
+        std::vector<AppPrerequisiteContent> reversedPrerequisites{prerequisites[1], prerequisites[0]};
+        std::unique_ptr<AppContent> reversed = GetAppContent(
+            "myNameSpace", "myName", "myVersion", "updateId", reversedPrerequisites, makeFiles("myPlatform"));
+        REQUIRE((*reversed != *appContent));
+        REQUIRE(reversed->GetFingerprint() != appContent->GetFingerprint());
+    }
 }
 
 TEST("Testing AppContent equality operators")
@@ -31,7 +31,12 @@ TEST("Testing ApplicabilityDetails::Make()")
 
     const std::unique_ptr<ApplicabilityDetails> details = GetDetails(architectures, platformApplicabilityForPackage);
 
-    CHECK(architectures == details->GetArchitectures());
+    // Listed in the order of the Architecture values
+    CHECK(std::vector<Architecture>{Architecture::Amd64, Architecture::x86} == details->GetArchitectures());
+    CHECK(details->HasArchitecture(Architecture::x86));
+    CHECK(details->HasArchitecture(Architecture::Amd64));
+    CHECK_FALSE(details->HasArchitecture(Architecture::Arm64));
+    CHECK_FALSE(details->HasArchitecture(Architecture::None));
     CHECK(platformApplicabilityForPackage == details->GetPlatformApplicabilityForPackage());
 
     SECTION("Testing ApplicabilityDetails equality operators")
@@ -44,6 +49,10 @@ TEST("Testing ApplicabilityDetails::Make()")
             };
 
             CompareDetailsEqual(GetDetails(architectures, platformApplicabilityForPackage));
+
+            // The architectures are a set
+            CompareDetailsEqual(GetDetails({Architecture::Amd64, Architecture::x86, Architecture::Amd64},
+                                           platformApplicabilityForPackage));
         }
 
         SECTION("Not equal")
@@ -59,3 +68,15 @@ TEST("Testing ApplicabilityDetails::Make()")
         }
     }
 }
+
+TEST("Testing ApplicabilityDetails storage of architectures")
+{
+    const auto details = GetDetails({Architecture::Arm64, Architecture::None}, {});
+    const auto sameDetails = GetDetails({Architecture::None, Architecture::Arm64}, {});
+
+    // The architectures are a set of bits, so objects with the same architectures share the same list
+    CHECK(&details->GetArchitectures() == &sameDetails->GetArchitectures());
+    CHECK(sizeof(ApplicabilityDetails) < sizeof(std::vector<Architecture>) + sizeof(std::shared_ptr<void>));
+
+    CHECK(GetDetails({}, {})->GetArchitectures().empty());
+}
@@ -0,0 +1,181 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "sfsclient/ContentDiff.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#define TEST(...) TEST_CASE("[ContentDiffTests] " __VA_ARGS__)
+
+using namespace SFS;
+
+namespace
+{
+const std::string c_sha1 = "AAAAAAAAAAAAAAAAAAAAAAAAAAA=";
+const std::string c_otherSha1 = "BAAAAAAAAAAAAAAAAAAAAAAAAAA=";
+
+struct FileSpec
+{
+    std::string fileId;
+    uint64_t sizeInBytes;
+    std::unordered_map<HashType, std::string> hashes;
+    std::string url{"url"};
+};
+
+std::unique_ptr<Content> GetContent(const std::string& version, const std::vector<FileSpec>& specs)
+{
+    std::vector<File> files;
+    for (const auto& spec : specs)
+    {
+        std::unique_ptr<File> file;
+        REQUIRE(File::Make(spec.fileId, spec.url, spec.sizeInBytes, spec.hashes, file) == Result::Success);
+        files.push_back(std::move(*file));
+    }
+
+    std::unique_ptr<Content> content;
+    REQUIRE(Content::Make("myNameSpace", "myName", version, std::move(files), content) == Result::Success);
+    return content;
+}
+
+std::unique_ptr<AppContent> GetAppContent(const std::string& version, const std::vector<FileSpec>& specs)
+{
+    std::vector<AppFile> files;
+    for (const auto& spec : specs)
+    {
+        std::unique_ptr<AppFile> file;
+        REQUIRE(AppFile::Make(spec.fileId,
+                              spec.url,
+                              spec.sizeInBytes,
+                              spec.hashes,
+                              {Architecture::Amd64},
+                              {"platform"},
+                              spec.fileId + "Moniker",
+                              file) == Result::Success);
+        files.push_back(std::move(*file));
+    }
+
+    std::unique_ptr<ContentId> contentId;
+    REQUIRE(ContentId::Make("myNameSpace", "myName", version, contentId) == Result::Success);
+
+    std::unique_ptr<AppContent> content;
+    REQUIRE(AppContent::Make(std::move(contentId), "updateId", {}, std::move(files), content) == Result::Success);
+    return content;
+}
+
+template <typename FileT>
+std::vector<std::string> FileIds(const std::vector<const FileT*>& files)
+{
+    std::vector<std::string> ids;
+    for (const auto* file : files)
+    {
+        ids.push_back(file->GetFileId());
+    }
+    return ids;
+}
+} // namespace
+
+TEST("Testing DiffFiles() with Content")
+{
+    const auto from = GetContent("1.0",
+                                 {{"same", 1, {{HashType::Sha1, c_sha1}}},
+                                  {"moved", 1, {{HashType::Sha1, c_sha1}}, "oldUrl"},
+                                  {"resized", 1, {{HashType::Sha1, c_sha1}}},
+                                  {"rehashed", 1, {{HashType::Sha1, c_sha1}}},
+                                  {"removed", 1, {{HashType::Sha1, c_sha1}}}});
+
+    SECTION("Added, removed and changed files")
+    {
+        const auto to = GetContent("2.0",
+                                   {{"added", 1, {{HashType::Sha1, c_sha1}}},
+                                    {"rehashed", 1, {{HashType::Sha1, c_otherSha1}}},
+                                    {"resized", 2, {{HashType::Sha1, c_sha1}}},
+                                    {"moved", 1, {{HashType::Sha1, c_sha1}}, "newUrl"},
+                                    {"same", 1, {{HashType::Sha1, c_sha1}}}});
+
+        FilesDiff<File> diff;
+        REQUIRE(DiffFiles(*from, *to, diff) == Result::Success);
+        REQUIRE(FileIds(diff.added) == std::vector<std::string>{"added"});
+        REQUIRE(FileIds(diff.removed) == std::vector<std::string>{"removed"});
+        REQUIRE(FileIds(diff.changed) == std::vector<std::string>{"rehashed", "resized"});
+        REQUIRE(diff.added[0] == &to->GetFiles()[0]);
+        REQUIRE(diff.removed[0] == &from->GetFiles()[4]);
+        REQUIRE_FALSE(diff.IsEmpty());
+
+        // Swapping the contents swaps added and removed
+        REQUIRE(DiffFiles(*to, *from, diff) == Result::Success);
+        REQUIRE(FileIds(diff.added) == std::vector<std::string>{"removed"});
+        REQUIRE(FileIds(diff.removed) == std::vector<std::string>{"added"});
+        REQUIRE(FileIds(diff.changed) == std::vector<std::string>{"resized", "rehashed"});
+    }
+
+    SECTION("No differences")
+    {
+        FilesDiff<File> diff;
+        diff.added.push_back(&from->GetFiles()[0]);
+        REQUIRE(DiffFiles(*from, *from, diff) == Result::Success);
+        REQUIRE(diff.IsEmpty());
+    }
+
+    SECTION("Hash types that are added or are not digests are compared")
+    {
+        const auto withSha256 = GetContent("2.0", {{"same", 1, {{HashType::Sha1, c_sha1}, {HashType::Sha256, "x"}}}});
+        const auto withOtherSha256 =
+            GetContent("2.0", {{"same", 1, {{HashType::Sha1, c_sha1}, {HashType::Sha256, "y"}}}});
+
+        FilesDiff<File> diff;
+        REQUIRE(DiffFiles(*from, *withSha256, diff) == Result::Success);
+        REQUIRE(FileIds(diff.changed) == std::vector<std::string>{"same"});
+
+        REQUIRE(DiffFiles(*withSha256, *withOtherSha256, diff) == Result::Success);
+        REQUIRE(FileIds(diff.changed) == std::vector<std::string>{"same"});
+
+        REQUIRE(DiffFiles(*withSha256, *withSha256, diff) == Result::Success);
+        REQUIRE(diff.IsEmpty());
+    }
+
+    SECTION("Empty contents")
+    {
+        const auto empty = GetContent("2.0", {});
+
+        FilesDiff<File> diff;
+        REQUIRE(DiffFiles(*from, *empty, diff) == Result::Success);
+        REQUIRE(diff.added.empty());
+        REQUIRE(diff.removed.size() == from->GetFiles().size());
+        REQUIRE(diff.changed.empty());
+    }
+
+    SECTION("A FileId listed more than once is reported once")
+    {
+        const auto withDuplicates = GetContent("2.0",
+                                               {{"added", 1, {{HashType::Sha1, c_sha1}}},
+                                                {"added", 2, {{HashType::Sha1, c_sha1}}},
+                                                {"resized", 2, {{HashType::Sha1, c_sha1}}},
+                                                {"resized", 3, {{HashType::Sha1, c_sha1}}}});
+
+        FilesDiff<File> diff;
+        REQUIRE(DiffFiles(*from, *withDuplicates, diff) == Result::Success);
+        REQUIRE(FileIds(diff.added) == std::vector<std::string>{"added"});
+        REQUIRE(diff.added[0] == &withDuplicates->GetFiles()[0]);
+        REQUIRE(FileIds(diff.changed) == std::vector<std::string>{"resized"});
+        REQUIRE(diff.changed[0] == &withDuplicates->GetFiles()[2]);
+
+        REQUIRE(DiffFiles(*withDuplicates, *from, diff) == Result::Success);
+        REQUIRE(FileIds(diff.removed) == std::vector<std::string>{"added"});
+        REQUIRE(diff.removed[0] == &withDuplicates->GetFiles()[0]);
+    }
+}
+
+TEST("Testing DiffFiles() with AppContent")
+{
+    const auto from =
+        GetAppContent("1.0", {{"same", 1, {{HashType::Sha1, c_sha1}}}, {"changed", 1, {{HashType::Sha1, c_sha1}}}});
+    const auto to =
+        GetAppContent("2.0", {{"changed", 2, {{HashType::Sha1, c_sha1}}}, {"added", 1, {{HashType::Sha1, c_sha1}}}});
+
+    FilesDiff<AppFile> diff;
+    REQUIRE(DiffFiles(*from, *to, diff) == Result::Success);
+    REQUIRE(FileIds(diff.added) == std::vector<std::string>{"added"});
+    REQUIRE(FileIds(diff.removed) == std::vector<std::string>{"same"});
+    REQUIRE(FileIds(diff.changed) == std::vector<std::string>{"changed"});
+    REQUIRE(diff.changed[0]->GetFileMoniker() == "changedMoniker");
+}
@@ -6,6 +6,8 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <thread>
+
 #define TEST(...) TEST_CASE("[ContentTests] " __VA_ARGS__)
 #define TEST_SCENARIO(...) TEST_CASE("[ContentTests] Scenario: " __VA_ARGS__)
 
@@ -158,3 +160,120 @@ TEST("Testing Content equality operators")
         CompareContentNotEqual(GetContent(contentNameSpace, contentName, "MYVERSION", files));
     }
 }
+
+TEST("Testing Content copies")
+{
+    std::vector<File> files;
+    files.push_back(std::move(*GetFile("fileId", "url", 1 /*sizeInBytes*/, {{HashType::Sha1, "sha1"}})));
+
+    std::unique_ptr<Content> content = GetContent("myNameSpace", "myName", "myVersion", files);
+
+    SECTION("Copies share the same data")
+    {
+        Content copy = *content;
+        REQUIRE((copy == *content));
+        REQUIRE(&copy.GetContentId() == &content->GetContentId());
+        REQUIRE(&copy.GetFiles() == &content->GetFiles());
+
+        // The data outlives the original
+        content.reset();
+        REQUIRE(copy.GetContentId().GetName() == "myName");
+        REQUIRE(copy.GetFiles().size() == 1);
+    }
+
+    SECTION("Copies can be assigned")
+    {
+        std::unique_ptr<Content> other = GetContent("otherNameSpace", "otherName", "otherVersion", {});
+        Content copy = *other;
+        copy = *content;
+        REQUIRE(&copy.GetFiles() == &content->GetFiles());
+    }
+
+    SECTION("Copies can be read from multiple threads")
+    {
+        std::vector<Content> copies(4, *content);
+        std::vector<std::thread> threads;
+        for (const auto& copy : copies)
+        {
+            threads.emplace_back([&copy]() {
+                // Catch2 assertions are not thread-safe, so only read here
+                (void)copy.GetFiles()[0].GetSha1Digest();
+                Content nested = copy;
+                (void)nested.GetContentId().GetName();
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        for (const auto& copy : copies)
+        {
+            REQUIRE(&copy.GetFiles() == &content->GetFiles());
+        }
+    }
+}
+
+TEST("Testing Content::FindFile()")
+{
+    std::vector<File> files;
+    files.push_back(std::move(*GetFile("fileId1", "url1", 1 /*sizeInBytes*/, {{HashType::Sha1, "sha1"}})));
+    files.push_back(std::move(*GetFile("fileId2", "url2", 1 /*sizeInBytes*/, {{HashType::Sha1, "sha1"}})));
+    files.push_back(std::move(*GetFile("fileId1", "url3", 1 /*sizeInBytes*/, {{HashType::Sha1, "sha1"}})));
+
+    std::unique_ptr<Content> content = GetContent("myNameSpace", "myName", "myVersion", files);
+
+    const File* file = content->FindFile("fileId2");
+    REQUIRE(file == &content->GetFiles()[1]);
+
+    // The first file is returned for duplicated ids
+    file = content->FindFile("fileId1");
+    REQUIRE(file == &content->GetFiles()[0]);
+
+    REQUIRE(content->FindFile("FILEID1") == nullptr);
+    REQUIRE(content->FindFile("") == nullptr);
+
+    // Copies share the index
+    const Content copy = *content;
+    REQUIRE(copy.FindFile("fileId2") == &content->GetFiles()[1]);
+
+    std::unique_ptr<Content> emptyContent = GetContent("myNameSpace", "myName", "myVersion", {});
+    REQUIRE(emptyContent->FindFile("fileId1") == nullptr);
+}
+
+TEST("Testing Content::GetFingerprint()")
+{
+    std::vector<File> files;
+    files.push_back(std::move(*GetFile("fileId1", "url1", 1 /*sizeInBytes*/, {{HashType::Sha1, "sha1"}})));
+    files.push_back(std::move(*GetFile("fileId2", "url2", 1 /*sizeInBytes*/, {{HashType::Sha256, "sha256"}})));
+
+    std::unique_ptr<Content> content = GetContent("myNameSpace", "myName", "myVersion", files);
+
+    SECTION("Equal contents have the same fingerprint")
+    {
+        REQUIRE(GetContent("myNameSpace", "myName", "myVersion", files)->GetFingerprint() == content->GetFingerprint());
+
+        std::vector<File> reversedFiles;
+        reversedFiles.push_back(std::move(*GetFile("fileId2", "url2", 1, {{HashType::Sha256, "sha256"}})));
+        reversedFiles.push_back(std::move(*GetFile("fileId1", "url1", 1, {{HashType::Sha1, "sha1"}})));
+        std::unique_ptr<Content> reversed = GetContent("myNameSpace", "myName", "myVersion", reversedFiles);
+        REQUIRE((*reversed == *content));
+        REQUIRE(reversed->GetFingerprint() == content->GetFingerprint());
+
+        const Content copy = *content;
+        REQUIRE(copy.GetFingerprint() == content->GetFingerprint());
+    }
+
+    SECTION("Different contents have different fingerprints")
+    {
+        REQUIRE(GetContent("myNameSpace", "myName", "otherVersion", files)->GetFingerprint() !=
+                content->GetFingerprint());
+        REQUIRE(GetContent("myNameSpace", "myName", "myVersion", {})->GetFingerprint() != content->GetFingerprint());
+
+        std::vector<File> otherFiles;
+        otherFiles.push_back(std::move(*GetFile("fileId1", "url1", 1, {{HashType::Sha1, "sha1"}})));
+        otherFiles.push_back(std::move(*GetFile("fileId2", "url2", 2, {{HashType::Sha256, "sha256"}})));
+        std::unique_ptr<Content> other = GetContent("myNameSpace", "myName", "myVersion", otherFiles);
+        REQUIRE((*other != *content));
+        REQUIRE(other->GetFingerprint() != content->GetFingerprint());
+    }
+}
@@ -0,0 +1,153 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "SFSException.h"
+#include "sfsclient/DeferredAppContent.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <future>
+
+#define TEST(...) TEST_CASE("[DeferredAppContentTests] " __VA_ARGS__)
+
+using namespace SFS;
+using namespace SFS::details;
+
+namespace
+{
+std::unique_ptr<ContentId> GetContentId(const std::string& name, const std::string& version)
+{
+    std::unique_ptr<ContentId> contentId;
+    REQUIRE(ContentId::Make("ns", name, version, contentId) == Result::Success);
+    REQUIRE(contentId != nullptr);
+    return contentId;
+}
+
+std::vector<AppFile> GetAppFiles(const std::string& name)
+{
+    std::unique_ptr<AppFile> file;
+    REQUIRE(AppFile::Make(name + ".bin",
+                          "http://localhost/" + name,
+                          100,
+                          {{HashType::Sha256, "sha256"}},
+                          {Architecture::Amd64},
+                          {"Windows"},
+                          name,
+                          file) == Result::Success);
+    std::vector<AppFile> files;
+    files.push_back(std::move(*file));
+    return files;
+}
+
+std::unique_ptr<AppPrerequisiteContent> GetPrerequisiteContent(const std::string& name)
+{
+    std::unique_ptr<AppPrerequisiteContent> content;
+    REQUIRE(AppPrerequisiteContent::Make(GetContentId(name, "1.0"), GetAppFiles(name), content) == Result::Success);
+    REQUIRE(content != nullptr);
+    return content;
+}
+
+std::unique_ptr<DeferredAppPrerequisite> GetDeferredPrerequisite(const std::string& name,
+                                                                 std::promise<AppPrerequisiteContent>& promise)
+{
+    std::unique_ptr<DeferredAppPrerequisite> prerequisite;
+    REQUIRE(DeferredAppPrerequisite::Make(GetContentId(name, "1.0"), promise.get_future().share(), prerequisite) ==
+            Result::Success);
+    REQUIRE(prerequisite != nullptr);
+    return prerequisite;
+}
+} // namespace
+
+TEST("Testing DeferredAppPrerequisite::Make()")
+{
+    std::unique_ptr<DeferredAppPrerequisite> prerequisite;
+
+    SECTION("Requires a valid future")
+    {
+        auto result = DeferredAppPrerequisite::Make(GetContentId("prereq", "1.0"), {}, prerequisite);
+        REQUIRE(result.GetCode() == Result::InvalidArg);
+        REQUIRE(result.GetMsg() == "content must be a valid future");
+        REQUIRE(prerequisite == nullptr);
+    }
+
+    SECTION("Content id is available right away")
+    {
+        std::promise<AppPrerequisiteContent> promise;
+        prerequisite = GetDeferredPrerequisite("prereq", promise);
+        REQUIRE(prerequisite->GetContentId().GetName() == "prereq");
+        REQUIRE(prerequisite->GetContentId().GetVersion() == "1.0");
+        REQUIRE_FALSE(prerequisite->IsReady());
+    }
+}
+
+TEST("Testing DeferredAppPrerequisite::Get()")
+{
+    std::promise<AppPrerequisiteContent> promise;
+    auto prerequisite = GetDeferredPrerequisite("prereq", promise);
+    std::unique_ptr<AppPrerequisiteContent> content;
+
+    SECTION("Gets the retrieved prerequisite")
+    {
+        promise.set_value(std::move(*GetPrerequisiteContent("prereq")));
+        REQUIRE(prerequisite->IsReady());
+
+        REQUIRE(prerequisite->Get(content) == Result::Success);
+        REQUIRE(content != nullptr);
+        REQUIRE(content->GetContentId().GetName() == "prereq");
+        REQUIRE(content->GetFiles().size() == 1);
+
+        // Copies share the retrieved data
+        const DeferredAppPrerequisite copy = *prerequisite;
+        std::unique_ptr<AppPrerequisiteContent> other;
+        REQUIRE(copy.Get(other) == Result::Success);
+        REQUIRE(&other->GetFiles() == &content->GetFiles());
+    }
+
+    SECTION("Waits for the prerequisite")
+    {
+        auto setter = std::async(std::launch::async, [&] {
+            promise.set_value(std::move(*GetPrerequisiteContent("prereq")));
+        });
+        REQUIRE(prerequisite->Get(content) == Result::Success);
+        REQUIRE(content != nullptr);
+        setter.get();
+    }
+
+    SECTION("Returns the failure to retrieve it")
+    {
+        promise.set_exception(std::make_exception_ptr(SFSException(Result::HttpNotFound, "not found")));
+        REQUIRE(prerequisite->IsReady());
+
+        auto result = prerequisite->Get(content);
+        REQUIRE(result.GetCode() == Result::HttpNotFound);
+        REQUIRE(result.GetMsg() == "not found");
+        REQUIRE(content == nullptr);
+    }
+}
+
+TEST("Testing DeferredAppContent::Make()")
+{
+    std::promise<AppPrerequisiteContent> promise;
+    std::vector<DeferredAppPrerequisite> prerequisites;
+    prerequisites.push_back(std::move(*GetDeferredPrerequisite("prereq", promise)));
+
+    std::unique_ptr<DeferredAppContent> content;
+    REQUIRE(DeferredAppContent::Make(GetContentId("app", "2.0"),
+                                     "updateId",
+                                     std::move(prerequisites),
+                                     GetAppFiles("app"),
+                                     content) == Result::Success);
+    REQUIRE(content != nullptr);
+
+    REQUIRE(content->GetContentId().GetName() == "app");
+    REQUIRE(content->GetContentId().GetVersion() == "2.0");
+    REQUIRE(content->GetUpdateId() == "updateId");
+    REQUIRE(content->GetFiles().size() == 1);
+    REQUIRE(content->GetFiles()[0].GetFileId() == "app.bin");
+    REQUIRE(content->GetPrerequisites().size() == 1);
+    REQUIRE(content->GetPrerequisites()[0].GetContentId().GetName() == "prereq");
+    REQUIRE_FALSE(content->GetPrerequisites()[0].IsReady());
+
+    promise.set_value(std::move(*GetPrerequisiteContent("prereq")));
+    REQUIRE(content->GetPrerequisites()[0].IsReady());
+}
@@ -70,3 +70,77 @@ TEST("Testing File::Make()")
         }
     }
 }
+
+TEST("Testing File hash digests")
+{
+    // SHA1 and SHA256 of an empty input
+    const std::string sha1{"2jmj7l5rSw0yVb/vlWAYkK/YBwk="};
+    const std::string sha256{"47DEQpj8HBSa+/TImW+5JCeuQeRkm5NMpJWZG3hSuFU="};
+    const Sha1Digest sha1Digest{0xda, 0x39, 0xa3, 0xee, 0x5e, 0x6b, 0x4b, 0x0d, 0x32, 0x55,
+                                0xbf, 0xef, 0x95, 0x60, 0x18, 0x90, 0xaf, 0xd8, 0x07, 0x09};
+
+    SECTION("Base64 encoded digests are decoded")
+    {
+        const std::unordered_map<HashType, std::string> hashes{{HashType::Sha1, sha1}, {HashType::Sha256, sha256}};
+        const std::unique_ptr<File> file = GetFile("fileId", "url", 0, hashes);
+
+        REQUIRE(file->GetSha1Digest().has_value());
+        CHECK(*file->GetSha1Digest() == sha1Digest);
+        REQUIRE(file->GetSha256Digest().has_value());
+        CHECK(file->GetSha256Digest()->front() == 0xe3);
+        CHECK(file->GetSha256Digest()->back() == 0x55);
+        CHECK(hashes == file->GetHashes());
+    }
+
+    SECTION("Missing hashes have no digest")
+    {
+        const std::unique_ptr<File> file = GetFile("fileId", "url", 0, {{HashType::Sha1, sha1}});
+
+        CHECK(file->GetSha1Digest() == sha1Digest);
+        CHECK_FALSE(file->GetSha256Digest().has_value());
+        CHECK(file->GetHashes().size() == 1);
+    }
+
+    SECTION("Values that are not base64 encoded digests of the expected size are kept as given")
+    {
+        const std::unordered_map<HashType, std::string> hashes{{HashType::Sha1, sha256}, {HashType::Sha256, "!"}};
+        const std::unique_ptr<File> file = GetFile("fileId", "url", 0, hashes);
+
+        CHECK_FALSE(file->GetSha1Digest().has_value());
+        CHECK_FALSE(file->GetSha256Digest().has_value());
+        CHECK(hashes == file->GetHashes());
+    }
+
+    SECTION("Non-canonical encodings are kept as given")
+    {
+        // Same digest, but with non-zero trailing bits
+        const std::unordered_map<HashType, std::string> hashes{{HashType::Sha1, "2jmj7l5rSw0yVb/vlWAYkK/YBwl="}};
+        const std::unique_ptr<File> file = GetFile("fileId", "url", 0, hashes);
+
+        CHECK_FALSE(file->GetSha1Digest().has_value());
+        CHECK(hashes == file->GetHashes());
+    }
+
+    SECTION("Digests and other hashes are mixed")
+    {
+        const std::unordered_map<HashType, std::string> hashes{{HashType::Sha1, sha1}, {HashType::Sha256, "!"}};
+        const std::unique_ptr<File> file = GetFile("fileId", "url", 0, hashes);
+
+        CHECK(file->GetSha1Digest() == sha1Digest);
+        CHECK_FALSE(file->GetSha256Digest().has_value());
+        CHECK(hashes == file->GetHashes());
+
+        // Built once
+        CHECK(&file->GetHashes() == &file->GetHashes());
+    }
+}
+
+TEST("Testing File storage of hashes")
+{
+    using HashMap = std::unordered_map<HashType, std::string>;
+
+    // The hashes are inline binary digests, in place of a map of base64 strings that are too long for the small string
+    // buffer. Without counting their heap allocations, the map and two strings are already bigger
+    const size_t hashStorage = sizeof(File) - 2 * sizeof(std::string) - sizeof(uint64_t);
+    CHECK(hashStorage < sizeof(HashMap) + 2 * sizeof(std::string));
+}
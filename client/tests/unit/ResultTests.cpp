@@ -55,4 +55,5 @@ TEST("Testing ToString(Result)")
     REQUIRE(SFS::ToString(Result::Code::NotSet) == "NotSet");
     REQUIRE(SFS::ToString(Result::Code::OutOfMemory) == "OutOfMemory");
     REQUIRE(SFS::ToString(Result::Code::Unexpected) == "Unexpected");
+    REQUIRE(SFS::ToString(Result::Code::Cancelled) == "Cancelled");
 }
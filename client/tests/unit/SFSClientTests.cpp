@@ -208,7 +208,8 @@ TEST("Testing SFSClient::Make()")
 namespace
 {
 void TestProductInRequestParams(const std::function<Result(const RequestParams&)>& apiCall,
-                                const std::function<void()>& checkContents)
+                                const std::function<void()>& checkContents,
+                                bool acceptsMultipleProducts = false)
 {
     RequestParams params;
     SECTION("Product must not be empty")
@@ -237,13 +238,27 @@ void TestProductInRequestParams(const std::function<Result(const RequestParams&)
         checkContents();
     }
 
-    SECTION("Accepting multiple products is not implemented yet")
+    if (acceptsMultipleProducts)
     {
-        params.productRequests = {{"p1", {}}, {"p2", {}}};
-        auto result = apiCall(params);
-        REQUIRE(result.GetCode() == Result::NotImpl);
-        REQUIRE(result.GetMsg() == "There cannot be more than 1 productRequest at the moment");
-        checkContents();
+        SECTION("Product must not be empty, even among multiple products")
+        {
+            params.productRequests = {{"p1", {}}, {"", {}}};
+            auto result = apiCall(params);
+            REQUIRE(result.GetCode() == Result::InvalidArg);
+            REQUIRE(result.GetMsg() == "product must not be empty");
+            checkContents();
+        }
+    }
+    else
+    {
+        SECTION("Accepting multiple products is not implemented yet")
+        {
+            params.productRequests = {{"p1", {}}, {"p2", {}}};
+            auto result = apiCall(params);
+            REQUIRE(result.GetCode() == Result::NotImpl);
+            REQUIRE(result.GetMsg() == "There cannot be more than 1 productRequest at the moment");
+            checkContents();
+        }
     }
 
     SECTION("Fails if base cv is not correct")
@@ -312,6 +327,113 @@ TEST("Testing SFSClient::GetLatestDownloadInfo()")
         [&contents] { REQUIRE(contents.empty()); });
 }
 
+TEST("Testing SFSClient::GetLatestDownloadInfoIfUpdated()")
+{
+    auto sfsClient = GetSFSClient();
+    std::vector<Content> contents;
+    RequestParams params;
+
+    SECTION("Does not allow an empty request")
+    {
+        auto result = sfsClient->GetLatestDownloadInfoIfUpdated(params, {}, contents);
+        REQUIRE(result.GetCode() == Result::InvalidArg);
+        REQUIRE(result.GetMsg() == "productRequests cannot be empty");
+        REQUIRE(contents.empty());
+    }
+
+    SECTION("Product must not be empty, even among multiple products")
+    {
+        params.productRequests = {{"p1", {}}, {"", {}}};
+        auto result = sfsClient->GetLatestDownloadInfoIfUpdated(params, {{"p1", "1.0"}}, contents);
+        REQUIRE(result.GetCode() == Result::InvalidArg);
+        REQUIRE(result.GetMsg() == "product must not be empty");
+        REQUIRE(contents.empty());
+    }
+
+    SECTION("A product requested more than once must have the same attributes")
+    {
+        params.productRequests = {{"p1", {{"attr1", "value"}}}, {"p2", {}}, {"p1", {{"attr1", "otherValue"}}}};
+        auto result = sfsClient->GetLatestDownloadInfoIfUpdated(params, {}, contents);
+        REQUIRE(result.GetCode() == Result::InvalidArg);
+        REQUIRE(result.GetMsg() == "product [p1] is requested more than once with different attributes");
+        REQUIRE(contents.empty());
+    }
+}
+
+TEST("Testing SFSClient::Watch()")
+{
+    auto sfsClient = GetSFSClient();
+    std::unique_ptr<ProductWatcher> watcher;
+    WatchParams params;
+    params.onChange = [](Content&&) {};
+    params.products = {{{"p1", {}}, std::chrono::seconds(10), std::nullopt}};
+
+    auto requireInvalidArg = [&](const std::string& message) {
+        auto result = sfsClient->Watch(params, watcher);
+        REQUIRE(result.GetCode() == Result::InvalidArg);
+        REQUIRE(result.GetMsg() == message);
+        REQUIRE(watcher == nullptr);
+    };
+
+    SECTION("Does not allow empty products")
+    {
+        params.products.clear();
+        requireInvalidArg("products cannot be empty");
+    }
+
+    SECTION("Callback must not be empty")
+    {
+        params.onChange = nullptr;
+        requireInvalidArg("onChange must not be empty");
+    }
+
+    SECTION("Product must not be empty")
+    {
+        params.products.push_back({{"", {}}, std::chrono::seconds(10), std::nullopt});
+        requireInvalidArg("product must not be empty");
+    }
+
+    SECTION("Poll interval must be positive")
+    {
+        params.products[0].pollInterval = std::chrono::milliseconds::zero();
+        requireInvalidArg("pollInterval must be greater than 0");
+    }
+
+    SECTION("Products must be unique")
+    {
+        params.products.push_back({{"p1", {{"attr", "value"}}}, std::chrono::seconds(20), std::nullopt});
+        requireInvalidArg("product [p1] is watched more than once");
+    }
+
+    SECTION("Valid params start watching until the watcher is destroyed")
+    {
+        params.deviceId = "device";
+        REQUIRE(sfsClient->Watch(params, watcher));
+        REQUIRE(watcher != nullptr);
+        watcher.reset();
+    }
+}
+
+TEST("Testing SFSClient::StreamLatestDownloadInfo()")
+{
+    auto sfsClient = GetSFSClient();
+    size_t fileCount = 0;
+    const FileCallbackFn onFile = [&fileCount](const ContentId&, File&&) { ++fileCount; };
+
+    TestProductInRequestParams(
+        [&](const RequestParams& params) { return sfsClient->StreamLatestDownloadInfo(params, onFile); },
+        [&fileCount] { REQUIRE(fileCount == 0); });
+
+    SECTION("Callback must not be empty")
+    {
+        RequestParams params;
+        params.productRequests = {{"a", {}}};
+        auto result = sfsClient->StreamLatestDownloadInfo(params, nullptr);
+        REQUIRE(result.GetCode() == Result::InvalidArg);
+        REQUIRE(result.GetMsg() == "onFile must not be empty");
+    }
+}
+
 TEST("Testing SFSClient::GetAppLatestDownloadInfo()")
 {
     SECTION("With storeapps instance")
@@ -321,7 +443,8 @@ TEST("Testing SFSClient::GetAppLatestDownloadInfo()")
 
         TestProductInRequestParams(
             [&](const RequestParams& params) { return sfsClient->GetLatestAppDownloadInfo(params, contents); },
-            [&contents] { REQUIRE(contents.empty()); });
+            [&contents] { REQUIRE(contents.empty()); },
+            true /*acceptsMultipleProducts*/);
     }
 
     SECTION("Fails if not storeapps instanceId")
@@ -336,3 +459,61 @@ TEST("Testing SFSClient::GetAppLatestDownloadInfo()")
         REQUIRE(contents.empty());
     }
 }
+
+TEST("Testing SFSClient::GetLatestAppDownloadInfoDeferred()")
+{
+    SECTION("With storeapps instance")
+    {
+        auto sfsClient = GetSFSClient("storeapps");
+        std::vector<DeferredAppContent> contents;
+
+        TestProductInRequestParams(
+            [&](const RequestParams& params) { return sfsClient->GetLatestAppDownloadInfoDeferred(params, contents); },
+            [&contents] { REQUIRE(contents.empty()); },
+            true /*acceptsMultipleProducts*/);
+    }
+
+    SECTION("Fails if not storeapps instanceId")
+    {
+        auto sfsClient = GetSFSClient("testInstanceId");
+        std::vector<DeferredAppContent> contents;
+        RequestParams params;
+        params.productRequests = {{"a", {}}};
+        auto result = sfsClient->GetLatestAppDownloadInfoDeferred(params, contents);
+        REQUIRE(result.GetCode() == Result::Unexpected);
+        REQUIRE(result.GetMsg() == "At this moment only the \"storeapps\" instanceId can send app requests");
+        REQUIRE(contents.empty());
+    }
+}
+
+TEST("Testing SFSClient::StreamLatestAppDownloadInfo()")
+{
+    size_t fileCount = 0;
+    const AppFileCallbackFn onFile = [&fileCount](const ContentId&, AppFile&&) { ++fileCount; };
+
+    SECTION("With storeapps instance")
+    {
+        auto sfsClient = GetSFSClient("storeapps");
+
+        TestProductInRequestParams(
+            [&](const RequestParams& params) { return sfsClient->StreamLatestAppDownloadInfo(params, onFile); },
+            [&fileCount] { REQUIRE(fileCount == 0); });
+
+        RequestParams params;
+        params.productRequests = {{"a", {}}};
+        auto result = sfsClient->StreamLatestAppDownloadInfo(params, nullptr);
+        REQUIRE(result.GetCode() == Result::InvalidArg);
+        REQUIRE(result.GetMsg() == "onFile must not be empty");
+    }
+
+    SECTION("Fails if not storeapps instanceId")
+    {
+        auto sfsClient = GetSFSClient("testInstanceId");
+        RequestParams params;
+        params.productRequests = {{"a", {}}};
+        auto result = sfsClient->StreamLatestAppDownloadInfo(params, onFile);
+        REQUIRE(result.GetCode() == Result::Unexpected);
+        REQUIRE(result.GetMsg() == "At this moment only the \"storeapps\" instanceId can send app requests");
+        REQUIRE(fileCount == 0);
+    }
+}
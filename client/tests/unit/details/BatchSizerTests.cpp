@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "BatchSizer.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#define TEST(...) TEST_CASE("[BatchSizerTests] " __VA_ARGS__)
+
+using namespace SFS::details;
+using namespace std::chrono_literals;
+
+TEST("Testing BatchSizer()")
+{
+    SECTION("Starts with the initial size")
+    {
+        REQUIRE(BatchSizer().GetBatchSize() == c_initialBatchSize);
+        REQUIRE(BatchSizer(10, 100).GetBatchSize() == 10);
+    }
+
+    SECTION("Initial size is bounded")
+    {
+        REQUIRE(BatchSizer(0, 100).GetBatchSize() == 1);
+        REQUIRE(BatchSizer(200, 100).GetBatchSize() == 100);
+        REQUIRE(BatchSizer(10, 0).GetBatchSize() == 1);
+    }
+}
+
+TEST("Testing BatchSizer::OnSuccess()")
+{
+    BatchSizer sizer(10, 100);
+
+    SECTION("Grows after a fast full batch")
+    {
+        sizer.OnSuccess(10, 10ms, 1000);
+        REQUIRE(sizer.GetBatchSize() == 15);
+    }
+
+    SECTION("Does not grow after a fast partial batch")
+    {
+        sizer.OnSuccess(5, 10ms, 500);
+        REQUIRE(sizer.GetBatchSize() == 10);
+    }
+
+    SECTION("Does not grow past the max size")
+    {
+        for (int i = 0; i < 20; ++i)
+        {
+            sizer.OnSuccess(sizer.GetBatchSize(), 10ms, 100);
+        }
+        REQUIRE(sizer.GetBatchSize() == 100);
+    }
+
+    SECTION("Keeps the size after a batch close to the target latency")
+    {
+        sizer.OnSuccess(10, c_targetBatchLatency, 1000);
+        REQUIRE(sizer.GetBatchSize() == 10);
+    }
+
+    SECTION("Shrinks after a slow batch")
+    {
+        sizer.OnSuccess(10, c_targetBatchLatency + 1ms, 1000);
+        REQUIRE(sizer.GetBatchSize() == 5);
+
+        sizer.OnSuccess(1, c_targetBatchLatency + 1ms, 100);
+        REQUIRE(sizer.GetBatchSize() == 1);
+    }
+
+    SECTION("Is capped by the expected response size")
+    {
+        const size_t bytesPerProduct = c_targetBatchResponseSize / 4;
+        sizer.OnSuccess(10, 10ms, 10 * bytesPerProduct);
+        REQUIRE(sizer.GetBatchSize() == 4);
+
+        sizer.OnSuccess(1, 10ms, c_targetBatchResponseSize * 2);
+        REQUIRE(sizer.GetBatchSize() == 1);
+    }
+
+    SECTION("Ignores empty batches")
+    {
+        sizer.OnSuccess(0, 10ms, 0);
+        REQUIRE(sizer.GetBatchSize() == 10);
+    }
+}
+
+TEST("Testing BatchSizer::OnFailure()")
+{
+    BatchSizer sizer(10, 100);
+
+    SECTION("Halves the size of the failed batch")
+    {
+        sizer.OnFailure(10);
+        REQUIRE(sizer.GetBatchSize() == 5);
+
+        sizer.OnFailure(2);
+        REQUIRE(sizer.GetBatchSize() == 1);
+
+        sizer.OnFailure(1);
+        REQUIRE(sizer.GetBatchSize() == 1);
+    }
+
+    SECTION("Does not grow from a bigger failed batch")
+    {
+        sizer.OnFailure(50);
+        REQUIRE(sizer.GetBatchSize() == 5);
+    }
+}
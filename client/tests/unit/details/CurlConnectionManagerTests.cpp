@@ -46,3 +46,22 @@ TEST("Testing CurlConnectionManager()")
     auto Connection3 = curlConnectionManager3.MakeConnection({});
     auto Connection4 = curlConnectionManager3.MakeConnection({});
 }
+
+TEST("Testing CurlConnectionManager() with multiplexing")
+{
+    ReportingHandler handler;
+
+    ConnectionManagerConfig config;
+    config.maxStreamsPerConnection = 10;
+    CurlConnectionManager curlConnectionManager(handler, config);
+
+    std::unique_ptr<Connection> connection = curlConnectionManager.MakeConnection({});
+    REQUIRE(connection != nullptr);
+    REQUIRE(dynamic_cast<CurlConnection*>(connection.get()) != nullptr);
+
+    auto connection2 = curlConnectionManager.MakeConnection({});
+    REQUIRE(connection2 != nullptr);
+
+    // Connections may outlive each other in any order, as long as the manager outlives them
+    connection.reset();
+}
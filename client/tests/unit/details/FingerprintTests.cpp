@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "Fingerprint.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#define TEST(...) TEST_CASE("[FingerprintTests] " __VA_ARGS__)
+
+using namespace SFS;
+using namespace SFS::details;
+
+namespace
+{
+std::unique_ptr<File> MakeFile(const std::string& fileId, const std::string& url, const std::string& sha1)
+{
+    std::unique_ptr<File> file;
+    REQUIRE(File::Make(fileId, url, 1 /*sizeInBytes*/, {{HashType::Sha1, sha1}}, file) == Result::Success);
+    return file;
+}
+} // namespace
+
+TEST("Testing FingerprintBuilder")
+{
+    SECTION("Same values give the same fingerprint")
+    {
+        REQUIRE(FingerprintBuilder().Add("a").Add(uint64_t{1}).Finish() ==
+                FingerprintBuilder().Add("a").Add(uint64_t{1}).Finish());
+    }
+
+    SECTION("Strings don't collide by concatenation")
+    {
+        REQUIRE(FingerprintBuilder().Add("ab").Add("c").Finish() != FingerprintBuilder().Add("a").Add("bc").Finish());
+        REQUIRE(FingerprintBuilder().Add("").Finish() != FingerprintBuilder().Finish());
+        REQUIRE(FingerprintBuilder().Add("12345678").Finish() != FingerprintBuilder().Add("123456789").Finish());
+    }
+
+    SECTION("Order matters")
+    {
+        REQUIRE(FingerprintBuilder().Add("a").Add("b").Finish() != FingerprintBuilder().Add("b").Add("a").Finish());
+    }
+
+    SECTION("Fingerprints are stable")
+    {
+        // Fingerprints can be stored and compared across processes, so the algorithm must not change
+        const auto fingerprint = FingerprintBuilder().Add("namespace").Add("name").Add("1.0.0").Finish();
+        REQUIRE(fingerprint.high == 0x5439a4d00f9be370ull);
+        REQUIRE(fingerprint.low == 0xd91c70b41d50d5efull);
+    }
+}
+
+TEST("Testing FingerprintBuilder::OfUnordered()")
+{
+    const std::string sha1 = "AAAAAAAAAAAAAAAAAAAAAAAAAAA=";
+
+    std::vector<File> files;
+    files.push_back(std::move(*MakeFile("fileId1", "url1", sha1)));
+    files.push_back(std::move(*MakeFile("fileId2", "url2", sha1)));
+
+    std::vector<File> reversed;
+    reversed.push_back(std::move(*MakeFile("fileId2", "url2", sha1)));
+    reversed.push_back(std::move(*MakeFile("fileId1", "url1", sha1)));
+
+    REQUIRE(FingerprintBuilder::OfUnordered(files) == FingerprintBuilder::OfUnordered(reversed));
+
+    std::vector<File> duplicated;
+    duplicated.push_back(std::move(*MakeFile("fileId1", "url1", sha1)));
+    duplicated.push_back(std::move(*MakeFile("fileId1", "url1", sha1)));
+    REQUIRE(FingerprintBuilder::OfUnordered(files) != FingerprintBuilder::OfUnordered(duplicated));
+
+    std::vector<File> otherHash;
+    otherHash.push_back(std::move(*MakeFile("fileId1", "url1", "BAAAAAAAAAAAAAAAAAAAAAAAAAA=")));
+    otherHash.push_back(std::move(*MakeFile("fileId2", "url2", sha1)));
+    REQUIRE(FingerprintBuilder::OfUnordered(files) != FingerprintBuilder::OfUnordered(otherHash));
+
+    // Hashes that are not digests are part of the fingerprint too
+    std::vector<File> notDigest;
+    notDigest.push_back(std::move(*MakeFile("fileId1", "url1", "sha1")));
+    std::vector<File> otherNotDigest;
+    otherNotDigest.push_back(std::move(*MakeFile("fileId1", "url1", "sha2")));
+    REQUIRE(FingerprintBuilder::OfUnordered(notDigest) != FingerprintBuilder::OfUnordered(otherNotDigest));
+
+    REQUIRE(FingerprintBuilder::OfUnordered(std::vector<File>{}) != FingerprintBuilder::OfUnordered(files));
+}
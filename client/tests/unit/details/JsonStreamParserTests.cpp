@@ -0,0 +1,115 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "../../util/SFSExceptionMatcher.h"
+#include "../../util/TestHelper.h"
+#include "JsonStreamParser.h"
+#include "ReportingHandler.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include <nlohmann/json.hpp>
+
+#include <sstream>
+#include <vector>
+
+#define TEST(...) TEST_CASE("[JsonStreamParserTests] " __VA_ARGS__)
+
+using namespace SFS;
+using namespace SFS::details;
+using namespace SFS::test;
+
+namespace
+{
+std::vector<json> Parse(const std::string& data, const ReportingHandler& handler)
+{
+    std::istringstream stream(data);
+    std::vector<json> elements;
+    ParseJsonObjectArray(
+        stream,
+        [&](json&& element) { elements.push_back(std::move(element)); },
+        "TestMethod",
+        handler);
+    return elements;
+}
+} // namespace
+
+TEST("Testing ParseJsonObjectArray()")
+{
+    ReportingHandler handler;
+    handler.SetLoggingCallback(LogCallbackToTest);
+
+    SECTION("Elements are delivered in order and match a regular parse")
+    {
+        const json data = json::array({{{"FileId", "a"}, {"SizeInBytes", 1}},
+                                       {{"Nested", {{"Array", {1, -2, 3.5, true, nullptr}}, {"Object", json::object()}}},
+                                        {"Empty", json::array()}},
+                                       json::object()});
+
+        const auto elements = Parse(data.dump(), handler);
+        REQUIRE(elements.size() == 3);
+        for (size_t i = 0; i < elements.size(); ++i)
+        {
+            REQUIRE(elements[i] == data[i]);
+        }
+
+        // Unsigned numbers keep their type, which is validated by the entities
+        REQUIRE(elements[0]["SizeInBytes"].is_number_unsigned());
+    }
+
+    SECTION("Empty array")
+    {
+        REQUIRE(Parse("[]", handler).empty());
+        REQUIRE(Parse(" [ ] ", handler).empty());
+    }
+
+    SECTION("Response is not an array")
+    {
+        REQUIRE_THROWS_CODE_MSG(Parse("{}", handler), ServiceInvalidResponse, "Response is not a JSON array");
+        REQUIRE_THROWS_CODE_MSG(Parse("1", handler), ServiceInvalidResponse, "Response is not a JSON array");
+        REQUIRE_THROWS_CODE_MSG(Parse(R"("str")", handler), ServiceInvalidResponse, "Response is not a JSON array");
+    }
+
+    SECTION("Array element is not an object")
+    {
+        const std::string expectedMsg = "Array element is not a JSON object";
+        REQUIRE_THROWS_CODE_MSG(Parse("[1]", handler), ServiceInvalidResponse, expectedMsg);
+        REQUIRE_THROWS_CODE_MSG(Parse("[{}, []]", handler), ServiceInvalidResponse, expectedMsg);
+        REQUIRE_THROWS_CODE_MSG(Parse(R"([{}, "str"])", handler), ServiceInvalidResponse, expectedMsg);
+    }
+
+    SECTION("Invalid JSON")
+    {
+        const std::string expectedMsg = "(TestMethod) JSON Parsing error: ";
+        REQUIRE_THROWS_CODE_MSG_MATCHES(Parse("", handler),
+                                        ServiceInvalidResponse,
+                                        Catch::Matchers::StartsWith(expectedMsg));
+        REQUIRE_THROWS_CODE_MSG_MATCHES(Parse("[{}", handler),
+                                        ServiceInvalidResponse,
+                                        Catch::Matchers::StartsWith(expectedMsg));
+        REQUIRE_THROWS_CODE_MSG_MATCHES(Parse("[{]", handler),
+                                        ServiceInvalidResponse,
+                                        Catch::Matchers::StartsWith(expectedMsg));
+        REQUIRE_THROWS_CODE_MSG_MATCHES(Parse("[] []", handler),
+                                        ServiceInvalidResponse,
+                                        Catch::Matchers::StartsWith(expectedMsg));
+    }
+
+    SECTION("Errors from the element handler are propagated")
+    {
+        std::istringstream stream("[{}, {}]");
+        size_t count = 0;
+        REQUIRE_THROWS_CODE(ParseJsonObjectArray(
+                                stream,
+                                [&](json&&) {
+                                    if (++count == 2)
+                                    {
+                                        throw SFSException(Result::Unexpected);
+                                    }
+                                },
+                                "TestMethod",
+                                handler),
+                            Unexpected);
+        REQUIRE(count == 2);
+    }
+}
@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "LogQueue.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#define TEST(...) TEST_CASE("[LogQueueTests] " __VA_ARGS__)
+
+using namespace SFS::details;
+
+namespace
+{
+bool Push(LogQueue& queue, unsigned line)
+{
+    return queue.TryPush([&](LogRecord& record) { record.line = line; });
+}
+
+bool Pop(LogQueue& queue, unsigned& line)
+{
+    return queue.TryPop([&](const LogRecord& record) { line = record.line; });
+}
+} // namespace
+
+TEST("Testing LogQueue()")
+{
+    SECTION("Capacity is rounded up to a power of 2")
+    {
+        REQUIRE(LogQueue(0).Capacity() == 1);
+        REQUIRE(LogQueue(1).Capacity() == 1);
+        REQUIRE(LogQueue(3).Capacity() == 4);
+        REQUIRE(LogQueue(4).Capacity() == 4);
+        REQUIRE(LogQueue(100).Capacity() == 128);
+    }
+
+    SECTION("Starts empty")
+    {
+        LogQueue queue(4);
+        unsigned line = 0;
+        REQUIRE_FALSE(Pop(queue, line));
+    }
+}
+
+TEST("Testing LogQueue::TryPush() and LogQueue::TryPop()")
+{
+    LogQueue queue(4);
+    unsigned line = 0;
+
+    SECTION("Records are popped in the order they were pushed")
+    {
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            REQUIRE(Push(queue, i));
+        }
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            REQUIRE(Pop(queue, line));
+            REQUIRE(line == i);
+        }
+        REQUIRE_FALSE(Pop(queue, line));
+    }
+
+    SECTION("Pushing fails when full")
+    {
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            REQUIRE(Push(queue, i));
+        }
+        REQUIRE_FALSE(Push(queue, 4));
+
+        REQUIRE(Pop(queue, line));
+        REQUIRE(line == 0);
+        REQUIRE(Push(queue, 4));
+    }
+
+    SECTION("Slots are reused across laps")
+    {
+        for (unsigned i = 0; i < 100; ++i)
+        {
+            REQUIRE(Push(queue, i));
+            REQUIRE(Pop(queue, line));
+            REQUIRE(line == i);
+        }
+    }
+}
+
+TEST("Testing LogQueue with concurrent producers")
+{
+    LogQueue queue(64);
+
+    const unsigned producerCount = 4;
+    const unsigned recordsPerProducer = 10000;
+
+    std::vector<std::thread> producers;
+    for (unsigned producer = 0; producer < producerCount; ++producer)
+    {
+        producers.emplace_back([&, producer] {
+            for (unsigned i = 0; i < recordsPerProducer; ++i)
+            {
+                while (!Push(queue, producer * recordsPerProducer + i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Each producer's records are popped in the order that producer pushed them
+    std::vector<unsigned> nextRecord(producerCount, 0);
+    unsigned popped = 0;
+    bool inOrder = true;
+    while (popped < producerCount * recordsPerProducer)
+    {
+        unsigned line = 0;
+        if (!Pop(queue, line))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const unsigned producer = line / recordsPerProducer;
+        inOrder = inOrder && line % recordsPerProducer == nextRecord[producer];
+        ++nextRecord[producer];
+        ++popped;
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    REQUIRE(inOrder);
+    for (unsigned producer = 0; producer < producerCount; ++producer)
+    {
+        REQUIRE(nextRecord[producer] == recordsPerProducer);
+    }
+}
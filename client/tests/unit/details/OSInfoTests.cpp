@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "OSInfo.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#define TEST(...) TEST_CASE("[OSInfoTests] " __VA_ARGS__)
+
+using namespace SFS;
+using namespace SFS::details::osinfo;
+
+TEST("Testing ArchitectureFromMachineInfo()")
+{
+    SECTION("Windows names")
+    {
+        REQUIRE(ArchitectureFromMachineInfo("x64") == Architecture::Amd64);
+        REQUIRE(ArchitectureFromMachineInfo("x86") == Architecture::x86);
+        REQUIRE(ArchitectureFromMachineInfo("ARM") == Architecture::Arm);
+        REQUIRE(ArchitectureFromMachineInfo("ARM64") == Architecture::Arm64);
+    }
+
+    SECTION("uname names")
+    {
+        REQUIRE(ArchitectureFromMachineInfo("x86_64") == Architecture::Amd64);
+        REQUIRE(ArchitectureFromMachineInfo("i686") == Architecture::x86);
+        REQUIRE(ArchitectureFromMachineInfo("armv7l") == Architecture::Arm);
+        REQUIRE(ArchitectureFromMachineInfo("aarch64") == Architecture::Arm64);
+    }
+
+    SECTION("Unknown names")
+    {
+        REQUIRE(ArchitectureFromMachineInfo("Unknown") == Architecture::None);
+        REQUIRE(ArchitectureFromMachineInfo("riscv64") == Architecture::None);
+        REQUIRE(ArchitectureFromMachineInfo("") == Architecture::None);
+    }
+}
+
+TEST("Testing GetOSArchitecture()")
+{
+    REQUIRE(GetOSArchitecture() == ArchitectureFromMachineInfo(GetOSMachineInfo()));
+}
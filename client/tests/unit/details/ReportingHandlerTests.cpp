@@ -5,10 +5,13 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <mutex>
 #include <optional>
+#include <string>
 #include <thread>
+#include <vector>
 
 #define TEST(...) TEST_CASE("[ReportingHandlerTests] " __VA_ARGS__)
 
@@ -122,6 +125,77 @@ TEST("Testing LogFormatting")
     handler.SetLoggingCallback(nullptr);
 }
 
+TEST("Testing SetMinSeverity()")
+{
+    ReportingHandler handler;
+
+    std::vector<LogSeverity> severities;
+    handler.SetLoggingCallback([&](const LogData& data) { severities.push_back(data.severity); });
+
+    auto logAll = [&] {
+        severities.clear();
+        LOG_VERBOSE(handler, "Test");
+        LOG_INFO(handler, "Test");
+        LOG_WARNING(handler, "Test");
+        LOG_ERROR(handler, "Test");
+    };
+
+    logAll();
+    REQUIRE(severities.size() == 4);
+
+    handler.SetMinSeverity(LogSeverity::Info);
+    logAll();
+    REQUIRE(severities == std::vector<LogSeverity>{LogSeverity::Info, LogSeverity::Warning, LogSeverity::Error});
+
+    handler.SetMinSeverity(LogSeverity::Warning);
+    logAll();
+    REQUIRE(severities == std::vector<LogSeverity>{LogSeverity::Warning, LogSeverity::Error});
+
+    handler.SetMinSeverity(LogSeverity::Error);
+    logAll();
+    REQUIRE(severities == std::vector<LogSeverity>{LogSeverity::Error});
+
+    handler.SetMinSeverity(LogSeverity::Verbose);
+    logAll();
+    REQUIRE(severities.size() == 4);
+
+    handler.SetLoggingCallback(nullptr);
+}
+
+TEST("Testing dropped messages are not built")
+{
+    ReportingHandler handler;
+
+    int evaluations = 0;
+    auto argument = [&] {
+        ++evaluations;
+        return "Test";
+    };
+
+    SECTION("Without a callback")
+    {
+        REQUIRE_FALSE(handler.IsEnabled(LogSeverity::Error));
+        LOG_ERROR(handler, "Test %s", argument());
+        REQUIRE(evaluations == 0);
+    }
+
+    SECTION("Below the minimum severity")
+    {
+        handler.SetLoggingCallback([](const LogData&) {});
+        handler.SetMinSeverity(LogSeverity::Warning);
+
+        REQUIRE_FALSE(handler.IsEnabled(LogSeverity::Verbose));
+        REQUIRE_FALSE(handler.IsEnabled(LogSeverity::Info));
+        LOG_VERBOSE(handler, "Test %s", argument());
+        LOG_INFO(handler, "Test %s", argument());
+        REQUIRE(evaluations == 0);
+
+        REQUIRE(handler.IsEnabled(LogSeverity::Warning));
+        LOG_WARNING(handler, "Test %s", argument());
+        REQUIRE(evaluations == 1);
+    }
+}
+
 TEST("Testing setting another logging callback waits for an existing call to finish")
 {
     ReportingHandler handler;
@@ -188,3 +262,209 @@ TEST("Testing ToString(LogSeverity)")
     REQUIRE(SFS::ToString(LogSeverity::Error) == "Error");
     REQUIRE(SFS::ToString(LogSeverity::Verbose) == "Verbose");
 }
+
+TEST("Testing structured logging")
+{
+    ReportingHandler handler;
+
+    std::string format;
+    std::vector<LogField> fields;
+    std::string formattedMessage;
+    std::optional<LogSeverity> severity;
+    handler.SetStructuredLoggingCallback([&](const StructuredLogData& data) {
+        severity = data.severity;
+        format = data.format;
+        fields.assign(data.fields, data.fields + data.fieldCount);
+        formattedMessage = FormatLogMessage(data);
+        REQUIRE(FindField(data, "missing") == nullptr);
+    });
+
+    SECTION("Receives the arguments as fields")
+    {
+        const std::string product = "product";
+        LOG_INFO(handler,
+                 "Requesting [%s] attempt %u of %zu in %lld ms",
+                 LogArg("product", product),
+                 LogArg("attempt", 2u),
+                 size_t{3},
+                 -5ll);
+
+        REQUIRE(severity == LogSeverity::Info);
+        REQUIRE(format == "Requesting [%s] attempt %u of %zu in %lld ms");
+        REQUIRE(fields.size() == 4);
+        REQUIRE(fields[0].key == "product");
+        REQUIRE(std::get<std::string_view>(fields[0].value) == "product");
+        REQUIRE(fields[1].key == "attempt");
+        REQUIRE(std::get<uint64_t>(fields[1].value) == 2);
+        REQUIRE(fields[2].key.empty());
+        REQUIRE(std::get<uint64_t>(fields[2].value) == 3);
+        REQUIRE(std::get<int64_t>(fields[3].value) == -5);
+        REQUIRE(formattedMessage == "Requesting [product] attempt 2 of 3 in -5 ms");
+    }
+
+    SECTION("Without arguments")
+    {
+        LOG_WARNING(handler, "Test");
+        REQUIRE(severity == LogSeverity::Warning);
+        REQUIRE(fields.empty());
+        REQUIRE(formattedMessage == "Test");
+    }
+
+    SECTION("Formats like the logging callback")
+    {
+        std::string message;
+        handler.SetLoggingCallback([&](const LogData& data) { message = data.message; });
+
+        LOG_ERROR(handler, "%s|%5s|%-3d|%x|%.2f|100%%|%s", "a", LogArg("b", std::string("b")), 7, 255u, 1.5, "");
+        REQUIRE(message == "a|    b|7  |ff|1.50|100%|");
+        REQUIRE(formattedMessage == message);
+
+        handler.SetLoggingCallback(nullptr);
+    }
+
+    SECTION("Is subject to the minimum severity")
+    {
+        handler.SetMinSeverity(LogSeverity::Warning);
+        LOG_INFO(handler, "Test");
+        REQUIRE_FALSE(severity.has_value());
+    }
+
+    handler.SetStructuredLoggingCallback(nullptr);
+    LOG_ERROR(handler, "Dropped");
+    REQUIRE(format != "Dropped");
+}
+
+TEST("Testing FindField()")
+{
+    const LogField fields[] = {{"product", std::string_view("name")}, {{}, uint64_t{1}}, {"product", int64_t{2}}};
+    const StructuredLogData data{LogSeverity::Info, "", fields, 3, "", 0, "", {}};
+
+    const LogField* field = FindField(data, "product");
+    REQUIRE(field == &fields[0]);
+    REQUIRE(FindField(data, "version") == nullptr);
+}
+
+TEST("Testing asynchronous logging")
+{
+    ReportingHandler handler;
+
+    std::vector<std::string> messages;
+    std::thread::id callbackThread;
+    handler.SetLoggingCallback([&](const LogData& data) {
+        messages.emplace_back(data.message);
+        callbackThread = std::this_thread::get_id();
+    });
+
+    SECTION("Messages are delivered in order from another thread")
+    {
+        handler.StartAsyncLogging({});
+
+        LOG_INFO(handler, "Test");
+        LOG_INFO(handler, "Test %d", 2);
+        LOG_ERROR(handler, "Test %s", "3");
+        handler.Flush();
+
+        REQUIRE(messages == std::vector<std::string>{"Test", "Test 2", "Test 3"});
+        REQUIRE(callbackThread != std::this_thread::get_id());
+    }
+
+    SECTION("Oldest messages are dropped when the queue is full")
+    {
+        // Blocks the logging thread in the callback until the queue is full
+        std::mutex mutex;
+        std::atomic<bool> startedCall = false;
+        handler.SetLoggingCallback([&](const LogData& data) {
+            startedCall = true;
+            std::lock_guard guard(mutex);
+            messages.emplace_back(data.message);
+        });
+        handler.StartAsyncLogging({4, LogOverflowPolicy::DropOldest});
+
+        std::unique_lock lock(mutex);
+
+        LOG_INFO(handler, "Blocking");
+        while (!startedCall)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        for (int i = 0; i < 10; ++i)
+        {
+            LOG_INFO(handler, "Test %d", i);
+        }
+        lock.unlock();
+        handler.Flush();
+
+        REQUIRE(messages == std::vector<std::string>{"Blocking",
+                                                     "Test 6",
+                                                     "Test 7",
+                                                     "Test 8",
+                                                     "Test 9",
+                                                     "6 log messages were dropped because the logging queue was full"});
+    }
+
+    SECTION("No message is lost when blocking on a full queue")
+    {
+        std::atomic<size_t> count = 0;
+        handler.SetLoggingCallback([&](const LogData&) { ++count; });
+        handler.StartAsyncLogging({4, LogOverflowPolicy::Block});
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+        {
+            threads.emplace_back([&] {
+                for (int j = 0; j < 1000; ++j)
+                {
+                    LOG_INFO(handler, "Test %d", j);
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        handler.Flush();
+
+        REQUIRE(count == 4000);
+    }
+
+    SECTION("The callback can log while blocking on a full queue")
+    {
+        // The logging thread can't wait for itself, so the messages it logs drop the oldest ones instead
+        handler.SetLoggingCallback([&](const LogData& data) {
+            messages.emplace_back(data.message);
+            if (messages.size() == 1)
+            {
+                for (int i = 0; i < 10; ++i)
+                {
+                    LOG_INFO(handler, "Nested %d", i);
+                }
+            }
+        });
+        handler.StartAsyncLogging({4, LogOverflowPolicy::Block});
+
+        LOG_INFO(handler, "Test");
+        handler.Flush();
+        handler.Flush();
+
+        REQUIRE(messages == std::vector<std::string>{"Test",
+                                                     "Nested 6",
+                                                     "Nested 7",
+                                                     "Nested 8",
+                                                     "Nested 9",
+                                                     "6 log messages were dropped because the logging queue was full"});
+    }
+
+    SECTION("Setting another callback waits for the current batch")
+    {
+        handler.StartAsyncLogging({});
+
+        LOG_INFO(handler, "Test");
+        handler.Flush();
+        handler.SetLoggingCallback(nullptr);
+
+        LOG_INFO(handler, "Dropped");
+        handler.Flush();
+        REQUIRE(messages == std::vector<std::string>{"Test"});
+    }
+}
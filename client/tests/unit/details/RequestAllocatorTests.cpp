@@ -0,0 +1,134 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "Json.h"
+#include "RequestAllocator.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <nlohmann/json.hpp>
+
+#include <thread>
+
+#define TEST(...) TEST_CASE("[RequestAllocatorTests] " __VA_ARGS__)
+
+using namespace SFS::details;
+
+namespace
+{
+class CountingResource : public std::pmr::memory_resource
+{
+  public:
+    size_t allocations{0};
+    size_t allocatedBytes{0};
+
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations;
+        allocatedBytes += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+        allocatedBytes -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+} // namespace
+
+TEST("Testing ScopedRequestMemoryResource")
+{
+    CountingResource resource;
+    CountingResource otherResource;
+
+    REQUIRE(GetRequestMemoryResource() == std::pmr::new_delete_resource());
+    {
+        ScopedRequestMemoryResource scope(&resource);
+        REQUIRE(GetRequestMemoryResource() == &resource);
+        {
+            ScopedRequestMemoryResource nestedScope(&otherResource);
+            REQUIRE(GetRequestMemoryResource() == &otherResource);
+        }
+        REQUIRE(GetRequestMemoryResource() == &resource);
+        {
+            ScopedRequestMemoryResource nullScope(nullptr);
+            REQUIRE(GetRequestMemoryResource() == &resource);
+        }
+        REQUIRE(GetRequestMemoryResource() == &resource);
+
+        std::thread([]() { REQUIRE(GetRequestMemoryResource() == std::pmr::new_delete_resource()); }).join();
+    }
+    REQUIRE(GetRequestMemoryResource() == std::pmr::new_delete_resource());
+}
+
+TEST("Testing RequestAllocator")
+{
+    CountingResource resource;
+
+    SECTION("Allocates from the default resource without a scope")
+    {
+        RequestAllocator<int> allocator;
+        int* p = allocator.allocate(4);
+        allocator.deallocate(p, 4);
+        REQUIRE(resource.allocations == 0);
+    }
+
+    SECTION("Allocates from the resource of the scope")
+    {
+        RequestAllocator<double> allocator;
+        double* p = nullptr;
+        {
+            ScopedRequestMemoryResource scope(&resource);
+            p = allocator.allocate(3);
+        }
+        REQUIRE(reinterpret_cast<uintptr_t>(p) % alignof(double) == 0);
+        REQUIRE(resource.allocations == 1);
+        REQUIRE(resource.allocatedBytes >= 3 * sizeof(double));
+
+        // Released to the resource it came from, even after the scope has ended
+        allocator.deallocate(p, 3);
+        REQUIRE(resource.allocatedBytes == 0);
+    }
+
+    SECTION("Released to the right resource from another thread")
+    {
+        RequestAllocator<char> allocator;
+        char* p = nullptr;
+        {
+            ScopedRequestMemoryResource scope(&resource);
+            p = allocator.allocate(10);
+        }
+        std::thread([&]() { allocator.deallocate(p, 10); }).join();
+        REQUIRE(resource.allocatedBytes == 0);
+    }
+
+    SECTION("Parsed JSON is allocated from the resource of the scope")
+    {
+        {
+            ScopedRequestMemoryResource scope(&resource);
+            const json data = json::parse(R"([{"FileId": "file", "Hashes": {"Sha1": "abc"}}, [1, 2, 3]])");
+            REQUIRE(data[0]["FileId"] == "file");
+            REQUIRE(resource.allocations > 0);
+            REQUIRE(resource.allocatedBytes > 0);
+        }
+        REQUIRE(resource.allocatedBytes == 0);
+    }
+
+    SECTION("A monotonic buffer can serve parsing")
+    {
+        std::pmr::monotonic_buffer_resource arena(&resource);
+        {
+            ScopedRequestMemoryResource scope(&arena);
+            const json data = json::parse(R"({"a": [1, 2, {"b": null}]})");
+            REQUIRE(data["a"][2]["b"].is_null());
+        }
+        arena.release();
+        REQUIRE(resource.allocatedBytes == 0);
+    }
+}
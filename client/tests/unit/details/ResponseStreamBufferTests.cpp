@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "../../util/SFSExceptionMatcher.h"
+#include "connection/ResponseStreamBuffer.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <condition_variable>
+#include <istream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#define TEST(...) TEST_CASE("[ResponseStreamBufferTests] " __VA_ARGS__)
+
+using namespace SFS;
+using namespace SFS::details;
+
+using WriteResult = ResponseStreamBuffer::WriteResult;
+
+namespace
+{
+std::string ReadAll(ResponseStreamBuffer& buffer)
+{
+    std::istream stream(&buffer);
+    return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+}
+} // namespace
+
+TEST("Testing ResponseStreamBuffer")
+{
+    size_t resumeCount = 0;
+    const auto resumeWriter = [&resumeCount] { ++resumeCount; };
+
+    SECTION("Data written is read in order until the buffer is closed")
+    {
+        ResponseStreamBuffer buffer(1024, resumeWriter);
+        REQUIRE(buffer.Write("abc", 3) == WriteResult::Written);
+        REQUIRE(buffer.Write("", 0) == WriteResult::Written);
+        REQUIRE(buffer.Write("def", 3) == WriteResult::Written);
+        buffer.Close();
+
+        REQUIRE(ReadAll(buffer) == "abcdef");
+        REQUIRE(resumeCount == 0);
+    }
+
+    SECTION("Writes are refused while the buffer is full, and resumed once the reader makes room")
+    {
+        ResponseStreamBuffer buffer(4, resumeWriter);
+        REQUIRE(buffer.Write("0123", 4) == WriteResult::Written);
+        REQUIRE(buffer.Write("45", 2) == WriteResult::Full);
+        REQUIRE(resumeCount == 0);
+
+        std::istream stream(&buffer);
+        REQUIRE(stream.get() == '0');
+        REQUIRE(resumeCount == 1);
+
+        REQUIRE(buffer.Write("45", 2) == WriteResult::Written);
+        buffer.Close();
+
+        REQUIRE(std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()) == "12345");
+        REQUIRE(resumeCount == 1);
+    }
+
+    SECTION("Writes from another thread are resumed until the whole response is read")
+    {
+        // Every write after the first one is refused until the previous chunk is read
+        std::mutex resumeMutex;
+        std::condition_variable resumed;
+        ResponseStreamBuffer buffer(4, [&] {
+            std::lock_guard guard(resumeMutex);
+            ++resumeCount;
+            resumed.notify_all();
+        });
+        const std::string chunk = "0123";
+        const size_t chunkCount = 100;
+
+        std::thread writer([&]() {
+            for (size_t i = 0; i < chunkCount; ++i)
+            {
+                std::unique_lock lock(resumeMutex);
+                const size_t previousResumeCount = resumeCount;
+                lock.unlock();
+
+                if (buffer.Write(chunk.data(), chunk.size()) == WriteResult::Full)
+                {
+                    lock.lock();
+                    resumed.wait(lock, [&] { return resumeCount != previousResumeCount; });
+                    --i;
+                }
+            }
+            buffer.Close();
+        });
+
+        const std::string data = ReadAll(buffer);
+        writer.join();
+
+        REQUIRE(data.size() == chunk.size() * chunkCount);
+        for (size_t i = 0; i < chunkCount; ++i)
+        {
+            REQUIRE(data.compare(i * chunk.size(), chunk.size(), chunk) == 0);
+        }
+    }
+
+    SECTION("A chunk bigger than the limit is accepted")
+    {
+        ResponseStreamBuffer buffer(1, resumeWriter);
+        REQUIRE(buffer.Write("abcdef", 6) == WriteResult::Written);
+        buffer.Close();
+
+        REQUIRE(ReadAll(buffer) == "abcdef");
+    }
+
+    SECTION("Reads throw once the transfer is aborted")
+    {
+        ResponseStreamBuffer buffer(1024, resumeWriter);
+        REQUIRE(buffer.Write("abc", 3) == WriteResult::Written);
+        REQUIRE_FALSE(buffer.IsAborted());
+        buffer.Abort();
+        REQUIRE(buffer.IsAborted());
+
+        REQUIRE_THROWS_CODE(ReadAll(buffer), ConnectionUnexpectedError);
+    }
+
+    SECTION("Waiting for data")
+    {
+        ResponseStreamBuffer buffer(1024, resumeWriter);
+
+        SECTION("Returns true once data is written")
+        {
+            REQUIRE(buffer.Write("abc", 3) == WriteResult::Written);
+            REQUIRE(buffer.WaitForData());
+        }
+
+        SECTION("Returns false if the transfer ends without data")
+        {
+            buffer.Close();
+            REQUIRE_FALSE(buffer.WaitForData());
+        }
+    }
+
+    SECTION("Writes after the reader stops")
+    {
+        ResponseStreamBuffer buffer(1, resumeWriter);
+        REQUIRE(buffer.Write("abc", 3) == WriteResult::Written);
+        REQUIRE(buffer.Write("def", 3) == WriteResult::Full);
+
+        SECTION("Successfully, data is dropped")
+        {
+            buffer.StopReading(false /*failed*/);
+            REQUIRE(resumeCount == 1);
+            REQUIRE(buffer.Write("def", 3) == WriteResult::Written);
+        }
+
+        SECTION("With a failure, writes fail so the transfer is aborted")
+        {
+            buffer.StopReading(true /*failed*/);
+            REQUIRE(resumeCount == 1);
+            REQUIRE(buffer.Write("def", 3) == WriteResult::ReaderFailed);
+        }
+    }
+}
@@ -9,17 +9,22 @@
 #include "connection/ConnectionManager.h"
 #include "connection/CurlConnection.h"
 #include "connection/CurlConnectionManager.h"
+#include "connection/mock/MockConnection.h"
 #include "connection/mock/MockConnectionManager.h"
 
 #include <catch2/catch_test_macros.hpp>
 #include <nlohmann/json.hpp>
 
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
 #define TEST(...) TEST_CASE("[SFSClientImplTests] " __VA_ARGS__)
 
 using namespace SFS;
 using namespace SFS::details;
 using namespace SFS::test;
-using json = nlohmann::json;
 
 namespace
 {
@@ -67,6 +72,12 @@ class MockCurlConnection : public CurlConnection
         throw SFSException(m_responseCode);
     }
 
+    void StreamingPost(const std::string& url, const std::string& data, const ResponseStreamHandler& handler) override
+    {
+        // Streams the mocked response through the default implementation instead of performing a transfer
+        Connection::StreamingPost(url, data, handler);
+    }
+
   private:
     Result::Code& m_responseCode;
     std::string& m_getResponse;
@@ -74,21 +85,48 @@ class MockCurlConnection : public CurlConnection
     bool& m_expectEmptyPostBody;
 };
 
+class SizeLimitRecordingConnection : public MockConnection
+{
+  public:
+    SizeLimitRecordingConnection(const ReportingHandler& handler, std::string response)
+        : MockConnection({}, handler)
+        , m_response(std::move(response))
+    {
+    }
+
+    std::string Get(const std::string&) override
+    {
+        recordedMaxResponseSize = m_maxResponseSize;
+        return m_response;
+    }
+
+    std::string Post(const std::string&, const std::string&) override
+    {
+        recordedMaxResponseSize = m_maxResponseSize;
+        return m_response;
+    }
+
+    size_t recordedMaxResponseSize{0};
+
+  private:
+    std::string m_response;
+};
+
 void CheckProduct(const VersionEntity& entity, std::string_view ns, std::string_view name, std::string_view version)
 {
-    REQUIRE(entity.GetContentType() == ContentType::Generic);
-    REQUIRE(entity.contentId.nameSpace == ns);
-    REQUIRE(entity.contentId.name == name);
-    REQUIRE(entity.contentId.version == version);
+    REQUIRE(GetContentType(entity) == ContentType::Generic);
+    REQUIRE(GetBase(entity).contentId.nameSpace == ns);
+    REQUIRE(GetBase(entity).contentId.name == name);
+    REQUIRE(GetBase(entity).contentId.version == version);
 }
 
 void CheckDownloadInfo(const FileEntities& files, const std::string& name)
 {
     REQUIRE(files.size() == 2);
-    REQUIRE(files[0]->fileId == (name + ".json"));
-    REQUIRE(files[0]->url == ("http://localhost/1.json"));
-    REQUIRE(files[1]->fileId == (name + ".bin"));
-    REQUIRE(files[1]->url == ("http://localhost/2.bin"));
+    REQUIRE(GetBase(files[0]).fileId == (name + ".json"));
+    REQUIRE(GetBase(files[0]).url == ("http://localhost/1.json"));
+    REQUIRE(GetBase(files[1]).fileId == (name + ".bin"));
+    REQUIRE(GetBase(files[1]).url == ("http://localhost/2.bin"));
 }
 } // namespace
 
@@ -113,7 +151,7 @@ TEST("Testing class SFSClientImpl()")
     SECTION("Testing SFSClientImpl::GetLatestVersion()")
     {
         expectEmptyPostBody = false;
-        std::unique_ptr<VersionEntity> entity;
+        std::optional<VersionEntity> entity;
 
         SECTION("Expected response")
         {
@@ -183,7 +221,7 @@ TEST("Testing class SFSClientImpl()")
         {
             REQUIRE_NOTHROW(entities = sfsClient.GetLatestVersionBatch({{productName, {}}}, *connection));
             REQUIRE(!entities.empty());
-            CheckProduct(*entities[0], ns, productName, expectedVersion);
+            CheckProduct(entities[0], ns, productName, expectedVersion);
         }
 
         SECTION("With attributes")
@@ -191,7 +229,7 @@ TEST("Testing class SFSClientImpl()")
             const TargetingAttributes attributes{{"attr1", "value"}};
             REQUIRE_NOTHROW(entities = sfsClient.GetLatestVersionBatch({{productName, attributes}}, *connection));
             REQUIRE(!entities.empty());
-            CheckProduct(*entities[0], ns, productName, expectedVersion);
+            CheckProduct(entities[0], ns, productName, expectedVersion);
         }
 
         SECTION("Failing")
@@ -212,7 +250,7 @@ TEST("Testing class SFSClientImpl()")
         specificVersionResponse["ContentId"] = {{"Namespace", ns}, {"Name", productName}, {"Version", expectedVersion}};
         specificVersionResponse["Files"] = json::array({productName + ".json", productName + ".bin"});
         getResponse = specificVersionResponse.dump();
-        std::unique_ptr<VersionEntity> entity;
+        std::optional<VersionEntity> entity;
         SECTION("Getting version")
         {
             REQUIRE_NOTHROW(entity = sfsClient.GetSpecificVersion(productName, expectedVersion, *connection));
@@ -329,6 +367,85 @@ TEST("Testing ClientConfig validation")
             }
         }
     }
+
+    SECTION("responseSizeLimits must be greater than 0")
+    {
+        const std::string expectedErrorMsg = "ClientConfig::responseSizeLimits values must be greater than 0";
+
+        ClientConfig config;
+        config.accountId = "testAccountId";
+        REQUIRE_NOTHROW(SFSClientImpl<CurlConnectionManager>(ClientConfig(config)));
+
+        auto checkInvalid = [&](size_t ResponseSizeLimits::*limit) {
+            ClientConfig invalidConfig = config;
+            invalidConfig.responseSizeLimits.*limit = 0;
+            REQUIRE_THROWS_CODE_MSG(SFSClientImpl<CurlConnectionManager>(std::move(invalidConfig)),
+                                    InvalidArg,
+                                    expectedErrorMsg);
+        };
+
+        checkInvalid(&ResponseSizeLimits::latestVersion);
+        checkInvalid(&ResponseSizeLimits::latestVersionBatchPerProduct);
+        checkInvalid(&ResponseSizeLimits::specificVersion);
+        checkInvalid(&ResponseSizeLimits::downloadInfo);
+    }
+
+    SECTION("asyncLogging::queueSize must be greater than 0")
+    {
+        ClientConfig config;
+        config.accountId = "testAccountId";
+        config.asyncLogging = AsyncLoggingConfig{};
+        REQUIRE_NOTHROW(SFSClientImpl<CurlConnectionManager>(ClientConfig(config)));
+
+        config.asyncLogging->queueSize = 0;
+        REQUIRE_THROWS_CODE_MSG(SFSClientImpl<CurlConnectionManager>(std::move(config)),
+                                InvalidArg,
+                                "ClientConfig::asyncLogging::queueSize must be greater than 0");
+    }
+}
+
+TEST("Testing SFSClientImpl response size limits")
+{
+    const std::string ns = "testNameSpace";
+    const std::string productName = "productName";
+
+    ClientConfig config{"testAccountId", "testInstanceId", ns, LogCallbackToTest};
+    config.responseSizeLimits.latestVersion = 1;
+    config.responseSizeLimits.latestVersionBatchPerProduct = 2;
+    config.responseSizeLimits.specificVersion = 3;
+    config.responseSizeLimits.downloadInfo = 4;
+    SFSClientImpl<MockConnectionManager> sfsClient(std::move(config));
+
+    const json versionResponse = {{"ContentId", {{"Namespace", ns}, {"Name", productName}, {"Version", "0.0.0.1"}}}};
+
+    SECTION("GetLatestVersion")
+    {
+        SizeLimitRecordingConnection connection(sfsClient.GetReportingHandler(), versionResponse.dump());
+        REQUIRE_NOTHROW(sfsClient.GetLatestVersion({productName, {}}, connection));
+        REQUIRE(connection.recordedMaxResponseSize == 1);
+    }
+
+    SECTION("GetLatestVersionBatch scales with the number of products")
+    {
+        SizeLimitRecordingConnection connection(sfsClient.GetReportingHandler(),
+                                                json::array({versionResponse}).dump());
+        REQUIRE_NOTHROW(sfsClient.GetLatestVersionBatch({{productName, {}}, {"p2", {}}, {"p3", {}}}, connection));
+        REQUIRE(connection.recordedMaxResponseSize == 6);
+    }
+
+    SECTION("GetSpecificVersion")
+    {
+        SizeLimitRecordingConnection connection(sfsClient.GetReportingHandler(), versionResponse.dump());
+        REQUIRE_NOTHROW(sfsClient.GetSpecificVersion(productName, "0.0.0.1", connection));
+        REQUIRE(connection.recordedMaxResponseSize == 3);
+    }
+
+    SECTION("GetDownloadInfo")
+    {
+        SizeLimitRecordingConnection connection(sfsClient.GetReportingHandler(), json::array().dump());
+        REQUIRE_NOTHROW(sfsClient.GetDownloadInfo(productName, "0.0.0.1", connection));
+        REQUIRE(connection.recordedMaxResponseSize == 4);
+    }
 }
 
 TEST("Testing SFSClientImpl::SetCustomBaseUrl()")
@@ -408,3 +525,80 @@ TEST("Testing passing a logging callback to constructor of SFSClientImpl")
         {"testAccountId", "testInstanceId", "testNameSpace", [](const LogData&) {}});
     SFSClientImpl<MockConnectionManager> sfsClient2({"testAccountId", "testInstanceId", "testNameSpace", nullptr});
 }
+
+TEST("Testing passing a minimum log severity to constructor of SFSClientImpl")
+{
+    std::vector<LogSeverity> severities;
+    ClientConfig config{"testAccountId", "testInstanceId", "testNameSpace", [&](const LogData& data) {
+                            severities.push_back(data.severity);
+                        }};
+    config.minLogSeverity = LogSeverity::Warning;
+    SFSClientImpl<MockConnectionManager> sfsClient(std::move(config));
+
+    LOG_VERBOSE(sfsClient.GetReportingHandler(), "Test");
+    LOG_INFO(sfsClient.GetReportingHandler(), "Test");
+    LOG_WARNING(sfsClient.GetReportingHandler(), "Test");
+    LOG_ERROR(sfsClient.GetReportingHandler(), "Test");
+    REQUIRE(severities == std::vector<LogSeverity>{LogSeverity::Warning, LogSeverity::Error});
+}
+
+TEST("Testing asynchronous logging of SFSClientImpl")
+{
+    std::vector<std::string> messages;
+    std::thread::id callbackThread;
+    ClientConfig config{"testAccountId", "testInstanceId", "testNameSpace", [&](const LogData& data) {
+                            messages.emplace_back(data.message);
+                            callbackThread = std::this_thread::get_id();
+                        }};
+    config.asyncLogging = AsyncLoggingConfig{};
+
+    {
+        SFSClientImpl<MockConnectionManager> sfsClient(std::move(config));
+        LOG_INFO(sfsClient.GetReportingHandler(), "Test %d", 1);
+        LOG_INFO(sfsClient.GetReportingHandler(), "Test %d", 2);
+    }
+
+    // Messages still queued are delivered when the client is destroyed
+    REQUIRE(messages.size() >= 2);
+    REQUIRE(messages[messages.size() - 2] == "Test 1");
+    REQUIRE(messages.back() == "Test 2");
+    REQUIRE(callbackThread != std::this_thread::get_id());
+}
+
+TEST("Testing passing a structured logging callback to constructor of SFSClientImpl")
+{
+    const std::string ns = "testNameSpace";
+    const std::string productName = "productName";
+
+    std::vector<std::string> products;
+    std::vector<std::string> urls;
+    ClientConfig config{"testAccountId", "testInstanceId", ns, std::nullopt};
+    config.structuredLogCallbackFn = [&](const StructuredLogData& data) {
+        if (const auto* product = FindField(data, "product"))
+        {
+            products.emplace_back(std::get<std::string_view>(product->value));
+        }
+        if (const auto* url = FindField(data, "url"))
+        {
+            urls.emplace_back(std::get<std::string_view>(url->value));
+        }
+    };
+    SFSClientImpl<CurlConnectionManager> sfsClient(std::move(config));
+
+    Result::Code responseCode = Result::Success;
+    std::string getResponse;
+    std::string postResponse =
+        json{{"ContentId", {{"Namespace", ns}, {"Name", productName}, {"Version", "0.0.0.2"}}}}.dump();
+    bool expectEmptyPostBody = false;
+    MockCurlConnection connection(sfsClient.GetReportingHandler(),
+                                  responseCode,
+                                  getResponse,
+                                  postResponse,
+                                  expectEmptyPostBody);
+
+    REQUIRE_NOTHROW(sfsClient.GetLatestVersion({productName, {}}, connection));
+    REQUIRE(!products.empty());
+    REQUIRE(products[0] == productName);
+    REQUIRE(urls.size() == 1);
+    REQUIRE(urls[0] == sfsClient.MakeUrlBuilder().GetLatestVersionUrl(productName));
+}
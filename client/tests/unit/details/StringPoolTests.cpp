@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "StringPool.h"
+#include "sfsclient/AppFile.h"
+#include "sfsclient/ContentId.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+
+#define TEST(...) TEST_CASE("[StringPoolTests] " __VA_ARGS__)
+
+using namespace SFS;
+using namespace SFS::details;
+
+namespace
+{
+std::shared_ptr<const std::vector<std::string>> MakeList(std::vector<std::string> values)
+{
+    return std::make_shared<const std::vector<std::string>>(std::move(values));
+}
+
+std::unique_ptr<AppFile> GetAppFile(const std::vector<std::string>& platformApplicabilityForPackage)
+{
+    std::unique_ptr<AppFile> file;
+    REQUIRE(AppFile::Make("fileId", "url", 1, {}, {Architecture::x86}, platformApplicabilityForPackage, "", file) ==
+            Result::Success);
+    return file;
+}
+} // namespace
+
+TEST("Testing StringPool::Intern()")
+{
+    StringPool pool(10);
+
+    SECTION("Strings")
+    {
+        auto first = pool.Intern(std::string("Windows.Desktop"));
+        auto second = pool.Intern(std::string("Windows.Desktop"));
+        auto other = pool.Intern(std::string("Windows.Server"));
+
+        REQUIRE(first == second);
+        REQUIRE(first != other);
+        REQUIRE(*first == "Windows.Desktop");
+        REQUIRE(*other == "Windows.Server");
+        REQUIRE(pool.Size() == 2);
+    }
+
+    SECTION("Lists")
+    {
+        auto first = pool.Intern(MakeList({"Windows.Desktop", "Windows.Server"}));
+        auto second = pool.Intern(MakeList({"Windows.Desktop", "Windows.Server"}));
+        auto other = pool.Intern(MakeList({"Windows.DesktopWindows.Server"}));
+        auto empty = pool.Intern(MakeList({}));
+
+        REQUIRE(first == second);
+        REQUIRE(first != other);
+        REQUIRE(first != empty);
+        REQUIRE(empty->empty());
+        REQUIRE(pool.Size() == 3);
+    }
+
+    SECTION("ContentId")
+    {
+        auto contentId1 = pool.MakeContentId("ns", "name", "1.0.0.0");
+        auto contentId2 = pool.MakeContentId("ns", "name", "1.0.0.0");
+
+        REQUIRE(contentId1->GetNameSpace().data() == contentId2->GetNameSpace().data());
+        REQUIRE(contentId1->GetName().data() == contentId2->GetName().data());
+        REQUIRE(contentId2->GetNameSpace() == "ns");
+        REQUIRE(contentId2->GetName() == "name");
+        REQUIRE(contentId2->GetVersion() == "1.0.0.0");
+    }
+
+    SECTION("AppFile")
+    {
+        auto file1 = GetAppFile({"Windows.Desktop"});
+        auto file2 = GetAppFile({"Windows.Desktop"});
+
+        pool.Intern(*file1);
+        pool.Intern(*file2);
+
+        REQUIRE(&file1->GetApplicabilityDetails().GetPlatformApplicabilityForPackage() ==
+                &file2->GetApplicabilityDetails().GetPlatformApplicabilityForPackage());
+        REQUIRE(file2->GetApplicabilityDetails().GetPlatformApplicabilityForPackage() ==
+                std::vector<std::string>{"Windows.Desktop"});
+    }
+}
+
+TEST("Testing StringPool growth is bounded")
+{
+    StringPool pool(2);
+
+    auto first = pool.Intern(std::string("first"));
+    auto second = pool.Intern(std::string("second"));
+    REQUIRE(pool.Size() == 2);
+
+    SECTION("Values are not pooled while the pool is full of referenced values")
+    {
+        auto third = pool.Intern(std::string("third"));
+        REQUIRE(*third == "third");
+        REQUIRE(pool.Intern(std::string("third")) != third);
+        REQUIRE(pool.Size() == 2);
+
+        // Existing values are still shared
+        REQUIRE(pool.Intern(std::string("first")) == first);
+    }
+
+    SECTION("Unreferenced values are dropped to make room")
+    {
+        first.reset();
+
+        auto third = pool.Intern(std::string("third"));
+        REQUIRE(pool.Intern(std::string("third")) == third);
+        REQUIRE(pool.Intern(std::string("second")) == second);
+        REQUIRE(pool.Size() == 2);
+    }
+
+    SECTION("After a search that frees nothing, values are turned away before searching again")
+    {
+        REQUIRE(pool.Intern(std::string("third")) != pool.Intern(std::string("third")));
+        first.reset();
+
+        // The search kept 2 values, and only 1 value was turned away since then
+        auto fourth = pool.Intern(std::string("fourth"));
+        REQUIRE(*fourth == "fourth");
+
+        auto fifth = pool.Intern(std::string("fifth"));
+        REQUIRE(pool.Intern(std::string("fifth")) == fifth);
+        REQUIRE(pool.Intern(std::string("second")) == second);
+        REQUIRE(pool.Size() == 2);
+    }
+}
+
+TEST("Testing StringPool from multiple threads")
+{
+    StringPool pool(100);
+
+    const size_t threadCount = 8;
+    std::vector<std::shared_ptr<const std::string>> results(threadCount);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back([&pool, &results, i]() {
+            for (int j = 0; j < 100; ++j)
+            {
+                pool.Intern(std::string("value" + std::to_string(j)));
+            }
+            results[i] = pool.Intern(std::string("shared"));
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto& result : results)
+    {
+        REQUIRE(result == results[0]);
+    }
+    REQUIRE(pool.Size() <= 100);
+}
@@ -5,6 +5,11 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
 #define TEST(...) TEST_CASE("[UtilTests] " __VA_ARGS__)
 
 using namespace SFS::details::util;
@@ -30,3 +35,39 @@ TEST("Testing AreNotEqualI")
     REQUIRE(AreNotEqualI("ab", "abc"));
     REQUIRE(AreNotEqualI("abc", "abd"));
 }
+
+TEST("Testing Base64Encode and Base64Decode")
+{
+    const std::vector<std::pair<std::string, std::string>> cases{{"", ""},
+                                                                 {"f", "Zg=="},
+                                                                 {"fo", "Zm8="},
+                                                                 {"foo", "Zm9v"},
+                                                                 {"foob", "Zm9vYg=="},
+                                                                 {"fooba", "Zm9vYmE="},
+                                                                 {"foobar", "Zm9vYmFy"}};
+
+    for (const auto& [decoded, encoded] : cases)
+    {
+        INFO(encoded);
+        const auto* data = reinterpret_cast<const uint8_t*>(decoded.data());
+        REQUIRE(Base64Encode(data, decoded.size()) == encoded);
+
+        std::vector<uint8_t> out(decoded.size());
+        REQUIRE(Base64Decode(encoded, out.data(), out.size()));
+        REQUIRE(std::equal(out.begin(), out.end(), data, data + decoded.size()));
+    }
+
+    SECTION("Invalid encodings")
+    {
+        uint8_t out[3];
+        REQUIRE_FALSE(Base64Decode("Zm9", out, 2));
+        REQUIRE_FALSE(Base64Decode("Zm8", out, 3));
+        REQUIRE_FALSE(Base64Decode("Zm8=", out, 3));
+        REQUIRE_FALSE(Base64Decode("Zm9v", out, 2));
+        REQUIRE_FALSE(Base64Decode("Zm!v", out, 3));
+        REQUIRE_FALSE(Base64Decode("Zm=v", out, 3));
+        REQUIRE_FALSE(Base64Decode("Zm9=", out, 2));
+        REQUIRE_FALSE(Base64Decode("Zg=a", out, 1));
+        REQUIRE_FALSE(Base64Decode("Zh==", out, 1));
+    }
+}
@@ -0,0 +1,100 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "WatchSchedule.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <string>
+
+#define TEST(...) TEST_CASE("[WatchScheduleTests] " __VA_ARGS__)
+
+using namespace SFS::details;
+using namespace std::chrono_literals;
+
+TEST("Testing JitterOffset()")
+{
+    SECTION("Is stable for a device")
+    {
+        REQUIRE(JitterOffset("device", 1h) == JitterOffset("device", 1h));
+    }
+
+    SECTION("Is within the interval")
+    {
+        for (const auto* device : {"", "a", "device", "another-device"})
+        {
+            const auto offset = JitterOffset(device, 1000ms);
+            REQUIRE(offset >= 0ms);
+            REQUIRE(offset < 1000ms);
+        }
+    }
+
+    SECTION("Spreads devices over the interval")
+    {
+        bool differs = false;
+        const auto first = JitterOffset("device0", 1h);
+        for (int i = 1; i < 10 && !differs; ++i)
+        {
+            differs = JitterOffset("device" + std::to_string(i), 1h) != first;
+        }
+        REQUIRE(differs);
+    }
+
+    SECTION("Is zero for an empty interval")
+    {
+        REQUIRE(JitterOffset("device", 0ms) == 0ms);
+    }
+}
+
+TEST("Testing WatchSchedule")
+{
+    const WatchSchedule::Clock::time_point start{};
+    const std::string deviceId = "device";
+    const auto offset = JitterOffset(deviceId, 1h);
+
+    SECTION("Products are first due at the jitter offset")
+    {
+        WatchSchedule schedule({1h, 1h}, deviceId, start, 0ms);
+        REQUIRE(schedule.NextDue() == start + offset);
+        REQUIRE(schedule.TakeDue(start + offset - 1ms).empty());
+        REQUIRE(schedule.TakeDue(start + offset) == std::vector<size_t>{0, 1});
+        REQUIRE(schedule.NextDue() == start + offset + 1h);
+    }
+
+    SECTION("Products due within the batch window are taken together")
+    {
+        WatchSchedule schedule({1h, 2h}, deviceId, start, 2h);
+        REQUIRE(schedule.TakeDue(schedule.NextDue()) == std::vector<size_t>{0, 1});
+    }
+
+    SECTION("Products due after the batch window are not taken")
+    {
+        // Find a device whose offsets differ for both intervals
+        std::string device;
+        for (int i = 0; device.empty() || JitterOffset(device, 1h) == JitterOffset(device, 2h); ++i)
+        {
+            device = "device" + std::to_string(i);
+        }
+        const size_t first = JitterOffset(device, 1h) < JitterOffset(device, 2h) ? 0 : 1;
+
+        WatchSchedule schedule({1h, 2h}, device, start, 0ms);
+        REQUIRE(schedule.TakeDue(schedule.NextDue()) == std::vector<size_t>{first});
+        const auto next = schedule.TakeDue(schedule.NextDue());
+        REQUIRE(std::find(next.begin(), next.end(), 1 - first) != next.end());
+    }
+
+    SECTION("Missed polls are skipped and the phase is kept")
+    {
+        WatchSchedule schedule({1h}, deviceId, start, 0ms);
+        REQUIRE(schedule.TakeDue(start + offset + 5h + 1min) == std::vector<size_t>{0});
+        REQUIRE(schedule.NextDue() == start + offset + 6h);
+    }
+
+    SECTION("An empty schedule is never due")
+    {
+        WatchSchedule schedule({}, deviceId, start, 0ms);
+        REQUIRE(schedule.NextDue() == WatchSchedule::Clock::time_point::max());
+        REQUIRE(schedule.TakeDue(start + 1h).empty());
+    }
+}
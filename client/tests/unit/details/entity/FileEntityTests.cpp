@@ -3,6 +3,7 @@
 
 #include "../../../util/SFSExceptionMatcher.h"
 #include "../../../util/TestHelper.h"
+#include "OSInfo.h"
 #include "ReportingHandler.h"
 #include "entity/FileEntity.h"
 #include "sfsclient/AppFile.h"
@@ -16,7 +17,6 @@
 using namespace SFS;
 using namespace SFS::details;
 using namespace SFS::test;
-using json = nlohmann::json;
 
 // GenericFileEntity constants
 const std::string c_fileId = "fileId";
@@ -31,14 +31,14 @@ const std::string c_arch = "amd64";
 const std::string c_applicability = "app";
 ApplicabilityDetailsEntity c_appDetailsEntity{{c_arch}, {c_applicability}};
 
-TEST("Testing FileEntity::FromJson()")
+TEST("Testing FileEntityFromJson()")
 {
     ReportingHandler handler;
     handler.SetLoggingCallback(LogCallbackToTest);
 
     SECTION("Generic File Entity")
     {
-        std::unique_ptr<FileEntity> entity;
+        FileEntity entity;
         SECTION("Correct")
         {
             const json fileEntity = {{"FileId", c_fileId},
@@ -46,15 +46,14 @@ TEST("Testing FileEntity::FromJson()")
                                      {"SizeInBytes", c_size},
                                      {"Hashes", {{"Sha1", c_sha1}, {"Sha256", c_sha256}}}};
 
-            REQUIRE_NOTHROW(entity = FileEntity::FromJson(fileEntity, handler));
-            REQUIRE(entity != nullptr);
-            REQUIRE(entity->GetContentType() == ContentType::Generic);
-            REQUIRE(entity->fileId == c_fileId);
-            REQUIRE(entity->url == c_url);
-            REQUIRE(entity->sizeInBytes == c_size);
-            REQUIRE(entity->hashes.size() == 2);
-            REQUIRE(entity->hashes.at("Sha1") == c_sha1);
-            REQUIRE(entity->hashes.at("Sha256") == c_sha256);
+            REQUIRE_NOTHROW(entity = FileEntityFromJson(fileEntity, handler));
+            REQUIRE(GetContentType(entity) == ContentType::Generic);
+            REQUIRE(GetBase(entity).fileId == c_fileId);
+            REQUIRE(GetBase(entity).url == c_url);
+            REQUIRE(GetBase(entity).sizeInBytes == c_size);
+            REQUIRE(GetBase(entity).hashes.size() == 2);
+            REQUIRE(GetBase(entity).hashes.at("Sha1") == c_sha1);
+            REQUIRE(GetBase(entity).hashes.at("Sha256") == c_sha256);
         }
 
         SECTION("Missing fields")
@@ -64,7 +63,7 @@ TEST("Testing FileEntity::FromJson()")
                 const json fileEntity = {{"Url", c_url},
                                          {"SizeInBytes", c_size},
                                          {"Hashes", {{"Sha1", c_sha1}, {"Sha256", c_sha256}}}};
-                REQUIRE_THROWS_CODE_MSG(FileEntity::FromJson(fileEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(FileEntityFromJson(fileEntity, handler),
                                         ServiceInvalidResponse,
                                         "Missing File.FileId in response");
             }
@@ -74,7 +73,7 @@ TEST("Testing FileEntity::FromJson()")
                 const json fileEntity = {{"FileId", c_fileId},
                                          {"SizeInBytes", c_size},
                                          {"Hashes", {{"Sha1", c_sha1}, {"Sha256", c_sha256}}}};
-                REQUIRE_THROWS_CODE_MSG(FileEntity::FromJson(fileEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(FileEntityFromJson(fileEntity, handler),
                                         ServiceInvalidResponse,
                                         "Missing File.Url in response");
             }
@@ -84,7 +83,7 @@ TEST("Testing FileEntity::FromJson()")
                 const json fileEntity = {{"FileId", c_fileId},
                                          {"Url", c_url},
                                          {"Hashes", {{"Sha1", c_sha1}, {"Sha256", c_sha256}}}};
-                REQUIRE_THROWS_CODE_MSG(FileEntity::FromJson(fileEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(FileEntityFromJson(fileEntity, handler),
                                         ServiceInvalidResponse,
                                         "Missing File.SizeInBytes in response");
             }
@@ -92,7 +91,7 @@ TEST("Testing FileEntity::FromJson()")
             SECTION("Missing Hashes")
             {
                 const json fileEntity = {{"FileId", c_fileId}, {"Url", c_url}, {"SizeInBytes", c_size}};
-                REQUIRE_THROWS_CODE_MSG(FileEntity::FromJson(fileEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(FileEntityFromJson(fileEntity, handler),
                                         ServiceInvalidResponse,
                                         "Missing File.Hashes in response");
             }
@@ -106,7 +105,7 @@ TEST("Testing FileEntity::FromJson()")
                                          {"Url", c_url},
                                          {"SizeInBytes", c_size},
                                          {"Hashes", {{"Sha1", c_sha1}, {"Sha256", c_sha256}}}};
-                REQUIRE_THROWS_CODE_MSG(FileEntity::FromJson(fileEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(FileEntityFromJson(fileEntity, handler),
                                         ServiceInvalidResponse,
                                         "File.FileId is not a string");
             }
@@ -117,7 +116,7 @@ TEST("Testing FileEntity::FromJson()")
                                          {"Url", 1},
                                          {"SizeInBytes", c_size},
                                          {"Hashes", {{"Sha1", c_sha1}, {"Sha256", c_sha256}}}};
-                REQUIRE_THROWS_CODE_MSG(FileEntity::FromJson(fileEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(FileEntityFromJson(fileEntity, handler),
                                         ServiceInvalidResponse,
                                         "File.Url is not a string");
             }
@@ -128,7 +127,7 @@ TEST("Testing FileEntity::FromJson()")
                                          {"Url", c_url},
                                          {"SizeInBytes", "size"},
                                          {"Hashes", {{"Sha1", c_sha1}, {"Sha256", c_sha256}}}};
-                REQUIRE_THROWS_CODE_MSG(FileEntity::FromJson(fileEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(FileEntityFromJson(fileEntity, handler),
                                         ServiceInvalidResponse,
                                         "File.SizeInBytes is not an unsigned number");
             }
@@ -136,7 +135,7 @@ TEST("Testing FileEntity::FromJson()")
             SECTION("Hashes not an object")
             {
                 const json fileEntity = {{"FileId", c_fileId}, {"Url", c_url}, {"SizeInBytes", c_size}, {"Hashes", 1}};
-                REQUIRE_THROWS_CODE_MSG(FileEntity::FromJson(fileEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(FileEntityFromJson(fileEntity, handler),
                                         ServiceInvalidResponse,
                                         "File.Hashes is not an object");
             }
@@ -147,7 +146,7 @@ TEST("Testing FileEntity::FromJson()")
                                          {"Url", c_url},
                                          {"SizeInBytes", c_size},
                                          {"Hashes", {{"Sha1", 1}}}};
-                REQUIRE_THROWS_CODE_MSG(FileEntity::FromJson(fileEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(FileEntityFromJson(fileEntity, handler),
                                         ServiceInvalidResponse,
                                         "File.Hashes object value is not a string");
             }
@@ -156,7 +155,7 @@ TEST("Testing FileEntity::FromJson()")
 
     SECTION("App File Entity")
     {
-        std::unique_ptr<FileEntity> entity;
+        FileEntity entity;
         const json applicabilityDetails = {{"Architectures", json::array({c_arch})},
                                            {"PlatformApplicabilityForPackage", json::array({c_applicability})}};
 
@@ -169,22 +168,21 @@ TEST("Testing FileEntity::FromJson()")
                                      {"FileMoniker", c_fileMoniker},
                                      {"ApplicabilityDetails", applicabilityDetails}};
 
-            REQUIRE_NOTHROW(entity = FileEntity::FromJson(fileEntity, handler));
-            REQUIRE(entity != nullptr);
-            REQUIRE(entity->GetContentType() == ContentType::App);
-            REQUIRE(entity->fileId == c_fileId);
-            REQUIRE(entity->url == c_url);
-            REQUIRE(entity->sizeInBytes == c_size);
-            REQUIRE(entity->hashes.size() == 2);
-            REQUIRE(entity->hashes.at("Sha1") == c_sha1);
-            REQUIRE(entity->hashes.at("Sha256") == c_sha256);
-
-            AppFileEntity* appEntity = dynamic_cast<AppFileEntity*>(entity.get());
-            REQUIRE(appEntity->fileMoniker == c_fileMoniker);
-            REQUIRE(appEntity->applicabilityDetails.architectures.size() == 1);
-            REQUIRE(appEntity->applicabilityDetails.architectures[0] == c_arch);
-            REQUIRE(appEntity->applicabilityDetails.platformApplicabilityForPackage.size() == 1);
-            REQUIRE(appEntity->applicabilityDetails.platformApplicabilityForPackage[0] == c_applicability);
+            REQUIRE_NOTHROW(entity = FileEntityFromJson(fileEntity, handler));
+            REQUIRE(GetContentType(entity) == ContentType::App);
+            REQUIRE(GetBase(entity).fileId == c_fileId);
+            REQUIRE(GetBase(entity).url == c_url);
+            REQUIRE(GetBase(entity).sizeInBytes == c_size);
+            REQUIRE(GetBase(entity).hashes.size() == 2);
+            REQUIRE(GetBase(entity).hashes.at("Sha1") == c_sha1);
+            REQUIRE(GetBase(entity).hashes.at("Sha256") == c_sha256);
+
+            const auto& appEntity = std::get<AppFileEntity>(entity);
+            REQUIRE(appEntity.fileMoniker == c_fileMoniker);
+            REQUIRE(appEntity.applicabilityDetails.architectures.size() == 1);
+            REQUIRE(appEntity.applicabilityDetails.architectures[0] == c_arch);
+            REQUIRE(appEntity.applicabilityDetails.platformApplicabilityForPackage.size() == 1);
+            REQUIRE(appEntity.applicabilityDetails.platformApplicabilityForPackage[0] == c_applicability);
         }
 
         SECTION("Missing fields")
@@ -196,7 +194,7 @@ TEST("Testing FileEntity::FromJson()")
                                          {"SizeInBytes", c_size},
                                          {"Hashes", {{"Sha1", c_sha1}, {"Sha256", c_sha256}}},
                                          {"FileMoniker", c_fileMoniker}};
-                REQUIRE_THROWS_CODE_MSG(FileEntity::FromJson(fileEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(FileEntityFromJson(fileEntity, handler),
                                         ServiceInvalidResponse,
                                         "Missing File.ApplicabilityDetails in response");
             }
@@ -211,7 +209,7 @@ TEST("Testing FileEntity::FromJson()")
                                          {"Hashes", {{"Sha1", c_sha1}, {"Sha256", c_sha256}}},
                                          {"FileMoniker", c_fileMoniker},
                                          {"ApplicabilityDetails", wrongApplicabilityDetails}};
-                REQUIRE_THROWS_CODE_MSG(FileEntity::FromJson(fileEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(FileEntityFromJson(fileEntity, handler),
                                         ServiceInvalidResponse,
                                         "Missing File.ApplicabilityDetails.Architectures in response");
             }
@@ -226,7 +224,7 @@ TEST("Testing FileEntity::FromJson()")
                                          {"FileMoniker", c_fileMoniker},
                                          {"ApplicabilityDetails", wrongApplicabilityDetails}};
                 REQUIRE_THROWS_CODE_MSG(
-                    FileEntity::FromJson(fileEntity, handler),
+                    FileEntityFromJson(fileEntity, handler),
                     ServiceInvalidResponse,
                     "Missing File.ApplicabilityDetails.PlatformApplicabilityForPackage in response");
             }
@@ -242,7 +240,7 @@ TEST("Testing FileEntity::FromJson()")
                                          {"Hashes", {{"Sha1", c_sha1}, {"Sha256", c_sha256}}},
                                          {"FileMoniker", 1},
                                          {"ApplicabilityDetails", applicabilityDetails}};
-                REQUIRE_THROWS_CODE_MSG(FileEntity::FromJson(fileEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(FileEntityFromJson(fileEntity, handler),
                                         ServiceInvalidResponse,
                                         "File.FileMoniker is not a string");
             }
@@ -257,7 +255,7 @@ TEST("Testing FileEntity::FromJson()")
                                              {"Hashes", {{"Sha1", c_sha1}, {"Sha256", c_sha256}}},
                                              {"FileMoniker", c_fileMoniker},
                                              {"ApplicabilityDetails", c_fileId}};
-                    REQUIRE_THROWS_CODE_MSG(FileEntity::FromJson(fileEntity, handler),
+                    REQUIRE_THROWS_CODE_MSG(FileEntityFromJson(fileEntity, handler),
                                             ServiceInvalidResponse,
                                             "File.ApplicabilityDetails is not an object");
                 }
@@ -273,7 +271,7 @@ TEST("Testing FileEntity::FromJson()")
                                              {"Hashes", {{"Sha1", c_sha1}, {"Sha256", c_sha256}}},
                                              {"FileMoniker", c_fileMoniker},
                                              {"ApplicabilityDetails", wrongApplicabilityDetails}};
-                    REQUIRE_THROWS_CODE_MSG(FileEntity::FromJson(fileEntity, handler),
+                    REQUIRE_THROWS_CODE_MSG(FileEntityFromJson(fileEntity, handler),
                                             ServiceInvalidResponse,
                                             "File.ApplicabilityDetails.Architectures is not an array");
                 }
@@ -289,7 +287,7 @@ TEST("Testing FileEntity::FromJson()")
                                              {"Hashes", {{"Sha1", c_sha1}, {"Sha256", c_sha256}}},
                                              {"FileMoniker", c_fileMoniker},
                                              {"ApplicabilityDetails", wrongApplicabilityDetails}};
-                    REQUIRE_THROWS_CODE_MSG(FileEntity::FromJson(fileEntity, handler),
+                    REQUIRE_THROWS_CODE_MSG(FileEntityFromJson(fileEntity, handler),
                                             ServiceInvalidResponse,
                                             "File.ApplicabilityDetails.Architectures array value is not a string");
                 }
@@ -305,7 +303,7 @@ TEST("Testing FileEntity::FromJson()")
                                              {"FileMoniker", c_fileMoniker},
                                              {"ApplicabilityDetails", wrongApplicabilityDetails}};
                     REQUIRE_THROWS_CODE_MSG(
-                        FileEntity::FromJson(fileEntity, handler),
+                        FileEntityFromJson(fileEntity, handler),
                         ServiceInvalidResponse,
                         "File.ApplicabilityDetails.PlatformApplicabilityForPackage is not an array");
                 }
@@ -321,7 +319,7 @@ TEST("Testing FileEntity::FromJson()")
                                              {"FileMoniker", c_fileMoniker},
                                              {"ApplicabilityDetails", wrongApplicabilityDetails}};
                     REQUIRE_THROWS_CODE_MSG(
-                        FileEntity::FromJson(fileEntity, handler),
+                        FileEntityFromJson(fileEntity, handler),
                         ServiceInvalidResponse,
                         "File.ApplicabilityDetails.PlatformApplicabilityForPackage array value is not a string");
                 }
@@ -348,26 +346,26 @@ TEST("Testing GenericFileEntity conversions")
     {
         SECTION("Success")
         {
-            std::unique_ptr<FileEntity> entity = std::make_unique<GenericFileEntity>();
-            entity->fileId = c_fileId;
-            entity->url = c_url;
-            entity->sizeInBytes = c_size;
-            entity->hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
+            GenericFileEntity entity;
+            entity.fileId = c_fileId;
+            entity.url = c_url;
+            entity.sizeInBytes = c_size;
+            entity.hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
 
-            auto file = GenericFileEntity::ToFile(std::move(*entity), handler);
+            auto file = GenericFileEntity::ToFile(std::move(entity), handler);
             CheckFile(*file);
         }
 
         SECTION("Wrong type")
         {
-            std::unique_ptr<FileEntity> wrongEntity = std::make_unique<AppFileEntity>();
-            wrongEntity->fileId = c_fileId;
-            wrongEntity->url = c_url;
-            wrongEntity->sizeInBytes = c_size;
-            wrongEntity->hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
+            AppFileEntity wrongEntity;
+            wrongEntity.fileId = c_fileId;
+            wrongEntity.url = c_url;
+            wrongEntity.sizeInBytes = c_size;
+            wrongEntity.hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
 
             REQUIRE_THROWS_CODE_MSG(
-                GenericFileEntity::ToFile(std::move(*wrongEntity), handler),
+                GenericFileEntity::ToFile(std::move(wrongEntity), handler),
                 ServiceUnexpectedContentType,
                 R"(The service returned file "fileId" with content type [App] while the expected type was [Generic])");
         }
@@ -377,11 +375,11 @@ TEST("Testing GenericFileEntity conversions")
     {
         SECTION("Success")
         {
-            std::unique_ptr<FileEntity> entity = std::make_unique<GenericFileEntity>();
-            entity->fileId = c_fileId;
-            entity->url = c_url;
-            entity->sizeInBytes = c_size;
-            entity->hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
+            GenericFileEntity entity;
+            entity.fileId = c_fileId;
+            entity.url = c_url;
+            entity.sizeInBytes = c_size;
+            entity.hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
 
             FileEntities entities;
             entities.push_back(std::move(entity));
@@ -396,11 +394,11 @@ TEST("Testing GenericFileEntity conversions")
 
             SECTION("2 files")
             {
-                std::unique_ptr<FileEntity> entity2 = std::make_unique<GenericFileEntity>();
-                entity2->fileId = c_fileId;
-                entity2->url = c_url;
-                entity2->sizeInBytes = c_size;
-                entity2->hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
+                GenericFileEntity entity2;
+                entity2.fileId = c_fileId;
+                entity2.url = c_url;
+                entity2.sizeInBytes = c_size;
+                entity2.hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
 
                 entities.push_back(std::move(entity2));
                 REQUIRE_NOTHROW(files = GenericFileEntity::FileEntitiesToFileVector(std::move(entities), handler));
@@ -412,11 +410,11 @@ TEST("Testing GenericFileEntity conversions")
 
         SECTION("Wrong type, fails")
         {
-            std::unique_ptr<FileEntity> wrongEntity = std::make_unique<AppFileEntity>();
-            wrongEntity->fileId = c_fileId;
-            wrongEntity->url = c_url;
-            wrongEntity->sizeInBytes = c_size;
-            wrongEntity->hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
+            AppFileEntity wrongEntity;
+            wrongEntity.fileId = c_fileId;
+            wrongEntity.url = c_url;
+            wrongEntity.sizeInBytes = c_size;
+            wrongEntity.hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
 
             FileEntities wrongEntities;
             wrongEntities.push_back(std::move(wrongEntity));
@@ -451,29 +449,28 @@ TEST("Testing AppFileEntity conversions")
     {
         SECTION("Success")
         {
-            std::unique_ptr<FileEntity> entity = std::make_unique<AppFileEntity>();
-            auto appEntity = dynamic_cast<AppFileEntity*>(entity.get());
-            appEntity->fileId = c_fileId;
-            appEntity->url = c_url;
-            appEntity->sizeInBytes = c_size;
-            appEntity->hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
-            appEntity->fileMoniker = c_fileMoniker;
-            appEntity->applicabilityDetails = c_appDetailsEntity;
-
-            auto file = AppFileEntity::ToAppFile(std::move(*entity), handler);
+            AppFileEntity appEntity;
+            appEntity.fileId = c_fileId;
+            appEntity.url = c_url;
+            appEntity.sizeInBytes = c_size;
+            appEntity.hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
+            appEntity.fileMoniker = c_fileMoniker;
+            appEntity.applicabilityDetails = c_appDetailsEntity;
+
+            auto file = AppFileEntity::ToAppFile(std::move(appEntity), handler);
             CheckAppFile(*file);
         }
 
         SECTION("Wrong type")
         {
-            std::unique_ptr<FileEntity> wrongEntity = std::make_unique<GenericFileEntity>();
-            wrongEntity->fileId = c_fileId;
-            wrongEntity->url = c_url;
-            wrongEntity->sizeInBytes = c_size;
-            wrongEntity->hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
+            GenericFileEntity wrongEntity;
+            wrongEntity.fileId = c_fileId;
+            wrongEntity.url = c_url;
+            wrongEntity.sizeInBytes = c_size;
+            wrongEntity.hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
 
             REQUIRE_THROWS_CODE_MSG(
-                AppFileEntity::ToAppFile(std::move(*wrongEntity), handler),
+                AppFileEntity::ToAppFile(std::move(wrongEntity), handler),
                 ServiceUnexpectedContentType,
                 R"(The service returned file "fileId" with content type [Generic] while the expected type was [App])");
         }
@@ -483,17 +480,16 @@ TEST("Testing AppFileEntity conversions")
     {
         SECTION("Success")
         {
-            std::unique_ptr<FileEntity> entity = std::make_unique<AppFileEntity>();
-            auto appEntity = dynamic_cast<AppFileEntity*>(entity.get());
-            appEntity->fileId = c_fileId;
-            appEntity->url = c_url;
-            appEntity->sizeInBytes = c_size;
-            appEntity->hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
-            appEntity->fileMoniker = c_fileMoniker;
-            appEntity->applicabilityDetails = c_appDetailsEntity;
+            AppFileEntity appEntity;
+            appEntity.fileId = c_fileId;
+            appEntity.url = c_url;
+            appEntity.sizeInBytes = c_size;
+            appEntity.hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
+            appEntity.fileMoniker = c_fileMoniker;
+            appEntity.applicabilityDetails = c_appDetailsEntity;
 
             FileEntities entities;
-            entities.push_back(std::move(entity));
+            entities.push_back(std::move(appEntity));
 
             std::vector<AppFile> files;
             SECTION("1 file")
@@ -505,16 +501,15 @@ TEST("Testing AppFileEntity conversions")
 
             SECTION("2 files")
             {
-                std::unique_ptr<FileEntity> entity2 = std::make_unique<AppFileEntity>();
-                auto appEntity2 = dynamic_cast<AppFileEntity*>(entity2.get());
-                appEntity2->fileId = c_fileId;
-                appEntity2->url = c_url;
-                appEntity2->sizeInBytes = c_size;
-                appEntity2->hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
-                appEntity2->fileMoniker = c_fileMoniker;
-                appEntity2->applicabilityDetails = c_appDetailsEntity;
-
-                entities.push_back(std::move(entity2));
+                AppFileEntity appEntity2;
+                appEntity2.fileId = c_fileId;
+                appEntity2.url = c_url;
+                appEntity2.sizeInBytes = c_size;
+                appEntity2.hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
+                appEntity2.fileMoniker = c_fileMoniker;
+                appEntity2.applicabilityDetails = c_appDetailsEntity;
+
+                entities.push_back(std::move(appEntity2));
                 REQUIRE_NOTHROW(files = AppFileEntity::FileEntitiesToAppFileVector(std::move(entities), handler));
                 REQUIRE(files.size() == 2);
                 CheckAppFile(files[0]);
@@ -524,11 +519,11 @@ TEST("Testing AppFileEntity conversions")
 
         SECTION("Wrong type, fails")
         {
-            std::unique_ptr<FileEntity> wrongEntity = std::make_unique<GenericFileEntity>();
-            wrongEntity->fileId = c_fileId;
-            wrongEntity->url = c_url;
-            wrongEntity->sizeInBytes = c_size;
-            wrongEntity->hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
+            GenericFileEntity wrongEntity;
+            wrongEntity.fileId = c_fileId;
+            wrongEntity.url = c_url;
+            wrongEntity.sizeInBytes = c_size;
+            wrongEntity.hashes = {{"Sha1", c_sha1}, {"Sha256", c_sha256}};
 
             FileEntities wrongEntities;
             wrongEntities.push_back(std::move(wrongEntity));
@@ -540,15 +535,16 @@ TEST("Testing AppFileEntity conversions")
     }
 }
 
-TEST("Testing FileEntity::DownloadInfoResponseToFileEntities()")
+TEST("Testing DownloadInfoResponseToFileEntities()")
 {
     ReportingHandler handler;
     handler.SetLoggingCallback(LogCallbackToTest);
 
     SECTION("GenericFileEntity")
     {
-        auto CheckEntity = [&](const FileEntity& entity) {
-            REQUIRE(entity.GetContentType() == ContentType::Generic);
+        auto CheckEntity = [&](const FileEntity& file) {
+            REQUIRE(GetContentType(file) == ContentType::Generic);
+            const auto& entity = std::get<GenericFileEntity>(file);
             REQUIRE(entity.fileId == c_fileId);
             REQUIRE(entity.url == c_url);
             REQUIRE(entity.sizeInBytes == c_size);
@@ -567,21 +563,18 @@ TEST("Testing FileEntity::DownloadInfoResponseToFileEntities()")
             SECTION("1 file")
             {
                 const json downloadInfoResponse = json::array({fileJson});
-                auto entities = FileEntity::DownloadInfoResponseToFileEntities(downloadInfoResponse, handler);
+                auto entities = DownloadInfoResponseToFileEntities(downloadInfoResponse, handler);
                 REQUIRE(entities.size() == 1);
-                REQUIRE(entities[0] != nullptr);
-                CheckEntity(*entities[0]);
+                CheckEntity(entities[0]);
             }
 
             SECTION("2 files")
             {
                 const json downloadInfoResponse = json::array({fileJson, fileJson});
-                auto entities = FileEntity::DownloadInfoResponseToFileEntities(downloadInfoResponse, handler);
+                auto entities = DownloadInfoResponseToFileEntities(downloadInfoResponse, handler);
                 REQUIRE(entities.size() == 2);
-                REQUIRE(entities[0] != nullptr);
-                CheckEntity(*entities[0]);
-                REQUIRE(entities[1] != nullptr);
-                CheckEntity(*entities[1]);
+                CheckEntity(entities[0]);
+                CheckEntity(entities[1]);
             }
         }
     }
@@ -591,8 +584,9 @@ TEST("Testing FileEntity::DownloadInfoResponseToFileEntities()")
         const json applicabilityDetails = {{"Architectures", json::array({c_arch})},
                                            {"PlatformApplicabilityForPackage", json::array({c_applicability})}};
 
-        auto CheckEntity = [&](const AppFileEntity& entity) {
-            REQUIRE(entity.GetContentType() == ContentType::App);
+        auto CheckEntity = [&](const FileEntity& file) {
+            REQUIRE(GetContentType(file) == ContentType::App);
+            const auto& entity = std::get<AppFileEntity>(file);
             REQUIRE(entity.fileId == c_fileId);
             REQUIRE(entity.url == c_url);
             REQUIRE(entity.sizeInBytes == c_size);
@@ -618,22 +612,322 @@ TEST("Testing FileEntity::DownloadInfoResponseToFileEntities()")
             SECTION("1 file")
             {
                 const json downloadInfoResponse = json::array({fileJson});
-                auto entities = FileEntity::DownloadInfoResponseToFileEntities(downloadInfoResponse, handler);
+                auto entities = DownloadInfoResponseToFileEntities(downloadInfoResponse, handler);
                 REQUIRE(entities.size() == 1);
-                REQUIRE(entities[0] != nullptr);
-                CheckEntity(dynamic_cast<AppFileEntity&>(*entities[0]));
+                CheckEntity(entities[0]);
             }
 
             SECTION("2 files")
             {
                 const json downloadInfoResponse = json::array({fileJson, fileJson});
-                auto entities = FileEntity::DownloadInfoResponseToFileEntities(downloadInfoResponse, handler);
+                auto entities = DownloadInfoResponseToFileEntities(downloadInfoResponse, handler);
                 REQUIRE(entities.size() == 2);
-                REQUIRE(entities[0] != nullptr);
-                CheckEntity(dynamic_cast<AppFileEntity&>(*entities[0]));
-                REQUIRE(entities[1] != nullptr);
-                CheckEntity(dynamic_cast<AppFileEntity&>(*entities[1]));
+                CheckEntity(entities[0]);
+                CheckEntity(entities[1]);
             }
         }
     }
 }
+
+TEST("Testing FileFromJson() and AppFileFromJson()")
+{
+    ReportingHandler handler;
+    handler.SetLoggingCallback(LogCallbackToTest);
+
+    const json genericFile = {{"FileId", c_fileId},
+                              {"Url", c_url},
+                              {"SizeInBytes", c_size},
+                              {"Hashes", {{"Sha1", c_sha1}, {"Sha256", c_sha256}}}};
+    json appFile = genericFile;
+    appFile["FileMoniker"] = c_fileMoniker;
+    appFile["ApplicabilityDetails"] = {{"Architectures", {c_arch}},
+                                       {"PlatformApplicabilityForPackage", {c_applicability}}};
+
+    SECTION("FileFromJson()")
+    {
+        SECTION("Success")
+        {
+            auto file = FileFromJson(json(genericFile), handler);
+            REQUIRE(file->GetFileId() == c_fileId);
+            REQUIRE(file->GetUrl() == c_url);
+            REQUIRE(file->GetSizeInBytes() == c_size);
+            REQUIRE(file->GetHashes().size() == 2);
+            REQUIRE(file->GetHashes().at(HashType::Sha1) == c_sha1);
+            REQUIRE(file->GetHashes().at(HashType::Sha256) == c_sha256);
+        }
+
+        SECTION("Wrong type")
+        {
+            REQUIRE_THROWS_CODE_MSG(
+                FileFromJson(json(appFile), handler),
+                ServiceUnexpectedContentType,
+                R"(The service returned file "fileId" with content type [App] while the expected type was [Generic])");
+        }
+
+        SECTION("Same validation as FileEntityFromJson()")
+        {
+            json file = genericFile;
+            file.erase("Url");
+            REQUIRE_THROWS_CODE_MSG(FileFromJson(std::move(file), handler),
+                                    ServiceInvalidResponse,
+                                    "Missing File.Url in response");
+
+            file = genericFile;
+            file["Hashes"]["Sha1"] = 1;
+            REQUIRE_THROWS_CODE_MSG(FileFromJson(std::move(file), handler),
+                                    ServiceInvalidResponse,
+                                    "File.Hashes object value is not a string");
+
+            file = genericFile;
+            file["Hashes"]["Md5"] = "md5";
+            REQUIRE_THROWS_CODE_MSG(FileFromJson(std::move(file), handler), Unexpected, "Unknown hash type: Md5");
+        }
+    }
+
+    SECTION("AppFileFromJson()")
+    {
+        SECTION("Success")
+        {
+            auto file = AppFileFromJson(json(appFile), handler);
+            REQUIRE(file->GetFileId() == c_fileId);
+            REQUIRE(file->GetUrl() == c_url);
+            REQUIRE(file->GetSizeInBytes() == c_size);
+            REQUIRE(file->GetHashes().size() == 2);
+            REQUIRE(file->GetHashes().at(HashType::Sha1) == c_sha1);
+            REQUIRE(file->GetHashes().at(HashType::Sha256) == c_sha256);
+            REQUIRE(file->GetFileMoniker() == c_fileMoniker);
+            REQUIRE(file->GetApplicabilityDetails().GetArchitectures() ==
+                    std::vector<Architecture>{Architecture::Amd64});
+            REQUIRE(file->GetApplicabilityDetails().GetPlatformApplicabilityForPackage() ==
+                    std::vector<std::string>{c_applicability});
+        }
+
+        SECTION("Wrong type")
+        {
+            REQUIRE_THROWS_CODE_MSG(
+                AppFileFromJson(json(genericFile), handler),
+                ServiceUnexpectedContentType,
+                R"(The service returned file "fileId" with content type [Generic] while the expected type was [App])");
+        }
+
+        SECTION("Same validation as FileEntityFromJson()")
+        {
+            json file = appFile;
+            file["ApplicabilityDetails"].erase("Architectures");
+            REQUIRE_THROWS_CODE_MSG(AppFileFromJson(std::move(file), handler),
+                                    ServiceInvalidResponse,
+                                    "Missing File.ApplicabilityDetails.Architectures in response");
+
+            file = appFile;
+            file["ApplicabilityDetails"]["Architectures"] = {"sparc"};
+            REQUIRE_THROWS_CODE_MSG(AppFileFromJson(std::move(file), handler),
+                                    Unexpected,
+                                    "Unknown architecture: sparc");
+        }
+    }
+}
+
+TEST("Testing AppFileFilter")
+{
+    ReportingHandler handler;
+    handler.SetLoggingCallback(LogCallbackToTest);
+
+    auto makeFilter = [](std::vector<Architecture> architectures, std::vector<std::string> platforms) {
+        auto filter = AppFileFilter::Make(ApplicabilityFilter{std::move(architectures), std::move(platforms)});
+        REQUIRE(filter.has_value());
+        return *filter;
+    };
+
+    using Strings = std::vector<std::string>;
+
+    SECTION("No filter")
+    {
+        REQUIRE_FALSE(AppFileFilter::Make(std::nullopt).has_value());
+    }
+
+    SECTION("Defaults to the architecture of this machine")
+    {
+        auto filter = AppFileFilter::Make(ApplicabilityFilter{});
+        if (osinfo::GetOSArchitecture() == Architecture::None)
+        {
+            REQUIRE_FALSE(filter.has_value());
+        }
+        else
+        {
+            REQUIRE(filter.has_value());
+            REQUIRE(filter->Matches(Strings{"None"}, Strings{}, handler));
+        }
+    }
+
+    SECTION("Architectures")
+    {
+        const auto filter = makeFilter({Architecture::Amd64, Architecture::x86}, {});
+        REQUIRE(filter.Matches(Strings{"amd64"}, Strings{"app"}, handler));
+        REQUIRE(filter.Matches(Strings{"arm64", "x86"}, Strings{"app"}, handler));
+        REQUIRE_FALSE(filter.Matches(Strings{"arm64"}, Strings{"app"}, handler));
+        REQUIRE_FALSE(filter.Matches(Strings{"Arm"}, Strings{}, handler));
+
+        // Architecture-neutral files are kept
+        REQUIRE(filter.Matches(Strings{"None"}, Strings{"app"}, handler));
+        REQUIRE(filter.Matches(Strings{}, Strings{"app"}, handler));
+
+        REQUIRE_THROWS_CODE_MSG(filter.Matches(Strings{"sparc"}, Strings{}, handler),
+                                Unexpected,
+                                "Unknown architecture: sparc");
+    }
+
+    SECTION("Platforms")
+    {
+        const auto filter = makeFilter({Architecture::Amd64}, {"Windows.Desktop", "Windows.Universal"});
+        REQUIRE(filter.Matches(Strings{"amd64"}, Strings{"windows.desktop"}, handler));
+        REQUIRE(filter.Matches(Strings{"amd64"}, Strings{"Windows.Xbox", "Windows.Universal"}, handler));
+        REQUIRE_FALSE(filter.Matches(Strings{"amd64"}, Strings{"Windows.Xbox"}, handler));
+        REQUIRE_FALSE(filter.Matches(Strings{"amd64"}, Strings{}, handler));
+        REQUIRE_FALSE(filter.Matches(Strings{"arm64"}, Strings{"Windows.Desktop"}, handler));
+    }
+
+    SECTION("AppFileFromJson() drops files that don't match")
+    {
+        json appFile = {{"FileId", c_fileId},
+                        {"Url", c_url},
+                        {"SizeInBytes", c_size},
+                        {"Hashes", {{"Sha1", c_sha1}}},
+                        {"FileMoniker", c_fileMoniker},
+                        {"ApplicabilityDetails",
+                         {{"Architectures", {c_arch}}, {"PlatformApplicabilityForPackage", {c_applicability}}}}};
+
+        REQUIRE(AppFileFromJson(json(appFile), makeFilter({Architecture::Amd64}, {}), handler) != nullptr);
+        REQUIRE(AppFileFromJson(json(appFile), makeFilter({Architecture::Arm64}, {}), handler) == nullptr);
+        REQUIRE(AppFileFromJson(json(appFile), makeFilter({}, {"other"}), handler) == nullptr);
+
+        // Validation still happens before filtering
+        appFile.erase("Url");
+        REQUIRE_THROWS_CODE_MSG(AppFileFromJson(std::move(appFile), makeFilter({Architecture::Arm64}, {}), handler),
+                                ServiceInvalidResponse,
+                                "Missing File.Url in response");
+    }
+
+    SECTION("FileEntitiesToAppFileVector() drops entities that don't match")
+    {
+        FileEntities entities;
+        for (const auto& arch : {"amd64", "arm64", "None"})
+        {
+            auto& entity = entities.emplace_back().emplace<AppFileEntity>();
+            entity.fileId = arch;
+            entity.hashes = {{"Sha1", c_sha1}};
+            entity.applicabilityDetails.architectures = {arch};
+            entity.applicabilityDetails.platformApplicabilityForPackage = {c_applicability};
+        }
+
+        const auto filter = makeFilter({Architecture::Arm64}, {});
+        auto files = AppFileEntity::FileEntitiesToAppFileVector(std::move(entities), filter, handler);
+        REQUIRE(files.size() == 2);
+        REQUIRE(files[0].GetFileId() == "arm64");
+        REQUIRE(files[1].GetFileId() == "None");
+    }
+}
+
+#ifdef SFS_JSON_BACKEND_SIMDJSON
+TEST("Testing DownloadInfoResponseToFileEntities() with simdjson")
+{
+    ReportingHandler handler;
+    handler.SetLoggingCallback(LogCallbackToTest);
+
+    const json genericFile = {{"FileId", c_fileId},
+                              {"Url", c_url},
+                              {"SizeInBytes", c_size},
+                              {"Hashes", {{"Sha1", c_sha1}, {"Sha256", c_sha256}}}};
+    json appFile = genericFile;
+    appFile["FileMoniker"] = c_fileMoniker;
+    appFile["ApplicabilityDetails"] = {{"Architectures", {c_arch}},
+                                       {"PlatformApplicabilityForPackage", {c_applicability}}};
+
+    SECTION("Same entities as nlohmann::json")
+    {
+        const json response = json::array({genericFile, appFile});
+        std::string data = response.dump();
+
+        const auto expected = DownloadInfoResponseToFileEntities(response, handler);
+        const auto entities = DownloadInfoResponseToFileEntities(data, "GetDownloadInfo", handler);
+
+        REQUIRE(entities.size() == expected.size());
+        for (size_t i = 0; i < entities.size(); ++i)
+        {
+            REQUIRE(GetContentType(entities[i]) == GetContentType(expected[i]));
+            REQUIRE(GetBase(entities[i]).fileId == GetBase(expected[i]).fileId);
+            REQUIRE(GetBase(entities[i]).url == GetBase(expected[i]).url);
+            REQUIRE(GetBase(entities[i]).sizeInBytes == GetBase(expected[i]).sizeInBytes);
+            REQUIRE(GetBase(entities[i]).hashes == GetBase(expected[i]).hashes);
+        }
+
+        const auto& appEntity = std::get<AppFileEntity>(entities[1]);
+        REQUIRE(appEntity.fileMoniker == c_fileMoniker);
+        REQUIRE(appEntity.applicabilityDetails.architectures == std::vector<std::string>{c_arch});
+        REQUIRE(appEntity.applicabilityDetails.platformApplicabilityForPackage ==
+                std::vector<std::string>{c_applicability});
+    }
+
+    SECTION("Same errors as nlohmann::json")
+    {
+        auto checkSameError = [&](const json& response) {
+            INFO(response.dump());
+            std::string data = response.dump();
+            try
+            {
+                DownloadInfoResponseToFileEntities(response, handler);
+                FAIL("Expected the nlohmann::json parser to throw");
+            }
+            catch (const SFSException& expected)
+            {
+                REQUIRE_THROWS_MATCHES(
+                    DownloadInfoResponseToFileEntities(data, "GetDownloadInfo", handler),
+                    SFSException,
+                    SFSExceptionMatcher(expected.GetResult().GetCode(), expected.GetResult().GetMsg()));
+            }
+        };
+
+        checkSameError(genericFile);
+        checkSameError(json::array({1}));
+        checkSameError(json::array({json::object()}));
+
+        json file = genericFile;
+        file["Url"] = 1;
+        checkSameError(json::array({file}));
+
+        file = genericFile;
+        file["SizeInBytes"] = -1;
+        checkSameError(json::array({file}));
+
+        file = genericFile;
+        file["SizeInBytes"] = 1.5;
+        checkSameError(json::array({file}));
+
+        file = genericFile;
+        file["Hashes"]["Sha1"] = 1;
+        checkSameError(json::array({file}));
+
+        file = appFile;
+        file.erase("ApplicabilityDetails");
+        checkSameError(json::array({file}));
+
+        file = appFile;
+        file["ApplicabilityDetails"]["Architectures"] = {1};
+        checkSameError(json::array({file}));
+
+        file = appFile;
+        file["ApplicabilityDetails"].erase("PlatformApplicabilityForPackage");
+        checkSameError(json::array({file}));
+    }
+
+    SECTION("Invalid JSON")
+    {
+        std::string data = "[{\"FileId\": ";
+        REQUIRE_THROWS_CODE(DownloadInfoResponseToFileEntities(data, "GetDownloadInfo", handler),
+                            ServiceInvalidResponse);
+
+        data = "[] []";
+        REQUIRE_THROWS_CODE(DownloadInfoResponseToFileEntities(data, "GetDownloadInfo", handler),
+                            ServiceInvalidResponse);
+    }
+}
+#endif
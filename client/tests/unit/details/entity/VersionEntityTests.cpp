@@ -15,7 +15,6 @@
 using namespace SFS;
 using namespace SFS::details;
 using namespace SFS::test;
-using json = nlohmann::json;
 
 // GenericVersionEntity constants
 const std::string c_ns = "namespace";
@@ -25,24 +24,23 @@ const std::string c_version = "version";
 // AppVersionEntity constants
 const std::string c_updateId = "updateId";
 
-TEST("Testing VersionEntity::FromJson()")
+TEST("Testing VersionEntityFromJson()")
 {
     ReportingHandler handler;
     handler.SetLoggingCallback(LogCallbackToTest);
 
     SECTION("Generic Version Entity")
     {
-        std::unique_ptr<VersionEntity> entity;
+        VersionEntity entity;
         SECTION("Correct")
         {
             const json versionEntity = {{"ContentId", {{"Namespace", c_ns}, {"Name", c_name}, {"Version", c_version}}}};
 
-            REQUIRE_NOTHROW(entity = VersionEntity::FromJson(versionEntity, handler));
-            REQUIRE(entity != nullptr);
-            REQUIRE(entity->GetContentType() == ContentType::Generic);
-            REQUIRE(entity->contentId.nameSpace == c_ns);
-            REQUIRE(entity->contentId.name == c_name);
-            REQUIRE(entity->contentId.version == c_version);
+            REQUIRE_NOTHROW(entity = VersionEntityFromJson(versionEntity, handler));
+            REQUIRE(GetContentType(entity) == ContentType::Generic);
+            REQUIRE(GetBase(entity).contentId.nameSpace == c_ns);
+            REQUIRE(GetBase(entity).contentId.name == c_name);
+            REQUIRE(GetBase(entity).contentId.version == c_version);
         }
 
         SECTION("Missing fields")
@@ -50,7 +48,7 @@ TEST("Testing VersionEntity::FromJson()")
             SECTION("Missing ContentId")
             {
                 const json versionEntity = {{"Namespace", c_ns}, {"Name", c_name}, {"Version", c_version}};
-                REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                         ServiceInvalidResponse,
                                         "Missing ContentId in response");
             }
@@ -58,7 +56,7 @@ TEST("Testing VersionEntity::FromJson()")
             SECTION("Missing ContentId.Namespace")
             {
                 const json versionEntity = {{"ContentId", {{"Name", c_name}, {"Version", c_version}}}};
-                REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                         ServiceInvalidResponse,
                                         "Missing ContentId.Namespace in response");
             }
@@ -66,7 +64,7 @@ TEST("Testing VersionEntity::FromJson()")
             SECTION("Missing ContentId.Name")
             {
                 const json versionEntity = {{"ContentId", {{"Namespace", c_ns}, {"Version", c_version}}}};
-                REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                         ServiceInvalidResponse,
                                         "Missing ContentId.Name in response");
             }
@@ -74,7 +72,7 @@ TEST("Testing VersionEntity::FromJson()")
             SECTION("Missing ContentId.Version")
             {
                 const json versionEntity = {{"ContentId", {{"Namespace", c_ns}, {"Name", c_name}}}};
-                REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                         ServiceInvalidResponse,
                                         "Missing ContentId.Version in response");
             }
@@ -85,7 +83,7 @@ TEST("Testing VersionEntity::FromJson()")
             SECTION("ContentId not an object")
             {
                 const json versionEntity = json::array({{"Namespace", 1}, {"Name", c_name}, {"Version", c_version}});
-                REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                         ServiceInvalidResponse,
                                         "Response is not a JSON object");
             }
@@ -94,7 +92,7 @@ TEST("Testing VersionEntity::FromJson()")
             {
                 const json versionEntity = {
                     {"ContentId", {{"Namespace", 1}, {"Name", c_name}, {"Version", c_version}}}};
-                REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                         ServiceInvalidResponse,
                                         "ContentId.Namespace is not a string");
             }
@@ -102,7 +100,7 @@ TEST("Testing VersionEntity::FromJson()")
             SECTION("ContentId.Name")
             {
                 const json versionEntity = {{"ContentId", {{"Namespace", c_ns}, {"Name", 1}, {"Version", c_version}}}};
-                REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                         ServiceInvalidResponse,
                                         "ContentId.Name is not a string");
             }
@@ -110,7 +108,7 @@ TEST("Testing VersionEntity::FromJson()")
             SECTION("ContentId.Version")
             {
                 const json versionEntity = {{"ContentId", {{"Namespace", c_ns}, {"Name", c_name}, {"Version", 1}}}};
-                REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                         ServiceInvalidResponse,
                                         "ContentId.Version is not a string");
             }
@@ -119,7 +117,7 @@ TEST("Testing VersionEntity::FromJson()")
 
     SECTION("App Version Entity")
     {
-        std::unique_ptr<VersionEntity> entity;
+        VersionEntity entity;
         const json contentId = {{"Namespace", c_ns}, {"Name", c_name}, {"Version", c_version}};
 
         SECTION("Correct")
@@ -128,19 +126,18 @@ TEST("Testing VersionEntity::FromJson()")
                                         {"UpdateId", c_updateId},
                                         {"Prerequisites", json::array({contentId})}};
 
-            REQUIRE_NOTHROW(entity = VersionEntity::FromJson(versionEntity, handler));
-            REQUIRE(entity != nullptr);
-            REQUIRE(entity->GetContentType() == ContentType::App);
-            REQUIRE(entity->contentId.nameSpace == c_ns);
-            REQUIRE(entity->contentId.name == c_name);
-            REQUIRE(entity->contentId.version == c_version);
-
-            AppVersionEntity* appEntity = dynamic_cast<AppVersionEntity*>(entity.get());
-            REQUIRE(appEntity->updateId == c_updateId);
-            REQUIRE(appEntity->prerequisites.size() == 1);
-            REQUIRE(appEntity->prerequisites[0].contentId.nameSpace == c_ns);
-            REQUIRE(appEntity->prerequisites[0].contentId.name == c_name);
-            REQUIRE(appEntity->prerequisites[0].contentId.version == c_version);
+            REQUIRE_NOTHROW(entity = VersionEntityFromJson(versionEntity, handler));
+            REQUIRE(GetContentType(entity) == ContentType::App);
+            REQUIRE(GetBase(entity).contentId.nameSpace == c_ns);
+            REQUIRE(GetBase(entity).contentId.name == c_name);
+            REQUIRE(GetBase(entity).contentId.version == c_version);
+
+            const auto& appEntity = std::get<AppVersionEntity>(entity);
+            REQUIRE(appEntity.updateId == c_updateId);
+            REQUIRE(appEntity.prerequisites.size() == 1);
+            REQUIRE(appEntity.prerequisites[0].contentId.nameSpace == c_ns);
+            REQUIRE(appEntity.prerequisites[0].contentId.name == c_name);
+            REQUIRE(appEntity.prerequisites[0].contentId.version == c_version);
         }
 
         SECTION("Missing fields")
@@ -148,7 +145,7 @@ TEST("Testing VersionEntity::FromJson()")
             SECTION("Missing Prerequisites")
             {
                 const json versionEntity = {{"ContentId", contentId}, {"UpdateId", c_updateId}};
-                REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                         ServiceInvalidResponse,
                                         "Missing Prerequisites in response");
             }
@@ -159,7 +156,7 @@ TEST("Testing VersionEntity::FromJson()")
                 const json versionEntity = {{"ContentId", contentId},
                                             {"UpdateId", c_updateId},
                                             {"Prerequisites", json::array({wrongPrerequisite})}};
-                REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                         ServiceInvalidResponse,
                                         "Missing Prerequisite.Namespace in response");
             }
@@ -170,7 +167,7 @@ TEST("Testing VersionEntity::FromJson()")
                 const json versionEntity = {{"ContentId", contentId},
                                             {"UpdateId", c_updateId},
                                             {"Prerequisites", json::array({wrongPrerequisite})}};
-                REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                         ServiceInvalidResponse,
                                         "Missing Prerequisite.Name in response");
             }
@@ -181,7 +178,7 @@ TEST("Testing VersionEntity::FromJson()")
                 const json versionEntity = {{"ContentId", contentId},
                                             {"UpdateId", c_updateId},
                                             {"Prerequisites", json::array({wrongPrerequisite})}};
-                REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                         ServiceInvalidResponse,
                                         "Missing Prerequisite.Version in response");
             }
@@ -194,7 +191,7 @@ TEST("Testing VersionEntity::FromJson()")
                 const json versionEntity = {{"ContentId", contentId},
                                             {"UpdateId", 1},
                                             {"Prerequisites", json::array({contentId})}};
-                REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                         ServiceInvalidResponse,
                                         "UpdateId is not a string");
             }
@@ -206,7 +203,7 @@ TEST("Testing VersionEntity::FromJson()")
                     const json versionEntity = {{"ContentId", contentId},
                                                 {"UpdateId", c_updateId},
                                                 {"Prerequisites", contentId}};
-                    REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                    REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                             ServiceInvalidResponse,
                                             "Prerequisites is not an array");
                 }
@@ -216,7 +213,7 @@ TEST("Testing VersionEntity::FromJson()")
                     const json versionEntity = {{"ContentId", contentId},
                                                 {"UpdateId", c_updateId},
                                                 {"Prerequisites", json::array({1})}};
-                    REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                    REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                             ServiceInvalidResponse,
                                             "Prerequisite element is not a JSON object");
                 }
@@ -227,7 +224,7 @@ TEST("Testing VersionEntity::FromJson()")
                     const json versionEntity = {{"ContentId", contentId},
                                                 {"UpdateId", c_updateId},
                                                 {"Prerequisites", json::array({wrongPrerequisite})}};
-                    REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                    REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                             ServiceInvalidResponse,
                                             "Prerequisite.Namespace is not a string");
                 }
@@ -238,7 +235,7 @@ TEST("Testing VersionEntity::FromJson()")
                     const json versionEntity = {{"ContentId", contentId},
                                                 {"UpdateId", c_updateId},
                                                 {"Prerequisites", json::array({wrongPrerequisite})}};
-                    REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                    REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                             ServiceInvalidResponse,
                                             "Prerequisite.Name is not a string");
                 }
@@ -249,7 +246,7 @@ TEST("Testing VersionEntity::FromJson()")
                     const json versionEntity = {{"ContentId", contentId},
                                                 {"UpdateId", c_updateId},
                                                 {"Prerequisites", json::array({wrongPrerequisite})}};
-                    REQUIRE_THROWS_CODE_MSG(VersionEntity::FromJson(versionEntity, handler),
+                    REQUIRE_THROWS_CODE_MSG(VersionEntityFromJson(versionEntity, handler),
                                             ServiceInvalidResponse,
                                             "Prerequisite.Version is not a string");
                 }
@@ -269,37 +266,145 @@ TEST("Testing VersionEntity conversions")
         REQUIRE(contentId.GetVersion() == c_version);
     };
 
-    SECTION("VersionEntity::ToContentId()")
+    SECTION("ToContentId()")
     {
         SECTION("Success with GenericVersionEntity")
         {
-            std::unique_ptr<VersionEntity> entity = std::make_unique<GenericVersionEntity>();
-            entity->contentId.nameSpace = c_ns;
-            entity->contentId.name = c_name;
-            entity->contentId.version = c_version;
+            GenericVersionEntity entity;
+            entity.contentId.nameSpace = c_ns;
+            entity.contentId.name = c_name;
+            entity.contentId.version = c_version;
 
-            auto contentId = VersionEntity::ToContentId(std::move(*entity), handler);
+            auto contentId = ToContentId(std::move(entity), handler);
             CheckContentId(*contentId);
         }
 
         SECTION("Success with AppVersionEntity")
         {
-            std::unique_ptr<VersionEntity> entity = std::make_unique<AppVersionEntity>();
-            auto appEntity = AppVersionEntity::GetAppVersionEntityPtr(entity, handler);
-            appEntity->contentId.nameSpace = c_ns;
-            appEntity->contentId.name = c_name;
-            appEntity->contentId.version = c_version;
-            appEntity->updateId = c_updateId;
+            VersionEntity entity{AppVersionEntity{}};
+            auto& appEntity = GetAppVersionEntity(entity, handler);
+            appEntity.contentId.nameSpace = c_ns;
+            appEntity.contentId.name = c_name;
+            appEntity.contentId.version = c_version;
+            appEntity.updateId = c_updateId;
 
-            std::unique_ptr<GenericVersionEntity> prereqEntity = std::make_unique<GenericVersionEntity>();
-            prereqEntity->contentId.nameSpace = c_ns;
-            prereqEntity->contentId.name = c_name;
-            prereqEntity->contentId.version = c_version;
+            GenericVersionEntity prereqEntity;
+            prereqEntity.contentId.nameSpace = c_ns;
+            prereqEntity.contentId.name = c_name;
+            prereqEntity.contentId.version = c_version;
 
-            appEntity->prerequisites.push_back(std::move(*prereqEntity));
+            appEntity.prerequisites.push_back(std::move(prereqEntity));
 
-            auto contentId = VersionEntity::ToContentId(std::move(*entity), handler);
+            auto contentId = ToContentId(std::move(GetBase(entity)), handler);
             CheckContentId(*contentId);
         }
     }
+
+    SECTION("GetAppVersionEntity()")
+    {
+        VersionEntity entity{GenericVersionEntity{}};
+        GetBase(entity).contentId.name = c_name;
+
+        REQUIRE_THROWS_CODE_MSG(
+            GetAppVersionEntity(entity, handler),
+            ServiceUnexpectedContentType,
+            R"(The service returned entity "name" with content type [Generic] while the expected type was [App])");
+    }
+}
+
+#ifdef SFS_JSON_BACKEND_SIMDJSON
+TEST("Testing VersionEntity parsing with simdjson")
+{
+    ReportingHandler handler;
+    handler.SetLoggingCallback(LogCallbackToTest);
+
+    const json contentId = {{"Namespace", c_ns}, {"Name", c_name}, {"Version", c_version}};
+    const json genericVersion = {{"ContentId", contentId}};
+    const json appVersion = {{"ContentId", contentId}, {"UpdateId", c_updateId}, {"Prerequisites", {contentId}}};
+
+    SECTION("VersionEntityFromJson()")
+    {
+        std::string data = appVersion.dump();
+        const auto entity = VersionEntityFromJson(data, "GetLatestVersion", handler);
+
+        REQUIRE(GetContentType(entity) == ContentType::App);
+        REQUIRE(GetBase(entity).contentId.nameSpace == c_ns);
+        REQUIRE(GetBase(entity).contentId.name == c_name);
+        REQUIRE(GetBase(entity).contentId.version == c_version);
+
+        const auto& appEntity = std::get<AppVersionEntity>(entity);
+        REQUIRE(appEntity.updateId == c_updateId);
+        REQUIRE(appEntity.prerequisites.size() == 1);
+        REQUIRE(appEntity.prerequisites[0].contentId.name == c_name);
+    }
+
+    SECTION("BatchResponseToVersionEntities()")
+    {
+        std::string data = json::array({genericVersion, appVersion}).dump();
+        const auto entities = BatchResponseToVersionEntities(data, "GetLatestVersionBatch", handler);
+
+        REQUIRE(entities.size() == 2);
+        REQUIRE(GetContentType(entities[0]) == ContentType::Generic);
+        REQUIRE(GetContentType(entities[1]) == ContentType::App);
+
+        data = "[]";
+        REQUIRE_THROWS_CODE_MSG(BatchResponseToVersionEntities(data, "GetLatestVersionBatch", handler),
+                                ServiceInvalidResponse,
+                                "Response does not have the expected size");
+    }
+
+    SECTION("Same errors as nlohmann::json")
+    {
+        auto checkSameError = [&](const json& response) {
+            INFO(response.dump());
+            std::string data = response.dump();
+            try
+            {
+                VersionEntityFromJson(response, handler);
+                FAIL("Expected the nlohmann::json parser to throw");
+            }
+            catch (const SFSException& expected)
+            {
+                REQUIRE_THROWS_MATCHES(
+                    VersionEntityFromJson(data, "GetLatestVersion", handler),
+                    SFSException,
+                    SFSExceptionMatcher(expected.GetResult().GetCode(), expected.GetResult().GetMsg()));
+            }
+        };
+
+        checkSameError(json::array());
+        checkSameError(json::object());
+        checkSameError({{"ContentId", 1}});
+
+        json version = genericVersion;
+        version["ContentId"].erase("Version");
+        checkSameError(version);
+
+        version = genericVersion;
+        version["ContentId"]["Name"] = 1;
+        checkSameError(version);
+
+        version = appVersion;
+        version.erase("Prerequisites");
+        checkSameError(version);
+
+        version = appVersion;
+        version["UpdateId"] = 1;
+        checkSameError(version);
+
+        version = appVersion;
+        version["Prerequisites"] = {1};
+        checkSameError(version);
+
+        version = appVersion;
+        version["Prerequisites"][0].erase("Name");
+        checkSameError(version);
+    }
+
+    SECTION("Invalid JSON")
+    {
+        std::string data = "{\"ContentId\": ";
+        REQUIRE_THROWS_CODE(VersionEntityFromJson(data, "GetLatestVersion", handler), ServiceInvalidResponse);
+    }
 }
+#endif
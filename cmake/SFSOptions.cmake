@@ -9,6 +9,16 @@ option(
     "Set SFS_ENABLE_OVERRIDES to ON to enable certain test overrides through environment variables."
     OFF)
 
+set(SFS_JSON_BACKEND
+    "nlohmann"
+    CACHE STRING "JSON library used to parse service responses: nlohmann or simdjson.")
+set_property(CACHE SFS_JSON_BACKEND PROPERTY STRINGS nlohmann simdjson)
+
+set(SFS_MIN_LOG_SEVERITY
+    "Verbose"
+    CACHE STRING "Least severe log messages compiled into the library: Verbose, Info, Warning or Error.")
+set_property(CACHE SFS_MIN_LOG_SEVERITY PROPERTY STRINGS Verbose Info Warning Error)
+
 option(
     SFS_WINDOWS_STATIC_ONLY
     "Indicates if only static libraries and dependencies should be built on Windows."